@@ -0,0 +1,56 @@
+#include <GamepadSerialBridge.h>
+#include <math.h>
+
+// Measures JoystickPolar::FromCartesian against floating-point sqrt + atan2 on the board
+// it runs on, reported as microseconds and CPU cycles per call. Accuracy is checked on
+// the host by tests/JoystickPolar.
+
+static constexpr uint16_t sampleCount = 4096;
+
+volatile uint16_t sink;
+volatile double floatSink;
+
+int16_t SampleX(uint16_t i) {
+  // Walk a spiral over the full int16 range so every octant and magnitude gets exercised
+  return static_cast<int16_t>(static_cast<uint16_t>(i * 40503U));
+}
+
+int16_t SampleY(uint16_t i) {
+  return static_cast<int16_t>(static_cast<uint16_t>(i * 21011U + 12345U));
+}
+
+void PrintRate(const __FlashStringHelper* name, unsigned long elapsed) {
+  const unsigned long nanosPerSample = (elapsed * 1000UL) / sampleCount;
+  Serial.print(name);
+  Serial.print(F(": "));
+  Serial.print(nanosPerSample / 1000UL);
+  Serial.print('.');
+  Serial.print((nanosPerSample % 1000UL) / 100UL);
+  Serial.print(F(" us/call, "));
+  Serial.print((nanosPerSample * clockCyclesPerMicrosecond()) / 1000UL);
+  Serial.println(F(" cycles/call"));
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {
+  }
+
+  unsigned long start = micros();
+  for (uint16_t i = 0; i < sampleCount; ++i) {
+    const GSB::PolarValue polar = GSB::JoystickPolar::FromCartesian(SampleX(i), SampleY(i));
+    sink = polar.magnitude ^ polar.angle;
+  }
+  PrintRate(F("JoystickPolar::FromCartesian"), micros() - start);
+
+  start = micros();
+  for (uint16_t i = 0; i < sampleCount; ++i) {
+    const double x = SampleX(i);
+    const double y = SampleY(i);
+    floatSink = sqrt(x * x + y * y) + atan2(y, x);
+  }
+  PrintRate(F("Float sqrt + atan2"), micros() - start);
+}
+
+void loop() {
+}
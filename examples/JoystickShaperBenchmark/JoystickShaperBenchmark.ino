@@ -0,0 +1,66 @@
+#include <GamepadSerialBridge.h>
+
+// Measures the cost of JoystickShaper::Shape per sample on the board it runs on.
+// Each preset is run over a sweep of stick positions and reported as microseconds
+// and CPU cycles per sample.
+
+static constexpr uint16_t sampleCount = 4096;
+static const uint16_t softCurve[GSB::JoystickShape::CurvePoints()] = {
+  0, 45, 100, 160, 224, 290, 358, 428, 498, 569, 640, 711, 782, 853, 924, 975, 1024
+};
+
+volatile int16_t sink;
+
+void RunBenchmark(const __FlashStringHelper* name, const GSB::JoystickShape& shape) {
+  GSB::JoystickShaper shaper;
+  shaper.SetShape(shape);
+  const unsigned long start = micros();
+  for (uint16_t i = 0; i < sampleCount; ++i) {
+    // Walk a spiral so every stage (deadzone, curve, saturation) gets exercised
+    int16_t x = static_cast<int16_t>((i & 0x3FF) - 512);
+    int16_t y = static_cast<int16_t>(((i * 7) & 0x3FF) - 512);
+    shaper.Shape(x, y);
+    sink = x ^ y;
+  }
+  const unsigned long elapsed = micros() - start;
+  const unsigned long nanosPerSample = (elapsed * 1000UL) / sampleCount;
+  Serial.print(name);
+  Serial.print(F(": "));
+  Serial.print(nanosPerSample / 1000UL);
+  Serial.print('.');
+  Serial.print((nanosPerSample % 1000UL) / 100UL);
+  Serial.print(F(" us/sample, "));
+  Serial.print((nanosPerSample * clockCyclesPerMicrosecond()) / 1000UL);
+  Serial.println(F(" cycles/sample"));
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {
+  }
+
+  GSB::JoystickShape identity;
+  RunBenchmark(F("Identity"), identity);
+
+  GSB::JoystickShape radial;
+  radial.radialDeadzone = 48;
+  RunBenchmark(F("Radial deadzone"), radial);
+
+  GSB::JoystickShape full;
+  full.radialDeadzone = 48;
+  full.axialDeadzone = 16;
+  full.antiDeadzone = 24;
+  full.saturation = 480;
+  full.curve = GSB::ResponseCurve::SQUARE;
+  RunBenchmark(F("All stages, square"), full);
+
+  full.curve = GSB::ResponseCurve::CUBE;
+  RunBenchmark(F("All stages, cube"), full);
+
+  full.curve = GSB::ResponseCurve::CUSTOM;
+  full.customCurve = softCurve;
+  RunBenchmark(F("All stages, custom"), full);
+}
+
+void loop() {
+}
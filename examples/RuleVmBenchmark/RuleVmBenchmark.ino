@@ -0,0 +1,136 @@
+#include <GamepadSerialBridge.h>
+#include <EEPROM.h>
+
+// Compiles a rule program, stores it in EEPROM and loads it back from there, then measures
+// RuleVm::Run on the board it runs on. Every jump in a program goes forward, so one run
+// executes at most GetMaxSteps() instructions; the worst-case program below fills the
+// code buffer with the slowest instructions (sensor reads and multiplies) to show the
+// per-frame ceiling for that buffer size.
+
+static constexpr uint16_t runCount = 1000;
+static constexpr int eepromAddress = 0;
+
+static const char rules[] =
+  "# Ramp PWM 5 up while TRIGGER_1 is past 600 and MAIN_1 is held, down otherwise\n"
+  "if TRIGGER_1 > 600 and MAIN_1\n"
+  "  r0 = min(r0 + elapsed, 255)\n"
+  "else\n"
+  "  r0 = max(r0 - elapsed * 2, 0)\n"
+  "end\n"
+  "pwm 5 = r0\n"
+  "pin 13 = MAIN_2 or MAIN_3\n"
+  "servo 9 = 1500 + JOYSTICK_1.x\n";
+
+// Writes nothing; the benchmark measures the interpreter, not the pins
+class NullPinWriter : public GSB::PinWriter {
+  public:
+    void SetupPin(uint8_t, GSB::PinAction) override {}
+    void WriteDigital(uint8_t, bool) override {}
+    void WritePwm(uint8_t, uint8_t) override {}
+    void WriteServo(uint8_t, uint16_t) override {}
+};
+
+static NullPinWriter writer;
+static GSB::BasicRuleVm<128> ruleVm(writer);
+
+// [length][bytecode...]
+void SaveToEeprom(const uint8_t* code, uint8_t length) {
+#if defined(ESP32)
+  EEPROM.begin(1 + 128);
+#endif
+  EEPROM.write(eepromAddress, length);
+  for (uint8_t i = 0; i < length; ++i) {
+    EEPROM.write(eepromAddress + 1 + i, code[i]);
+  }
+#if defined(ESP32)
+  EEPROM.commit();
+#endif
+}
+
+bool LoadFromEeprom(GSB::RuleVm& vm) {
+  uint8_t code[128];
+  const uint8_t length = EEPROM.read(eepromAddress);
+  // Blank EEPROM reads 0xFF
+  if (length > sizeof(code)) {
+    return false;
+  }
+  for (uint8_t i = 0; i < length; ++i) {
+    code[i] = EEPROM.read(eepromAddress + 1 + i);
+  }
+  return vm.Load(code, length);
+}
+
+void Measure(const __FlashStringHelper* name, const GSB::internal::Status& status) {
+  const unsigned long start = micros();
+  for (uint16_t i = 0; i < runCount; ++i) {
+    ruleVm.Run(status, i);
+  }
+  const unsigned long nanosPerRun = ((micros() - start) * 1000UL) / runCount;
+  const unsigned long cyclesPerRun = (nanosPerRun * clockCyclesPerMicrosecond()) / 1000UL;
+  Serial.print(name);
+  Serial.print(F(": "));
+  Serial.print(ruleVm.GetLength());
+  Serial.print(F(" bytes, "));
+  Serial.print(ruleVm.GetMaxSteps());
+  Serial.print(F(" steps max, "));
+  Serial.print(nanosPerRun / 1000UL);
+  Serial.print('.');
+  Serial.print((nanosPerRun % 1000UL) / 100UL);
+  Serial.print(F(" us/run, "));
+  Serial.print(cyclesPerRun);
+  Serial.print(F(" cycles/run, "));
+  Serial.print(cyclesPerRun / ruleVm.GetMaxSteps());
+  Serial.println(F(" cycles/step"));
+}
+
+// Repeats r0 = SENSOR_2.z * SENSOR_2.y until the buffer is full
+uint8_t BuildWorstCase(uint8_t* code, uint8_t capacity) {
+  const uint8_t body[] = {
+    static_cast<uint8_t>(GSB::RuleOp::VALUE), static_cast<uint8_t>(GSB::InputGroup::SENSORS), 1, 2,
+    static_cast<uint8_t>(GSB::RuleOp::VALUE), static_cast<uint8_t>(GSB::InputGroup::SENSORS), 1, 1,
+    static_cast<uint8_t>(GSB::RuleOp::MUL),
+    static_cast<uint8_t>(GSB::RuleOp::STORE), 0,
+  };
+  uint8_t length = 0;
+  while (length + sizeof(body) <= capacity) {
+    for (uint8_t i = 0; i < sizeof(body); ++i) {
+      code[length++] = body[i];
+    }
+  }
+  return length;
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {
+  }
+
+  uint8_t code[128];
+  GSB::RuleCompiler compiler;
+  const uint8_t length = compiler.Compile(rules, code, sizeof(code));
+  if (compiler.GetError() != GSB::RuleCompileError::NONE) {
+    Serial.print(F("Compile error "));
+    Serial.print(static_cast<uint8_t>(compiler.GetError()));
+    Serial.print(F(" on line "));
+    Serial.println(compiler.GetLine());
+    return;
+  }
+  SaveToEeprom(code, length);
+  if (!LoadFromEeprom(ruleVm)) {
+    Serial.println(F("EEPROM program failed validation"));
+    return;
+  }
+
+  GSB::internal::Status status{};
+  status.Update(GSB::TriggerID::TRIGGER_1, 700);
+  status.Update(GSB::ButtonID::MAIN_1, true);
+  status.Update(GSB::JoystickID::JOYSTICK_1, -200, 100);
+  status.Update(GSB::SensorID::SENSOR_2, 120, -340, 16384);
+  Measure(F("Example rules"), status);
+
+  ruleVm.Load(code, BuildWorstCase(code, ruleVm.GetCapacity()));
+  Measure(F("Worst case"), status);
+}
+
+void loop() {
+}
@@ -3,22 +3,34 @@
 #include <Arduino.h>
 #include "internal/LinkBase.h"
 #include "internal/Command.h"
+#include "internal/EventQueue.h"
+#include "internal/ButtonTimers.h"
+#include "internal/RuleUpload.h"
 
 namespace GSB {
-  class ApplicationLink : public internal::LinkBase {
+  // Receiving side: applies status frames to local gamepads and sends commands.
+  // Sized by Traits at compile time; ApplicationLink is the default configuration.
+  template<typename Traits = DefaultLinkTraits>
+  class BasicApplicationLink : public internal::LinkBase<BasicApplicationLink<Traits>, Traits> {
     public:
-      ApplicationLink(const LinkConfig& linkConfig) noexcept;
-      ~ApplicationLink() noexcept = default;
+      BasicApplicationLink(const LinkConfig& linkConfig) noexcept;
+      ~BasicApplicationLink() noexcept = default;
 
       // ──────────────────────────────
       // Callbacks (applied to all gamepads)
       // ──────────────────────────────
       void SetButtonOnPress(void (*fxPtr)(uint8_t gamepadIndex, ButtonID buttonID)) noexcept;
       void SetButtonOnRelease(void (*fxPtr)(uint8_t gamepadIndex, ButtonID buttonID)) noexcept;
+      void SetButtonOnGesture(void (*fxPtr)(uint8_t gamepadIndex, ButtonID buttonID, ButtonGesture gesture)) noexcept;
       void SetTriggerOnChange(void (*fxPtr)(uint8_t gamepadIndex, TriggerID triggerID, int16_t value)) noexcept;
       void SetJoystickOnChange(void (*fxPtr)(uint8_t gamepadIndex, JoystickID joystickID, int16_t valueX, int16_t valueY)) noexcept;
+      void SetJoystickOnPolar(void (*fxPtr)(uint8_t gamepadIndex, JoystickID joystickID, uint16_t magnitude, uint16_t angle)) noexcept;
+      void SetJoystickOnSector(void (*fxPtr)(uint8_t gamepadIndex, JoystickID joystickID, uint8_t sector)) noexcept;
       void SetBatteryOnChange(void (*fxPtr)(uint8_t gamepadIndex, BatteryID batteryID, uint8_t value)) noexcept;
       void SetSensorOnChange(void (*fxPtr)(uint8_t gamepadIndex, SensorID sensorID, int16_t valueX, int16_t valueY, int16_t valueZ)) noexcept;
+      void SetOrientationOnChange(void (*fxPtr)(uint8_t gamepadIndex, int16_t roll, int16_t pitch, int16_t yaw)) noexcept;
+      // Replays batched sensor samples (see BasicGamepadLink::SetSensorBatching) one by one, in order
+      void SetSensorOnBatch(void (*fxPtr)(uint8_t gamepadIndex, const SensorSample& sample, unsigned long sampleMicros)) noexcept;
 
       // ──────────────────────────────
       // TOLERANCES
@@ -67,6 +79,57 @@ namespace GSB {
       void SetSensorToleranceY(uint8_t gamepadIndex, SensorID sensorID, uint16_t tolerance) noexcept;
       void SetSensorToleranceZ(uint8_t gamepadIndex, SensorID sensorID, uint16_t tolerance) noexcept;
 
+      // ──────────────────────────────
+      // SHAPING
+      // ──────────────────────────────
+      void SetJoystickShapeForAllGamepads(JoystickID joystickID, const JoystickShape& shape) noexcept;
+      void SetJoystickShape(uint8_t gamepadIndex, JoystickID joystickID, const JoystickShape& shape) noexcept;
+
+      // ──────────────────────────────
+      // POLAR
+      // ──────────────────────────────
+      // Sector tracking for the sector callback (see BasicGamepad::SetJoystickSectors); count 0 turns it off
+      void SetJoystickSectorsForAllGamepads(JoystickID joystickID, uint8_t count, uint16_t minimumMagnitude) noexcept;
+      void SetJoystickSectors(uint8_t gamepadIndex, JoystickID joystickID, uint8_t count, uint16_t minimumMagnitude) noexcept;
+      // Magnitude and binary angle of the current stick value (zero for an invalid index)
+      PolarValue GetJoystickPolar(uint8_t gamepadIndex, JoystickID joystickID) noexcept;
+
+      // ──────────────────────────────
+      // FILTERS
+      // ──────────────────────────────
+      // Per-axis smoothing ahead of the tolerance check (see Axis::SetFilter)
+      void SetTriggerFilter(uint8_t gamepadIndex, TriggerID triggerID, uint8_t emaShift, bool median) noexcept;
+      void SetJoystickFilter(uint8_t gamepadIndex, JoystickID joystickID, uint8_t emaShift, bool median) noexcept;
+      void SetSensorFilter(uint8_t gamepadIndex, SensorID sensorID, uint8_t emaShift, bool median) noexcept;
+
+      // ──────────────────────────────
+      // CALIBRATION
+      // ──────────────────────────────
+      // Attaches caller-owned storage that normalizes a gamepad's sticks and triggers
+      // (nullptr detaches). Required before starting a calibration or importing one.
+      bool SetCalibration(uint8_t gamepadIndex, Calibration* calibration) noexcept;
+      // One gamepad at a time: leave the controls at rest until the phase reads SWEEP, move
+      // each stick around its full range and press each trigger fully, then call
+      // FinishCalibration. restSamples status updates per axis give the center and noise floor.
+      bool StartCalibration(uint8_t gamepadIndex, uint8_t restSamples = 32) noexcept;
+      CalibrationSession::Phase GetCalibrationPhase() const noexcept;
+      // Applies the learned ranges and sets each axis's tolerance just above its noise
+      bool FinishCalibration() noexcept;
+      void CancelCalibration() noexcept;
+      // Compact blob (Calibration::BlobLength() bytes) for storing a calibration, e.g. in EEPROM
+      size_t ExportCalibration(uint8_t gamepadIndex, uint8_t* data, size_t capacity) const noexcept;
+      bool ImportCalibration(uint8_t gamepadIndex, const uint8_t* data, size_t length) noexcept;
+
+      // ──────────────────────────────
+      // SENDER FILTERS
+      // ──────────────────────────────
+      // Pushes this side's current tolerances to the GamepadLink so changes below them are
+      // never sent; the local tolerance check stays as a safety net. deadzone (joysticks and
+      // triggers) makes the sender report values with a smaller magnitude as 0.
+      // Call again after changing tolerances.
+      bool PushFiltersForAllGamepads(uint16_t deadzone = 0) noexcept;
+      bool PushFilters(uint8_t gamepadIndex, uint16_t deadzone = 0) noexcept;
+
       // ──────────────────────────────
       // COMMANDS
       // ──────────────────────────────
@@ -113,10 +176,113 @@ namespace GSB {
       bool SetColorLed(uint8_t gamepadIndex, ColorLedID colorLedID, bool illuminated, uint8_t red, uint8_t green, uint8_t blue) noexcept;
       bool ToggleColorLed(uint8_t gamepadIndex, ColorLedID colorLedID) noexcept;
 
+      // ──────────────────────────────
+      // BUTTON TIMING
+      // ──────────────────────────────
+      // Hold, long-press, double-tap and auto-repeat for subscribed buttons only, timed on one
+      // wheel shared by all gamepads and advanced from Loop. Traits::buttonTimers caps how
+      // many (gamepad, button) pairs can be subscribed at once.
+      void SetButtonTiming(const ButtonTiming& timing) noexcept;
+      const ButtonTiming& GetButtonTiming() const noexcept;
+      // gestures is a set of ButtonGestureMask bits; 0 unsubscribes. False when the table is full.
+      bool SubscribeButtonGestures(uint8_t gamepadIndex, ButtonID buttonID, uint8_t gestures) noexcept;
+      bool SubscribeButtonGesturesForAllGamepads(ButtonID buttonID, uint8_t gestures) noexcept;
+      uint8_t GetButtonGestures(uint8_t gamepadIndex, ButtonID buttonID) const noexcept;
+
+      // ──────────────────────────────
+      // COMBOS
+      // ──────────────────────────────
+      // Feeds every gamepad's button edges to a caller-owned recognizer (nullptr detaches).
+      // Its combo callback is queued like the button callbacks when the event queue is enabled.
+      void SetComboRecognizer(ComboRecognizer* recognizer) noexcept;
+
+      // ──────────────────────────────
+      // AXIS BUTTONS
+      // ──────────────────────────────
+      // Virtual buttons (ButtonID::VIRTUAL_1..8) from one gamepad's triggers and sticks, using
+      // a caller-owned AxisButtons; their edges arrive through the button press/release callbacks.
+      bool SetAxisButtons(uint8_t gamepadIndex, AxisButtons* axisButtons) noexcept;
+
+      // ──────────────────────────────
+      // ORIENTATION
+      // ──────────────────────────────
+      // Fuses one gamepad's gyro (SENSOR_1) and accelerometer (SENSOR_2) into roll, pitch and yaw
+      // with a caller-owned ImuFusion, once per applied sensor frame; nullptr detaches.
+      bool SetImuFusion(uint8_t gamepadIndex, ImuFusion* fusion) noexcept;
+
+      // ──────────────────────────────
+      // PIN MAPPING
+      // ──────────────────────────────
+      // Drives pins from one gamepad's inputs through a caller-owned PinMap whose table is
+      // already set; pins are set up and written from the current status on attach, then
+      // only entries whose group changed are re-evaluated per frame. nullptr detaches.
+      bool SetPinMap(uint8_t gamepadIndex, PinMap* pinMap) noexcept;
+
+      // ──────────────────────────────
+      // RULES
+      // ──────────────────────────────
+      // Runs a caller-owned RuleVm (e.g. BasicRuleVm<64>) over one gamepad's status after every
+      // applied frame, following the pin map. Programs are loaded locally with RuleVm::Load or
+      // uploaded by the sender with BasicGamepadLink::SendRules; nullptr detaches.
+      bool SetRuleVm(uint8_t gamepadIndex, RuleVm* ruleVm) noexcept;
+
+      // ──────────────────────────────
+      // INTERPOLATION
+      // ──────────────────────────────
+      // Feeds one gamepad's trigger and joystick frames, stamped with micros(), to a caller-owned
+      // AxisInterpolator, which is reset to the current values on attach; nullptr detaches.
+      bool SetAxisInterpolator(uint8_t gamepadIndex, AxisInterpolator* interpolator) noexcept;
+      // Smoothed trigger or joystick value (channel from AxisInterpolator::Channel) at nowMicros;
+      // 0 when the index is invalid or no interpolator is attached
+      int16_t Sample(uint8_t gamepadIndex, uint8_t channel, unsigned long nowMicros) noexcept;
+
+      // ──────────────────────────────
+      // INPUT HISTORY
+      // ──────────────────────────────
+      // Records every applied status frame of one gamepad, stamped with micros(), into a
+      // caller-owned ring (e.g. BasicInputHistory<256>); nullptr detaches.
+      bool SetInputHistory(uint8_t gamepadIndex, InputHistory* history) noexcept;
+      // Prints the records of the last windowMillis (0 = all) to the log port; returns records printed
+      uint16_t DumpInputHistory(uint8_t gamepadIndex, unsigned long windowMillis = 0) noexcept;
+
+      // ──────────────────────────────
+      // EVENT QUEUE
+      // ──────────────────────────────
+      // When enabled, input changes are queued (coalescing value updates per input)
+      // and callbacks only run from DispatchEvents, so serial ingest never runs user code.
+      // Status events are never dropped: while the queue lacks room for a worst-case frame,
+      // incoming frames wait in the RX slots (then the UART) until DispatchEvents frees slots.
+      // Gestures and combos only take slots beyond that reserve and count as overflow when
+      // none are left.
+      void SetEventQueueEnabled(bool enabled) noexcept;
+      bool GetEventQueueEnabled() const noexcept;
+      // Drains up to maxEvents and/or for up to maxMicros (0 = no limit); returns events dispatched
+      uint8_t DispatchEvents(uint8_t maxEvents = 0, unsigned long maxMicros = 0) noexcept;
+      uint8_t GetPendingEventCount() const noexcept;
+      uint16_t GetCoalescedEventCount() const noexcept;
+      uint16_t GetEventOverflowCount() const noexcept;
+
     private:
+      using Base = internal::LinkBase<BasicApplicationLink<Traits>, Traits>;
+      friend Base;
+      using Gamepad = typename Base::Gamepad;
+      using Profile = typename Base::Profile;
+      static_assert(internal::Status::Length(Profile::inputGroups) <= Traits::maxPayload, "Status frame for this profile exceeds maxPayload");
+      using Base::GetGamepadCount;
+      using Base::GetGamepad;
+      using Base::Log;
+      using Base::SendSerial;
+
       // Process status messages
-      void ParseSerial(const uint8_t* data, size_t length) noexcept override;
-      void ApplyStatus(const internal::Status& status);
+      void ParseSerial(const uint8_t* data, size_t length) noexcept;
+      bool CanAcceptFrame() const noexcept;
+      void ApplyStatus(const internal::Status& status, uint8_t groups);
+      void ApplySensorBatch(const uint8_t* data, size_t length);
+      void ApplyRuleChunk(const uint8_t* data, size_t length);
+      // Pin map, rule program and interpolator, after a status frame or batched sample is applied;
+      // previous is the gamepad's status before it (only read with a pin map attached)
+      void RunFrameHooks(Gamepad& gamepad, const internal::Status& previous, uint8_t groups);
+      void QueueSensorBatch(Gamepad& gamepad, uint8_t gamepadIndex, const SensorSample& sample, unsigned long sampleMicros);
       
       // ──────────────────────────────
       // STATUS
@@ -131,5 +297,25 @@ namespace GSB {
 
       // Send command messages
       bool SendCommand(const internal::Command& command) noexcept;
+      bool PushFilter(uint8_t gamepadIndex, InputGroup group, uint8_t input, uint8_t axisCount, uint16_t deadzone) noexcept;
+
+      bool DispatchNextEvent() noexcept;
+      // Delivers due button gestures and ends pin pulses; called from Loop
+      void Service() noexcept;
+
+      internal::ButtonTimersStorage<Traits::buttonTimers> m_buttonTimers;
+      CalibrationSession m_calibrationSession;
+      uint8_t m_calibratingGamepad{0};
+
+      internal::EventQueueStorage<Traits::eventQueueDepth, Traits::maxGamepads> m_eventQueue;
+      bool m_eventQueueEnabled{false};
+      // Batch samples whose callback is queued: a quarter of the event queue depth
+      static constexpr uint8_t s_queuedSampleCapacity = (Traits::sensorBatching && Profile::Has(InputGroup::SENSORS)) ? Traits::eventQueueDepth / 4 : 0;
+      internal::SensorSampleQueue<s_queuedSampleCapacity> m_queuedSamples;
+      uint16_t m_sampleOverflowCount{0};
   };
-} // namespace GSB
\ No newline at end of file
+
+  using ApplicationLink = BasicApplicationLink<>;
+} // namespace GSB
+
+#include "ApplicationLink.tpp"
\ No newline at end of file
@@ -0,0 +1,1391 @@
+// Template definitions for BasicApplicationLink; included at the bottom of ApplicationLink.h
+
+namespace GSB {
+  template<typename Traits>
+  BasicApplicationLink<Traits>::BasicApplicationLink(const LinkConfig& linkConfig) noexcept : Base(linkConfig) {
+
+  }
+
+  // ──────────────────────────────
+  // Callbacks (applied to all gamepads)
+  // ──────────────────────────────
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetButtonOnPress(void (*fxPtr)(uint8_t gamepadIndex, ButtonID buttonID)) noexcept {
+    for(uint8_t i = 0; i < GetGamepadCount(); ++i) {
+      GetGamepad(i).SetButtonOnPress(fxPtr);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetButtonOnRelease(void (*fxPtr)(uint8_t gamepadIndex, ButtonID buttonID)) noexcept {
+    for(uint8_t i = 0; i < GetGamepadCount(); ++i) {
+      GetGamepad(i).SetButtonOnRelease(fxPtr);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetButtonOnGesture(void (*fxPtr)(uint8_t gamepadIndex, ButtonID buttonID, ButtonGesture gesture)) noexcept {
+    for(uint8_t i = 0; i < GetGamepadCount(); ++i) {
+      GetGamepad(i).SetButtonOnGesture(fxPtr);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetTriggerOnChange(void (*fxPtr)(uint8_t gamepadIndex, TriggerID triggerID, int16_t value)) noexcept {
+    for(uint8_t i = 0; i < GetGamepadCount(); ++i) {
+      GetGamepad(i).SetTriggerOnChange(fxPtr);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetJoystickOnChange(void (*fxPtr)(uint8_t gamepadIndex, JoystickID joystickID, int16_t valueX, int16_t valueY)) noexcept {
+    for(uint8_t i = 0; i < GetGamepadCount(); ++i) {
+      GetGamepad(i).SetJoystickOnChange(fxPtr);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetJoystickOnPolar(void (*fxPtr)(uint8_t gamepadIndex, JoystickID joystickID, uint16_t magnitude, uint16_t angle)) noexcept {
+    for(uint8_t i = 0; i < GetGamepadCount(); ++i) {
+      GetGamepad(i).SetJoystickOnPolar(fxPtr);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetJoystickOnSector(void (*fxPtr)(uint8_t gamepadIndex, JoystickID joystickID, uint8_t sector)) noexcept {
+    for(uint8_t i = 0; i < GetGamepadCount(); ++i) {
+      GetGamepad(i).SetJoystickOnSector(fxPtr);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetBatteryOnChange(void (*fxPtr)(uint8_t gamepadIndex, BatteryID batteryID, uint8_t value)) noexcept {
+    for(uint8_t i = 0; i < GetGamepadCount(); ++i) {
+      GetGamepad(i).SetBatteryOnChange(fxPtr);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetSensorOnChange(void (*fxPtr)(uint8_t gamepadIndex, SensorID sensorID, int16_t valueX, int16_t valueY, int16_t valueZ)) noexcept {
+    for(uint8_t i = 0; i < GetGamepadCount(); ++i) {
+      GetGamepad(i).SetSensorOnChange(fxPtr);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetOrientationOnChange(void (*fxPtr)(uint8_t gamepadIndex, int16_t roll, int16_t pitch, int16_t yaw)) noexcept {
+    for(uint8_t i = 0; i < GetGamepadCount(); ++i) {
+      GetGamepad(i).SetOrientationOnChange(fxPtr);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetSensorOnBatch(void (*fxPtr)(uint8_t gamepadIndex, const SensorSample& sample, unsigned long sampleMicros)) noexcept {
+    for(uint8_t i = 0; i < GetGamepadCount(); ++i) {
+      GetGamepad(i).SetSensorOnBatch(fxPtr);
+    }
+  }
+
+  // ──────────────────────────────
+  // TOLERANCES
+  // ──────────────────────────────
+  // All inputs on all gamepads (set defaults across the board)
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetTriggerToleranceForAllGamepads(uint16_t tolerance) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      SetTriggerTolerance(gamepadIndex, tolerance);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetJoystickToleranceForAllGamepads(uint16_t toleranceX, uint16_t toleranceY) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      SetJoystickTolerance(gamepadIndex, toleranceX, toleranceY);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetJoystickToleranceXForAllGamepads(uint16_t tolerance) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      SetJoystickToleranceX(gamepadIndex, tolerance);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetJoystickToleranceYForAllGamepads(uint16_t tolerance) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      SetJoystickToleranceY(gamepadIndex, tolerance);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetBatteryToleranceForAllGamepads(uint8_t tolerance) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      SetBatteryTolerance(gamepadIndex, tolerance);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetSensorToleranceForAllGamepads(uint16_t toleranceX, uint16_t toleranceY, uint16_t toleranceZ) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      SetSensorTolerance(gamepadIndex, toleranceX, toleranceY, toleranceZ);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetSensorToleranceXForAllGamepads(uint16_t tolerance) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      SetSensorToleranceX(gamepadIndex, tolerance);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetSensorToleranceYForAllGamepads(uint16_t tolerance) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      SetSensorToleranceY(gamepadIndex, tolerance);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetSensorToleranceZForAllGamepads(uint16_t tolerance) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      SetSensorToleranceZ(gamepadIndex, tolerance);
+    }
+  }
+
+  // One input on all gamepads
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetTriggerToleranceForAllGamepads(TriggerID triggerID, uint16_t tolerance) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      SetTriggerTolerance(gamepadIndex, triggerID, tolerance);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetJoystickToleranceForAllGamepads(JoystickID joystickID, uint16_t toleranceX, uint16_t toleranceY) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      SetJoystickTolerance(gamepadIndex, joystickID, toleranceX, toleranceY);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetJoystickToleranceXForAllGamepads(JoystickID joystickID, uint16_t tolerance) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      SetJoystickToleranceX(gamepadIndex, joystickID, tolerance);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetJoystickToleranceYForAllGamepads(JoystickID joystickID, uint16_t tolerance) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      SetJoystickToleranceY(gamepadIndex, joystickID, tolerance);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetBatteryToleranceForAllGamepads(BatteryID batteryID, uint8_t tolerance) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      SetBatteryTolerance(gamepadIndex, batteryID, tolerance);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetSensorToleranceForAllGamepads(SensorID sensorID, uint16_t toleranceX, uint16_t toleranceY, uint16_t toleranceZ) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      SetSensorTolerance(gamepadIndex, sensorID, toleranceX, toleranceY, toleranceZ);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetSensorToleranceXForAllGamepads(SensorID sensorID, uint16_t tolerance) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      SetSensorToleranceX(gamepadIndex, sensorID, tolerance);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetSensorToleranceYForAllGamepads(SensorID sensorID, uint16_t tolerance) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      SetSensorToleranceY(gamepadIndex, sensorID, tolerance);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetSensorToleranceZForAllGamepads(SensorID sensorID, uint16_t tolerance) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      SetSensorToleranceZ(gamepadIndex, sensorID, tolerance);
+    }
+  }
+
+  // All inputs on one gamepad
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetTriggerTolerance(uint8_t gamepadIndex, uint16_t tolerance) noexcept {
+    for(uint8_t triggerID = 0; triggerID < TriggerCount(); ++triggerID) {
+      SetTriggerTolerance(gamepadIndex, static_cast<TriggerID>(triggerID), tolerance);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetJoystickTolerance(uint8_t gamepadIndex, uint16_t toleranceX, uint16_t toleranceY) noexcept {
+    for(uint8_t joystickID = 0; joystickID < JoystickCount(); ++joystickID) {
+      SetJoystickTolerance(gamepadIndex, static_cast<JoystickID>(joystickID), toleranceX, toleranceY);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetJoystickToleranceX(uint8_t gamepadIndex, uint16_t tolerance) noexcept {
+    for(uint8_t joystickID = 0; joystickID < JoystickCount(); ++joystickID) {
+      SetJoystickToleranceX(gamepadIndex, static_cast<JoystickID>(joystickID), tolerance);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetJoystickToleranceY(uint8_t gamepadIndex, uint16_t tolerance) noexcept {
+    for(uint8_t joystickID = 0; joystickID < JoystickCount(); ++joystickID) {
+      SetJoystickToleranceY(gamepadIndex, static_cast<JoystickID>(joystickID), tolerance);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetBatteryTolerance(uint8_t gamepadIndex, uint8_t tolerance) noexcept {
+    for(uint8_t batteryID = 0; batteryID < BatteryCount(); ++batteryID) {
+      SetBatteryTolerance(gamepadIndex, static_cast<BatteryID>(batteryID), tolerance);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetSensorTolerance(uint8_t gamepadIndex, uint16_t toleranceX, uint16_t toleranceY, uint16_t toleranceZ) noexcept {
+    for(uint8_t sensorID = 0; sensorID < SensorCount(); ++sensorID) {
+      SetSensorTolerance(gamepadIndex, static_cast<SensorID>(sensorID), toleranceX, toleranceY, toleranceZ);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetSensorToleranceX(uint8_t gamepadIndex, uint16_t tolerance) noexcept {
+    for(uint8_t sensorID = 0; sensorID < SensorCount(); ++sensorID) {
+      SetSensorToleranceX(gamepadIndex, static_cast<SensorID>(sensorID), tolerance);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetSensorToleranceY(uint8_t gamepadIndex, uint16_t tolerance) noexcept {
+    for(uint8_t sensorID = 0; sensorID < SensorCount(); ++sensorID) {
+      SetSensorToleranceY(gamepadIndex, static_cast<SensorID>(sensorID), tolerance);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetSensorToleranceZ(uint8_t gamepadIndex, uint16_t tolerance) noexcept {
+    for(uint8_t sensorID = 0; sensorID < SensorCount(); ++sensorID) {
+      SetSensorToleranceZ(gamepadIndex, static_cast<SensorID>(sensorID), tolerance);
+    }
+  }
+
+  // One input on one gamepad
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetTriggerTolerance(uint8_t gamepadIndex, TriggerID triggerID, uint16_t tolerance) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return;
+    }
+    GetGamepad(gamepadIndex).SetTriggerTolerance(triggerID, tolerance);
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetJoystickTolerance(uint8_t gamepadIndex, JoystickID joystickID, uint16_t toleranceX, uint16_t toleranceY) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return;
+    }
+    GetGamepad(gamepadIndex).SetJoystickTolerance(joystickID, toleranceX, toleranceY);
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetJoystickToleranceX(uint8_t gamepadIndex, JoystickID joystickID, uint16_t tolerance) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return;
+    }
+    GetGamepad(gamepadIndex).SetJoystickToleranceX(joystickID, tolerance);
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetJoystickToleranceY(uint8_t gamepadIndex, JoystickID joystickID, uint16_t tolerance) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return;
+    }
+    GetGamepad(gamepadIndex).SetJoystickToleranceY(joystickID, tolerance);
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetBatteryTolerance(uint8_t gamepadIndex, BatteryID batteryID, uint8_t tolerance) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return;
+    }
+    GetGamepad(gamepadIndex).SetBatteryTolerance(batteryID, tolerance);
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetSensorTolerance(uint8_t gamepadIndex, SensorID sensorID, uint16_t toleranceX, uint16_t toleranceY, uint16_t toleranceZ) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return;
+    }
+    GetGamepad(gamepadIndex).SetSensorTolerance(sensorID, toleranceX, toleranceY, toleranceZ);
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetSensorToleranceX(uint8_t gamepadIndex, SensorID sensorID, uint16_t tolerance) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return;
+    }
+    GetGamepad(gamepadIndex).SetSensorToleranceX(sensorID, tolerance);
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetSensorToleranceY(uint8_t gamepadIndex, SensorID sensorID, uint16_t tolerance) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return;
+    }
+    GetGamepad(gamepadIndex).SetSensorToleranceY(sensorID, tolerance);
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetSensorToleranceZ(uint8_t gamepadIndex, SensorID sensorID, uint16_t tolerance) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return;
+    }
+    GetGamepad(gamepadIndex).SetSensorToleranceZ(sensorID, tolerance);
+  }
+
+  // ──────────────────────────────
+  // SHAPING
+  // ──────────────────────────────
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetJoystickShapeForAllGamepads(JoystickID joystickID, const JoystickShape& shape) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      SetJoystickShape(gamepadIndex, joystickID, shape);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetJoystickShape(uint8_t gamepadIndex, JoystickID joystickID, const JoystickShape& shape) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return;
+    }
+    GetGamepad(gamepadIndex).SetJoystickShape(joystickID, shape);
+  }
+
+  // ──────────────────────────────
+  // POLAR
+  // ──────────────────────────────
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetJoystickSectorsForAllGamepads(JoystickID joystickID, uint8_t count, uint16_t minimumMagnitude) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      SetJoystickSectors(gamepadIndex, joystickID, count, minimumMagnitude);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetJoystickSectors(uint8_t gamepadIndex, JoystickID joystickID, uint8_t count, uint16_t minimumMagnitude) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return;
+    }
+    GetGamepad(gamepadIndex).SetJoystickSectors(joystickID, count, minimumMagnitude);
+  }
+
+  template<typename Traits>
+  PolarValue BasicApplicationLink<Traits>::GetJoystickPolar(uint8_t gamepadIndex, JoystickID joystickID) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return PolarValue{};
+    }
+    return GetGamepad(gamepadIndex).GetJoystickPolar(joystickID);
+  }
+
+  // ──────────────────────────────
+  // FILTERS
+  // ──────────────────────────────
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetTriggerFilter(uint8_t gamepadIndex, TriggerID triggerID, uint8_t emaShift, bool median) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return;
+    }
+    GetGamepad(gamepadIndex).SetTriggerFilter(triggerID, emaShift, median);
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetJoystickFilter(uint8_t gamepadIndex, JoystickID joystickID, uint8_t emaShift, bool median) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return;
+    }
+    GetGamepad(gamepadIndex).SetJoystickFilter(joystickID, emaShift, median);
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetSensorFilter(uint8_t gamepadIndex, SensorID sensorID, uint8_t emaShift, bool median) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return;
+    }
+    GetGamepad(gamepadIndex).SetSensorFilter(sensorID, emaShift, median);
+  }
+
+  // ──────────────────────────────
+  // CALIBRATION
+  // ──────────────────────────────
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::SetCalibration(uint8_t gamepadIndex, Calibration* calibration) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return false;
+    }
+    if (!calibration && m_calibrationSession.GetPhase() != CalibrationSession::Phase::IDLE && m_calibratingGamepad == gamepadIndex) {
+      CancelCalibration();
+    }
+    GetGamepad(gamepadIndex).SetCalibration(calibration);
+    return true;
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::StartCalibration(uint8_t gamepadIndex, uint8_t restSamples) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return false;
+    }
+    if (!GetGamepad(gamepadIndex).GetCalibration()) {
+      Log(F("No calibration storage attached to gamepad"));
+      return false;
+    }
+    CancelCalibration();
+    m_calibratingGamepad = gamepadIndex;
+    m_calibrationSession.Start(restSamples);
+    GetGamepad(gamepadIndex).SetCalibrationSession(&m_calibrationSession);
+    return true;
+  }
+
+  template<typename Traits>
+  CalibrationSession::Phase BasicApplicationLink<Traits>::GetCalibrationPhase() const noexcept {
+    return m_calibrationSession.GetPhase();
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::FinishCalibration() noexcept {
+    if (m_calibrationSession.GetPhase() == CalibrationSession::Phase::IDLE) {
+      return false;
+    }
+    Gamepad& gamepad = GetGamepad(m_calibratingGamepad);
+    Calibration* calibration = gamepad.GetCalibration();
+    if (!calibration || !m_calibrationSession.Finish(*calibration)) {
+      Log(F("Calibration incomplete: controls not moved through their range"));
+      return false;
+    }
+    gamepad.SetCalibrationSession(nullptr);
+    gamepad.ApplyCalibrationTolerances();
+    return true;
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::CancelCalibration() noexcept {
+    if (m_calibrationSession.GetPhase() == CalibrationSession::Phase::IDLE) {
+      return;
+    }
+    m_calibrationSession.Cancel();
+    GetGamepad(m_calibratingGamepad).SetCalibrationSession(nullptr);
+  }
+
+  template<typename Traits>
+  size_t BasicApplicationLink<Traits>::ExportCalibration(uint8_t gamepadIndex, uint8_t* data, size_t capacity) const noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return 0;
+    }
+    const Calibration* calibration = GetGamepad(gamepadIndex).GetCalibration();
+    return calibration ? calibration->Export(data, capacity) : 0;
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::ImportCalibration(uint8_t gamepadIndex, const uint8_t* data, size_t length) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return false;
+    }
+    Gamepad& gamepad = GetGamepad(gamepadIndex);
+    Calibration* calibration = gamepad.GetCalibration();
+    if (!calibration) {
+      Log(F("No calibration storage attached to gamepad"));
+      return false;
+    }
+    if (!calibration->Import(data, length)) {
+      Log(F("Calibration blob rejected"));
+      return false;
+    }
+    gamepad.ApplyCalibrationTolerances();
+    return true;
+  }
+
+  // ──────────────────────────────
+  // SENDER FILTERS
+  // ──────────────────────────────
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::PushFiltersForAllGamepads(uint16_t deadzone) noexcept {
+    bool sent = true;
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      sent = PushFilters(gamepadIndex, deadzone) && sent;
+    }
+    return sent;
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::PushFilters(uint8_t gamepadIndex, uint16_t deadzone) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return false;
+    }
+    bool sent = true;
+    for (uint8_t joystickID = 0; joystickID < JoystickCount(); ++joystickID) {
+      sent = PushFilter(gamepadIndex, InputGroup::JOYSTICKS, joystickID, 2, deadzone) && sent;
+    }
+    for (uint8_t triggerID = 0; triggerID < TriggerCount(); ++triggerID) {
+      sent = PushFilter(gamepadIndex, InputGroup::TRIGGERS, triggerID, 1, deadzone) && sent;
+    }
+    for (uint8_t batteryID = 0; batteryID < BatteryCount(); ++batteryID) {
+      sent = PushFilter(gamepadIndex, InputGroup::BATTERY, batteryID, 1, 0) && sent;
+    }
+    for (uint8_t sensorID = 0; sensorID < SensorCount(); ++sensorID) {
+      sent = PushFilter(gamepadIndex, InputGroup::SENSORS, sensorID, 3, 0) && sent;
+    }
+    return sent;
+  }
+
+  // Inputs outside the profile report tolerance 0 and are skipped
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::PushFilter(uint8_t gamepadIndex, InputGroup group, uint8_t input, uint8_t axisCount, uint16_t deadzone) noexcept {
+    const Gamepad& gamepad = GetGamepad(gamepadIndex);
+    if (gamepad.GetTolerance(group, input, 0) == 0) {
+      return true;
+    }
+    internal::Command::Parameters::InputFilter parameters{};
+    parameters.group = static_cast<uint8_t>(group);
+    parameters.input = input;
+    for (uint8_t axis = 0; axis < axisCount; ++axis) {
+      parameters.SetTolerance(axis, gamepad.GetTolerance(group, input, axis));
+    }
+    parameters.SetDeadzone(deadzone);
+    internal::Command::Target target = internal::Command::Target::Gamepad(gamepadIndex);
+    internal::Command command = internal::Command::Build::InputFilter(target, parameters);
+    return SendCommand(command);
+  }
+
+  // ──────────────────────────────
+  // COMMANDS
+  // ──────────────────────────────
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::DisconnectAllGamepads() noexcept {
+    internal::Command::Target target = internal::Command::Target::All();
+    internal::Command command = internal::Command::Build::Disconnect(target);
+    return SendCommand(command);
+  }
+
+  // All outputs on all gamepads
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::StartRumbleForAllGamepads(uint8_t force, uint8_t duration) noexcept {
+    internal::Command::Target target = internal::Command::Target::All();
+    internal::Command::Output output = internal::Command::Output::All();
+    internal::Command::Parameters::Rumble parameters;
+    parameters.force = force;
+    parameters.duration = duration;
+    internal::Command command = internal::Command::Build::RumbleStart(target, output, parameters);
+    return SendCommand(command);
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::StopRumbleForAllGamepads() noexcept {
+    internal::Command::Target target = internal::Command::Target::All();
+    internal::Command::Output output = internal::Command::Output::All();
+    internal::Command command = internal::Command::Build::RumbleStop(target, output);
+    return SendCommand(command);
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::SetPlayerLedsForAllGamepads(bool illuminated) noexcept {
+    internal::Command::Target target = internal::Command::Target::All();
+    internal::Command::Output output = internal::Command::Output::All();
+    internal::Command::Parameters::LedSet parameters;
+    parameters.illuminated = illuminated;
+    internal::Command command = internal::Command::Build::PlayerLedSet(target, output, parameters);
+    return SendCommand(command);
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::SetPlayerLedsForAllGamepads(uint8_t mask) noexcept {
+    internal::Command::Target target = internal::Command::Target::All();
+    internal::Command::Output output = internal::Command::Output::All();
+    internal::Command::Parameters::LedsMask parameters;
+    parameters.mask = mask;
+    internal::Command command = internal::Command::Build::PlayerLedsSetMask(target, output, parameters);
+    return SendCommand(command);
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::TogglePlayerLedsForAllGamepads() noexcept {
+    internal::Command::Target target = internal::Command::Target::All();
+    internal::Command::Output output = internal::Command::Output::All();
+    internal::Command command = internal::Command::Build::PlayerLedToggle(target, output);
+    return SendCommand(command);
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::TogglePlayerLedsForAllGamepads(uint8_t mask) noexcept {
+    internal::Command::Target target = internal::Command::Target::All();
+    internal::Command::Output output = internal::Command::Output::All();
+    internal::Command::Parameters::LedsMask parameters;
+    parameters.mask = mask;
+    internal::Command command = internal::Command::Build::PlayerLedsToggleMask(target, output, parameters);
+    return SendCommand(command);
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::SetColorLedsForAllGamepads(bool illuminated) noexcept {
+    internal::Command::Target target = internal::Command::Target::All();
+    internal::Command::Output output = internal::Command::Output::All();
+    internal::Command::Parameters::LedSet parameters;
+    parameters.illuminated = illuminated;
+    internal::Command command = internal::Command::Build::ColorLedSet(target, output, parameters);
+    return SendCommand(command);
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::SetColorLedsForAllGamepads(bool illuminated, uint8_t red, uint8_t green, uint8_t blue) noexcept {
+    internal::Command::Target target = internal::Command::Target::All();
+    internal::Command::Output output = internal::Command::Output::All();
+    internal::Command::Parameters::LedSetColor parameters;
+    parameters.illuminated = illuminated;
+    parameters.red = red;
+    parameters.green = green;
+    parameters.blue = blue;
+    internal::Command command = internal::Command::Build::ColorLedSetColor(target, output, parameters);
+    return SendCommand(command);
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::ToggleColorLedsForAllGamepads() noexcept {
+    internal::Command::Target target = internal::Command::Target::All();
+    internal::Command::Output output = internal::Command::Output::All();
+    internal::Command command = internal::Command::Build::ColorLedToggle(target, output);
+    return SendCommand(command);
+  }
+
+  // One output on all gamepad  
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::StartRumbleForAllGamepads(RumbleID rumbleID, uint8_t force, uint8_t duration) noexcept {
+    internal::Command::Target target = internal::Command::Target::All();
+    internal::Command::Output output = internal::Command::Output::ID(rumbleID);
+    internal::Command::Parameters::Rumble parameters;
+    parameters.force = force;
+    parameters.duration = duration;
+    internal::Command command = internal::Command::Build::RumbleStart(target, output, parameters);
+    return SendCommand(command);
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::StopRumbleForAllGamepads(RumbleID rumbleID) noexcept {
+    internal::Command::Target target = internal::Command::Target::All();
+    internal::Command::Output output = internal::Command::Output::ID(rumbleID);
+    internal::Command command = internal::Command::Build::RumbleStop(target, output);
+    return SendCommand(command);
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::SetPlayerLedForAllGamepads(PlayerLedID playerLedID, bool illuminated) noexcept {
+    internal::Command::Target target = internal::Command::Target::All();
+    internal::Command::Output output = internal::Command::Output::ID(playerLedID);
+    internal::Command::Parameters::LedSet parameters;
+    parameters.illuminated = illuminated;
+    internal::Command command = internal::Command::Build::PlayerLedSet(target, output, parameters);
+    return SendCommand(command);
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::TogglePlayerLedForAllGamepads(PlayerLedID playerLedID) noexcept {
+    internal::Command::Target target = internal::Command::Target::All();
+    internal::Command::Output output = internal::Command::Output::ID(playerLedID);
+    internal::Command command = internal::Command::Build::PlayerLedToggle(target, output);
+    return SendCommand(command);
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::SetColorLedForAllGamepads(ColorLedID colorLedID, bool illuminated) noexcept {
+    internal::Command::Target target = internal::Command::Target::All();
+    internal::Command::Output output = internal::Command::Output::ID(colorLedID);
+    internal::Command::Parameters::LedSet parameters;
+    parameters.illuminated = illuminated;
+    internal::Command command = internal::Command::Build::ColorLedSet(target, output, parameters);
+    return SendCommand(command);
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::SetColorLedForAllGamepads(ColorLedID colorLedID, bool illuminated, uint8_t red, uint8_t green, uint8_t blue) noexcept {
+    internal::Command::Target target = internal::Command::Target::All();
+    internal::Command::Output output = internal::Command::Output::ID(colorLedID);
+    internal::Command::Parameters::LedSetColor parameters;
+    parameters.illuminated = illuminated;
+    parameters.red = red;
+    parameters.green = green;
+    parameters.blue = blue;
+    internal::Command command = internal::Command::Build::ColorLedSetColor(target, output, parameters);
+    return SendCommand(command);
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::ToggleColorLedForAllGamepads(ColorLedID colorLedID) noexcept {
+    internal::Command::Target target = internal::Command::Target::All();
+    internal::Command::Output output = internal::Command::Output::ID(colorLedID);
+    internal::Command command = internal::Command::Build::ColorLedToggle(target, output);
+    return SendCommand(command);
+  }
+
+  // All outputs on one gamepad  
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::Disconnect(uint8_t gamepadIndex) noexcept {
+    internal::Command::Target target = internal::Command::Target::Gamepad(gamepadIndex);
+    internal::Command command = internal::Command::Build::Disconnect(target);
+    return SendCommand(command);
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::StartRumble(uint8_t gamepadIndex, uint8_t force, uint8_t duration) noexcept {
+    internal::Command::Target target = internal::Command::Target::Gamepad(gamepadIndex);
+    internal::Command::Output output = internal::Command::Output::All();
+    internal::Command::Parameters::Rumble parameters;
+    parameters.force = force;
+    parameters.duration = duration;
+    internal::Command command = internal::Command::Build::RumbleStart(target, output, parameters);
+    return SendCommand(command);
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::StopRumble(uint8_t gamepadIndex) noexcept {
+    internal::Command::Target target = internal::Command::Target::Gamepad(gamepadIndex);
+    internal::Command::Output output = internal::Command::Output::All();
+    internal::Command command = internal::Command::Build::RumbleStop(target, output);
+    return SendCommand(command);
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::SetPlayerLeds(uint8_t gamepadIndex, bool illuminated) noexcept {
+    internal::Command::Target target = internal::Command::Target::Gamepad(gamepadIndex);
+    internal::Command::Output output = internal::Command::Output::All();
+    internal::Command::Parameters::LedSet parameters;
+    parameters.illuminated = illuminated;
+    internal::Command command = internal::Command::Build::PlayerLedSet(target, output, parameters);
+    return SendCommand(command);
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::SetPlayerLeds(uint8_t gamepadIndex, uint8_t mask) noexcept {
+    internal::Command::Target target = internal::Command::Target::Gamepad(gamepadIndex);
+    internal::Command::Output output = internal::Command::Output::All();
+    internal::Command::Parameters::LedsMask parameters;
+    parameters.mask = mask;
+    internal::Command command = internal::Command::Build::PlayerLedsSetMask(target, output, parameters);
+    return SendCommand(command);
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::TogglePlayerLeds(uint8_t gamepadIndex) noexcept {
+    internal::Command::Target target = internal::Command::Target::Gamepad(gamepadIndex);
+    internal::Command::Output output = internal::Command::Output::All();
+    internal::Command command = internal::Command::Build::PlayerLedToggle(target, output);
+    return SendCommand(command);
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::TogglePlayerLeds(uint8_t gamepadIndex, uint8_t mask) noexcept {
+    internal::Command::Target target = internal::Command::Target::Gamepad(gamepadIndex);
+    internal::Command::Output output = internal::Command::Output::All();
+    internal::Command::Parameters::LedsMask parameters;
+    parameters.mask = mask;
+    internal::Command command = internal::Command::Build::PlayerLedsToggleMask(target, output, parameters);
+    return SendCommand(command);
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::SetColorLeds(uint8_t gamepadIndex, bool illuminated) noexcept {
+    internal::Command::Target target = internal::Command::Target::Gamepad(gamepadIndex);
+    internal::Command::Output output = internal::Command::Output::All();
+    internal::Command::Parameters::LedSet parameters;
+    parameters.illuminated = illuminated;
+    internal::Command command = internal::Command::Build::ColorLedSet(target, output, parameters);
+    return SendCommand(command);
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::SetColorLeds(uint8_t gamepadIndex, bool illuminated, uint8_t red, uint8_t green, uint8_t blue) noexcept {
+    internal::Command::Target target = internal::Command::Target::Gamepad(gamepadIndex);
+    internal::Command::Output output = internal::Command::Output::All();
+    internal::Command::Parameters::LedSetColor parameters;
+    parameters.illuminated = illuminated;
+    parameters.red = red;
+    parameters.green = green;
+    parameters.blue = blue;
+    internal::Command command = internal::Command::Build::ColorLedSetColor(target, output, parameters);
+    return SendCommand(command);
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::ToggleColorLeds(uint8_t gamepadIndex) noexcept {
+    internal::Command::Target target = internal::Command::Target::Gamepad(gamepadIndex);
+    internal::Command::Output output = internal::Command::Output::All();
+    internal::Command command = internal::Command::Build::ColorLedToggle(target, output);
+    return SendCommand(command);
+  }
+
+  // One output on one gamepad
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::StartRumble(uint8_t gamepadIndex, RumbleID rumbleID, uint8_t force, uint8_t duration) noexcept {
+    internal::Command::Target target = internal::Command::Target::Gamepad(gamepadIndex);
+    internal::Command::Output output = internal::Command::Output::ID(rumbleID);
+    internal::Command::Parameters::Rumble parameters;
+    parameters.force = force;
+    parameters.duration = duration;
+    internal::Command command = internal::Command::Build::RumbleStart(target, output, parameters);
+    return SendCommand(command);
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::StopRumble(uint8_t gamepadIndex, RumbleID rumbleID) noexcept {
+    internal::Command::Target target = internal::Command::Target::Gamepad(gamepadIndex);
+    internal::Command::Output output = internal::Command::Output::ID(rumbleID);
+    internal::Command command = internal::Command::Build::RumbleStop(target, output);
+    return SendCommand(command);
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::SetPlayerLed(uint8_t gamepadIndex, PlayerLedID playerLedID, bool illuminated) noexcept {
+    internal::Command::Target target = internal::Command::Target::Gamepad(gamepadIndex);
+    internal::Command::Output output = internal::Command::Output::ID(playerLedID);
+    internal::Command::Parameters::LedSet parameters;
+    parameters.illuminated = illuminated;
+    internal::Command command = internal::Command::Build::PlayerLedSet(target, output, parameters);
+    return SendCommand(command);
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::TogglePlayerLed(uint8_t gamepadIndex, PlayerLedID playerLedID) noexcept {
+    internal::Command::Target target = internal::Command::Target::Gamepad(gamepadIndex);
+    internal::Command::Output output = internal::Command::Output::ID(playerLedID);
+    internal::Command command = internal::Command::Build::PlayerLedToggle(target, output);
+    return SendCommand(command);
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::SetColorLed(uint8_t gamepadIndex, ColorLedID colorLedID, bool illuminated) noexcept {
+    internal::Command::Target target = internal::Command::Target::Gamepad(gamepadIndex);
+    internal::Command::Output output = internal::Command::Output::ID(colorLedID);
+    internal::Command::Parameters::LedSet parameters;
+    parameters.illuminated = illuminated;
+    internal::Command command = internal::Command::Build::ColorLedSet(target, output, parameters);
+    return SendCommand(command);
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::SetColorLed(uint8_t gamepadIndex, ColorLedID colorLedID, bool illuminated, uint8_t red, uint8_t green, uint8_t blue) noexcept {
+    internal::Command::Target target = internal::Command::Target::Gamepad(gamepadIndex);
+    internal::Command::Output output = internal::Command::Output::ID(colorLedID);
+    internal::Command::Parameters::LedSetColor parameters;
+    parameters.illuminated = illuminated;
+    parameters.red = red;
+    parameters.green = green;
+    parameters.blue = blue;
+    internal::Command command = internal::Command::Build::ColorLedSetColor(target, output, parameters);
+    return SendCommand(command);
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::ToggleColorLed(uint8_t gamepadIndex, ColorLedID colorLedID) noexcept {
+    internal::Command::Target target = internal::Command::Target::Gamepad(gamepadIndex);
+    internal::Command::Output output = internal::Command::Output::ID(colorLedID);
+    internal::Command command = internal::Command::Build::ColorLedToggle(target, output);
+    return SendCommand(command);
+  }
+
+  // ------------------- serial ingest -------------------
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::ParseSerial(const uint8_t* data, size_t length) noexcept {
+    if (data == nullptr) {
+      Log(F("Invalid Binary Payload"));
+      return;
+    }
+    if (internal::SensorBatch::IsBatch(data, length)) {
+      ApplySensorBatch(data, length);
+      return;
+    }
+    if (internal::RuleUpload::IsChunk(data, length)) {
+      ApplyRuleChunk(data, length);
+      return;
+    }
+    internal::Status status{};
+    uint8_t groups = 0;
+    if(!internal::Status::Deserialize(data, length, status, groups)) {
+      Log(F("Invalid Binary Payload Length"));
+      return;
+    }
+    if (status.gamepadIndex >= GetGamepadCount()) {
+      Log(F("Invalid Binary Payload - Invalid Gamepad Index"));
+      return;
+    }
+    ApplyStatus(status, groups);
+  }
+
+  // Backpressure: apply a frame only once the queue can take every event it may raise
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::CanAcceptFrame() const noexcept {
+    return !m_eventQueueEnabled || m_eventQueue.GetFree() >= internal::EventQueue::MaxEventsPerStatus();
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::ApplyStatus(const internal::Status& status, uint8_t groups) {
+    if (status.gamepadIndex >= GetGamepadCount()) {
+      return;
+    }
+    // Merge only groups the sender included and this side's profile keeps
+    groups &= Profile::inputGroups;
+    Gamepad& gamepad = GetGamepad(status.gamepadIndex);
+    if (InputHistory* history = gamepad.GetInputHistory()) {
+      history->Record(status, groups, micros());
+    }
+    // Pins follow the merged values, so compare against them rather than the raw frame
+    internal::Status previous;
+    if (gamepad.GetPinMap()) {
+      previous = gamepad.GetStatus();
+    }
+    if (groups & InputGroupMask(InputGroup::BUTTONS)) {
+      HandleDPad(gamepad, status.dpadMask);
+      HandleMainButtons(gamepad, status.mainButtonsMask);
+      HandleMiscButtons(gamepad, status.miscButtonsMask);
+    }
+    if (groups & InputGroupMask(InputGroup::JOYSTICKS)) {
+      HandleJoystick(gamepad, JoystickID::JOYSTICK_1, status.joystick1X, status.joystick1Y);
+      HandleJoystick(gamepad, JoystickID::JOYSTICK_2, status.joystick2X, status.joystick2Y);
+    }
+    if (groups & InputGroupMask(InputGroup::TRIGGERS)) {
+      HandleTrigger(gamepad, TriggerID::TRIGGER_1, status.trigger1);
+      HandleTrigger(gamepad, TriggerID::TRIGGER_2, status.trigger2);
+    }
+    if (groups & InputGroupMask(InputGroup::BATTERY)) {
+      HandleBattery(gamepad, BatteryID::BATTERY_1, status.battery1);
+    }
+    if (groups & InputGroupMask(InputGroup::SENSORS)) {
+      HandleSensor(gamepad, SensorID::SENSOR_1, status.sensor1X, status.sensor1Y, status.sensor1Z);
+      HandleSensor(gamepad, SensorID::SENSOR_2, status.sensor2X, status.sensor2Y, status.sensor2Z);
+      gamepad.UpdateOrientation(micros());
+    }
+    RunFrameHooks(gamepad, previous, groups);
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::RunFrameHooks(Gamepad& gamepad, const internal::Status& previous, uint8_t groups) {
+    if (PinMap* pinMap = gamepad.GetPinMap()) {
+      pinMap->Update(gamepad.GetStatus(), internal::Status::ChangedGroups(previous, gamepad.GetStatus()) & groups, millis());
+    }
+    if (RuleVm* ruleVm = gamepad.GetRuleVm()) {
+      ruleVm->Run(gamepad.GetStatus(), millis());
+    }
+    if (AxisInterpolator* interpolator = gamepad.GetAxisInterpolator()) {
+      interpolator->OnFrame(gamepad.GetStatus(), groups, micros());
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::ApplySensorBatch(const uint8_t* data, size_t length) {
+    internal::SensorBatchReader reader(data, length);
+    if (!reader.Validate()) {
+      Log(F("Invalid Sensor Batch"));
+      return;
+    }
+    if (reader.GetGamepadIndex() >= GetGamepadCount()) {
+      Log(F("Invalid Sensor Batch - Invalid Gamepad Index"));
+      return;
+    }
+    if (!Profile::Has(InputGroup::SENSORS)) {
+      return;
+    }
+    // Place the samples on this side's clock; UART transit time is not counted
+    const unsigned long firstMicros = micros() - reader.GetAgeMicros() - reader.GetSpanMicros();
+    const uint8_t groups = InputGroupMask(InputGroup::SENSORS);
+    Gamepad& gamepad = GetGamepad(reader.GetGamepadIndex());
+    InputHistory* history = gamepad.GetInputHistory();
+    const bool pinMapped = gamepad.GetPinMap() != nullptr;
+    internal::Status previous;
+    SensorSample sample;
+    unsigned long offsetMicros = 0;
+    // Each sample is a frame of its own: recorded, hooked and notified like a status frame
+    while (reader.Next(sample, offsetMicros)) {
+      const unsigned long sampleMicros = firstMicros + offsetMicros;
+      if (pinMapped) {
+        previous = gamepad.GetStatus();
+      }
+      gamepad.ApplySensorSample(sample, sampleMicros);
+      if (history) {
+        history->Record(gamepad.GetStatus(), groups, sampleMicros);
+      }
+      if (gamepad.HasSensorOnBatch()) {
+        QueueSensorBatch(gamepad, reader.GetGamepadIndex(), sample, sampleMicros);
+      }
+      RunFrameHooks(gamepad, previous, groups);
+    }
+  }
+
+  // Queues the batch callback for one sample, or runs it inline without an event queue
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::QueueSensorBatch(Gamepad& gamepad, uint8_t gamepadIndex, const SensorSample& sample, unsigned long sampleMicros) {
+    if (!m_eventQueueEnabled) {
+      gamepad.NotifySensorBatch(sample, sampleMicros);
+      return;
+    }
+    // The event and its sample are queued together or not at all, so they drain in step
+    if (m_queuedSamples.IsFull()) {
+      ++m_sampleOverflowCount;
+      return;
+    }
+    internal::Event event;
+    event.type = internal::EventType::SENSOR_BATCH;
+    event.gamepadIndex = gamepadIndex;
+    event.id = 0;
+    event.values[0] = 0;
+    event.values[1] = 0;
+    event.values[2] = 0;
+    if (m_eventQueue.Push(event)) {
+      m_queuedSamples.Push(gamepadIndex, sample, sampleMicros);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::ApplyRuleChunk(const uint8_t* data, size_t length) {
+    const uint8_t gamepadIndex = data[1];
+    if (gamepadIndex >= GetGamepadCount()) {
+      Log(F("Invalid Rule Upload - Invalid Gamepad Index"));
+      return;
+    }
+    RuleVm* ruleVm = GetGamepad(gamepadIndex).GetRuleVm();
+    if (!ruleVm) {
+      Log(F("No rule VM attached to gamepad"));
+      return;
+    }
+    const size_t bodyLength = length - internal::RuleUpload::HeaderLength();
+    if (bodyLength > UINT8_MAX || !ruleVm->LoadChunk(data[2], data[3], &data[internal::RuleUpload::HeaderLength()], static_cast<uint8_t>(bodyLength))) {
+      Log(F("Invalid Rule Upload"));
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::HandleDPad(Gamepad& gamepad, uint8_t bitfield) {
+    for (uint8_t i = 0; i < DPadButtons::Count(); ++i) {
+      gamepad.SetButton(DPadButtons::buttonIDs[i], (bitfield >> i) & 1u);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::HandleMainButtons(Gamepad& gamepad, uint16_t bitfield) {
+    for (uint8_t i = 0; i < MainButtons::Count(); ++i) {
+      gamepad.SetButton(MainButtons::buttonIDs[i], (bitfield >> i) & 1u);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::HandleJoystick(Gamepad& gamepad, JoystickID joystickID, int16_t valueX, int16_t valueY) {
+    gamepad.SetJoystick(joystickID, valueX, valueY);
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::HandleTrigger(Gamepad& gamepad, TriggerID triggerID, int16_t value) {
+    gamepad.SetTrigger(triggerID, value);
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::HandleMiscButtons(Gamepad& gamepad, uint8_t bitfield) {
+    for (uint8_t i = 0; i < MiscButtons::Count(); ++i) {
+      gamepad.SetButton(MiscButtons::buttonIDs[i], (bitfield >> i) & 1u);
+    }
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::HandleBattery(Gamepad& gamepad, BatteryID batteryID, uint8_t value) {
+    gamepad.SetBattery(batteryID, value);
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::HandleSensor(Gamepad& gamepad, SensorID sensorID, int16_t valueX, int16_t valueY, int16_t valueZ) {
+    gamepad.SetSensor(sensorID, valueX, valueY, valueZ);
+  }
+
+  // ──────────────────────────────
+  // BUTTON TIMING
+  // ──────────────────────────────
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetButtonTiming(const ButtonTiming& timing) noexcept {
+    m_buttonTimers.SetTiming(timing);
+  }
+
+  template<typename Traits>
+  const ButtonTiming& BasicApplicationLink<Traits>::GetButtonTiming() const noexcept {
+    return m_buttonTimers.GetTiming();
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::SubscribeButtonGestures(uint8_t gamepadIndex, ButtonID buttonID, uint8_t gestures) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return false;
+    }
+    if (m_buttonTimers.GetCapacity() == 0) {
+      Log(F("Button timing not available in this link configuration"));
+      return false;
+    }
+    if (!m_buttonTimers.Subscribe(gamepadIndex, buttonID, gestures)) {
+      Log(F("Button timer table full"));
+      return false;
+    }
+    // Gamepads only see the timers once they have something subscribed
+    if (gestures != 0) {
+      GetGamepad(gamepadIndex).SetButtonTimers(&m_buttonTimers);
+    }
+    return true;
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::SubscribeButtonGesturesForAllGamepads(ButtonID buttonID, uint8_t gestures) noexcept {
+    bool subscribed = true;
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      subscribed = SubscribeButtonGestures(gamepadIndex, buttonID, gestures) && subscribed;
+    }
+    return subscribed;
+  }
+
+  template<typename Traits>
+  uint8_t BasicApplicationLink<Traits>::GetButtonGestures(uint8_t gamepadIndex, ButtonID buttonID) const noexcept {
+    return m_buttonTimers.GetGestures(gamepadIndex, buttonID);
+  }
+
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::Service() noexcept {
+    internal::ButtonTimerEvent event;
+    while (m_buttonTimers.Expire(millis(), event)) {
+      if (event.gamepadIndex < GetGamepadCount()) {
+        GetGamepad(event.gamepadIndex).NotifyButtonGesture(event.buttonID, event.gesture);
+      }
+    }
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      if (PinMap* pinMap = GetGamepad(gamepadIndex).GetPinMap()) {
+        pinMap->Expire(millis());
+      }
+    }
+  }
+
+  // ──────────────────────────────
+  // COMBOS
+  // ──────────────────────────────
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetComboRecognizer(ComboRecognizer* recognizer) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      GetGamepad(gamepadIndex).SetComboRecognizer(recognizer);
+    }
+  }
+
+  // ──────────────────────────────
+  // AXIS BUTTONS
+  // ──────────────────────────────
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::SetAxisButtons(uint8_t gamepadIndex, AxisButtons* axisButtons) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return false;
+    }
+    GetGamepad(gamepadIndex).SetAxisButtons(axisButtons);
+    return true;
+  }
+
+  // ──────────────────────────────
+  // ORIENTATION
+  // ──────────────────────────────
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::SetImuFusion(uint8_t gamepadIndex, ImuFusion* fusion) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return false;
+    }
+    GetGamepad(gamepadIndex).SetImuFusion(fusion);
+    return true;
+  }
+
+  // ──────────────────────────────
+  // PIN MAPPING
+  // ──────────────────────────────
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::SetPinMap(uint8_t gamepadIndex, PinMap* pinMap) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return false;
+    }
+    Gamepad& gamepad = GetGamepad(gamepadIndex);
+    if (pinMap) {
+      pinMap->Begin(gamepad.GetStatus(), millis());
+    }
+    gamepad.SetPinMap(pinMap);
+    return true;
+  }
+
+  // ──────────────────────────────
+  // RULES
+  // ──────────────────────────────
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::SetRuleVm(uint8_t gamepadIndex, RuleVm* ruleVm) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return false;
+    }
+    GetGamepad(gamepadIndex).SetRuleVm(ruleVm);
+    return true;
+  }
+
+  // ──────────────────────────────
+  // INTERPOLATION
+  // ──────────────────────────────
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::SetAxisInterpolator(uint8_t gamepadIndex, AxisInterpolator* interpolator) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return false;
+    }
+    Gamepad& gamepad = GetGamepad(gamepadIndex);
+    if (interpolator) {
+      interpolator->Reset(gamepad.GetStatus(), micros());
+    }
+    gamepad.SetAxisInterpolator(interpolator);
+    return true;
+  }
+
+  template<typename Traits>
+  int16_t BasicApplicationLink<Traits>::Sample(uint8_t gamepadIndex, uint8_t channel, unsigned long nowMicros) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return 0;
+    }
+    AxisInterpolator* interpolator = GetGamepad(gamepadIndex).GetAxisInterpolator();
+    return interpolator ? interpolator->Sample(channel, nowMicros) : 0;
+  }
+
+  // ──────────────────────────────
+  // INPUT HISTORY
+  // ──────────────────────────────
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::SetInputHistory(uint8_t gamepadIndex, InputHistory* history) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return false;
+    }
+    if (history) {
+      history->Clear();
+    }
+    GetGamepad(gamepadIndex).SetInputHistory(history);
+    return true;
+  }
+
+  template<typename Traits>
+  uint16_t BasicApplicationLink<Traits>::DumpInputHistory(uint8_t gamepadIndex, unsigned long windowMillis) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return 0;
+    }
+    const InputHistory* history = GetGamepad(gamepadIndex).GetInputHistory();
+    if (!history) {
+      Log(F("No input history attached to gamepad"));
+      return 0;
+    }
+    if (history->GetCount() == 0) {
+      return 0;
+    }
+    const unsigned long newest = history->GetNewestMicros();
+    unsigned long from = history->GetOldestMicros();
+    // Only narrow the window when it is shorter than what the ring holds
+    if (windowMillis != 0 && windowMillis * 1000UL < newest - from) {
+      from = newest - windowMillis * 1000UL;
+    }
+    return history->Dump(this->GetLogSerial(), from, newest);
+  }
+
+  // ──────────────────────────────
+  // EVENT QUEUE
+  // ──────────────────────────────
+  template<typename Traits>
+  void BasicApplicationLink<Traits>::SetEventQueueEnabled(bool enabled) noexcept {
+    if (m_eventQueueEnabled == enabled) {
+      return;
+    }
+    if (enabled && m_eventQueue.GetCapacity() == 0) {
+      Log(F("Event queue not available in this link configuration"));
+      return;
+    }
+    if (!enabled) {
+      // Flush so nothing queued is lost when switching back to inline callbacks
+      while (DispatchNextEvent()) {
+      }
+    }
+    m_eventQueueEnabled = enabled;
+    internal::EventQueue* eventQueue = enabled ? &m_eventQueue : nullptr;
+    for (uint8_t i = 0; i < GetGamepadCount(); ++i) {
+      GetGamepad(i).SetEventQueue(eventQueue);
+    }
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::GetEventQueueEnabled() const noexcept {
+    return m_eventQueueEnabled;
+  }
+
+  template<typename Traits>
+  uint8_t BasicApplicationLink<Traits>::DispatchEvents(uint8_t maxEvents, unsigned long maxMicros) noexcept {
+    const unsigned long start = (maxMicros != 0) ? micros() : 0;
+    uint8_t dispatched = 0;
+    while (maxEvents == 0 || dispatched < maxEvents) {
+      if (!DispatchNextEvent()) {
+        break;
+      }
+      ++dispatched;
+      if (maxMicros != 0 && (micros() - start) >= maxMicros) {
+        break;
+      }
+    }
+    return dispatched;
+  }
+
+  template<typename Traits>
+  uint8_t BasicApplicationLink<Traits>::GetPendingEventCount() const noexcept {
+    return m_eventQueue.GetCount();
+  }
+
+  template<typename Traits>
+  uint16_t BasicApplicationLink<Traits>::GetCoalescedEventCount() const noexcept {
+    return m_eventQueue.GetCoalescedCount();
+  }
+
+  template<typename Traits>
+  uint16_t BasicApplicationLink<Traits>::GetEventOverflowCount() const noexcept {
+    return static_cast<uint16_t>(m_eventQueue.GetOverflowCount() + m_sampleOverflowCount);
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::DispatchNextEvent() noexcept {
+    internal::Event event;
+    if (!m_eventQueue.Pop(event)) {
+      return false;
+    }
+    if (event.type == internal::EventType::SENSOR_BATCH) {
+      typename internal::SensorSampleQueue<s_queuedSampleCapacity>::Entry entry;
+      if (m_queuedSamples.Pop(entry) && entry.gamepadIndex < GetGamepadCount()) {
+        GetGamepad(entry.gamepadIndex).NotifySensorBatch(entry.sample, entry.sampleMicros);
+      }
+      return true;
+    }
+    if (event.gamepadIndex < GetGamepadCount()) {
+      GetGamepad(event.gamepadIndex).DispatchEvent(event);
+    }
+    return true;
+  }
+
+  template<typename Traits>
+  bool BasicApplicationLink<Traits>::SendCommand(const internal::Command& command) noexcept {
+    OutputGroup group;
+    if (internal::Command::FindOutputGroup(command.GetOpCode(), group) && !Profile::Has(group)) {
+      Log(F("Command output not in gamepad profile"));
+      return false;
+    }
+    uint8_t data[internal::Command::MaximumLength()];
+    const size_t length = command.Serialize(data, sizeof(data));
+    if(length == 0) {
+      return false;
+    }
+    return SendSerial(data, length);
+  }
+} // namespace GSB
\ No newline at end of file
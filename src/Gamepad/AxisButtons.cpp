@@ -0,0 +1,209 @@
+#include "Gamepad/AxisButtons.h"
+
+namespace GSB {
+  static_assert(VirtualButtons::Count() <= 8, "Virtual button masks are 8 bits");
+
+  namespace {
+    // tan(45° + h) and tan(22.5° + h) in Q12 for h = 0..MaxAngularHysteresis() degrees,
+    // rounded up so neighbouring sectors always overlap at their shared boundary
+    const uint16_t s_fourWayTangents[AxisButtons::MaxAngularHysteresis() + 1] = {
+      4096, 4242, 4392, 4549, 4712, 4881, 5058, 5243, 5436, 5638, 5850, 6073, 6307, 6555, 6817, 7094
+    };
+    const uint16_t s_eightWayTangents[AxisButtons::MaxAngularHysteresis() + 1] = {
+      1697, 1781, 1867, 1954, 2042, 2132, 2224, 2317, 2413, 2510, 2609, 2711, 2815, 2922, 3031, 3143
+    };
+  } // namespace
+
+  AxisButtons::AxisButtons() {
+    Clear();
+  }
+
+  bool AxisButtons::BindTrigger(TriggerID triggerID, ButtonID buttonID, int16_t threshold, uint16_t hysteresis) {
+    if (!IsValid(triggerID)) {
+      return false;
+    }
+    TriggerBinding& binding = m_triggers[TriggerIndex(triggerID)];
+    const uint8_t mask = VirtualMask(buttonID);
+    // A button can only follow one input
+    const uint8_t taken = static_cast<uint8_t>(BoundMask() & ~binding.mask);
+    if (mask == 0 || (mask & taken) != 0) {
+      return false;
+    }
+    m_pressed = static_cast<uint8_t>(m_pressed & ~binding.mask);
+    binding.mask = mask;
+    binding.threshold = threshold;
+    binding.hysteresis = hysteresis;
+    return true;
+  }
+
+  bool AxisButtons::BindJoystick(JoystickID joystickID, StickDirections directions, const ButtonID (&buttons)[4], uint16_t radius, uint16_t radialHysteresis, uint8_t angularHysteresis) {
+    if (!IsValid(joystickID) || !IsValid(directions) || directions == StickDirections::OFF) {
+      return false;
+    }
+    if (radius == 0 || radialHysteresis >= radius || angularHysteresis > MaxAngularHysteresis()) {
+      return false;
+    }
+    JoystickBinding& binding = m_joysticks[JoystickIndex(joystickID)];
+    const uint8_t taken = static_cast<uint8_t>(BoundMask() & ~GetJoystickMask(joystickID));
+    uint8_t masks[4];
+    uint8_t combined = 0;
+    for (uint8_t i = 0; i < 4; ++i) {
+      masks[i] = VirtualMask(buttons[i]);
+      if (masks[i] == 0 || (masks[i] & (taken | combined)) != 0) {
+        return false;
+      }
+      combined = static_cast<uint8_t>(combined | masks[i]);
+    }
+    m_pressed = static_cast<uint8_t>(m_pressed & ~GetJoystickMask(joystickID));
+    binding.directions = directions;
+    for (uint8_t i = 0; i < 4; ++i) {
+      binding.masks[i] = masks[i];
+    }
+    binding.sector = s_noSector;
+    binding.radius = radius;
+    binding.releaseRadius = static_cast<uint16_t>(radius - radialHysteresis);
+    const uint16_t* tangents = (directions == StickDirections::FOUR_WAY) ? s_fourWayTangents : s_eightWayTangents;
+    binding.enterTangent = tangents[0];
+    binding.stayTangent = tangents[angularHysteresis];
+    return true;
+  }
+
+  void AxisButtons::UnbindTrigger(TriggerID triggerID) {
+    if (!IsValid(triggerID)) {
+      return;
+    }
+    TriggerBinding& binding = m_triggers[TriggerIndex(triggerID)];
+    m_pressed = static_cast<uint8_t>(m_pressed & ~binding.mask);
+    binding = TriggerBinding{};
+  }
+
+  void AxisButtons::UnbindJoystick(JoystickID joystickID) {
+    if (!IsValid(joystickID)) {
+      return;
+    }
+    m_pressed = static_cast<uint8_t>(m_pressed & ~GetJoystickMask(joystickID));
+    m_joysticks[JoystickIndex(joystickID)] = JoystickBinding{};
+  }
+
+  void AxisButtons::Clear() {
+    for (uint8_t i = 0; i < TriggerCount(); ++i) {
+      m_triggers[i] = TriggerBinding{};
+    }
+    for (uint8_t i = 0; i < JoystickCount(); ++i) {
+      m_joysticks[i] = JoystickBinding{};
+    }
+    m_pressed = 0;
+  }
+
+  bool AxisButtons::IsPressed(ButtonID buttonID) const {
+    return (m_pressed & VirtualMask(buttonID)) != 0;
+  }
+
+  uint8_t AxisButtons::GetTriggerMask(TriggerID triggerID) const {
+    return IsValid(triggerID) ? m_triggers[TriggerIndex(triggerID)].mask : 0;
+  }
+
+  uint8_t AxisButtons::GetJoystickMask(JoystickID joystickID) const {
+    if (!IsValid(joystickID)) {
+      return 0;
+    }
+    const JoystickBinding& binding = m_joysticks[JoystickIndex(joystickID)];
+    return static_cast<uint8_t>(binding.masks[0] | binding.masks[1] | binding.masks[2] | binding.masks[3]);
+  }
+
+  uint8_t AxisButtons::OnTrigger(TriggerID triggerID, int16_t value) {
+    if (!IsValid(triggerID)) {
+      return 0;
+    }
+    const TriggerBinding& binding = m_triggers[TriggerIndex(triggerID)];
+    if (binding.mask == 0) {
+      return 0;
+    }
+    if ((m_pressed & binding.mask) != 0) {
+      if (static_cast<int32_t>(value) < static_cast<int32_t>(binding.threshold) - binding.hysteresis) {
+        m_pressed = static_cast<uint8_t>(m_pressed & ~binding.mask);
+      }
+    } else if (value >= binding.threshold) {
+      m_pressed = static_cast<uint8_t>(m_pressed | binding.mask);
+    }
+    return binding.mask;
+  }
+
+  uint8_t AxisButtons::OnJoystick(JoystickID joystickID, int16_t valueX, int16_t valueY) {
+    if (!IsValid(joystickID)) {
+      return 0;
+    }
+    JoystickBinding& binding = m_joysticks[JoystickIndex(joystickID)];
+    if (binding.directions == StickDirections::OFF) {
+      return 0;
+    }
+    const int32_t x = valueX;
+    const int32_t y = valueY;
+    const uint32_t radiusSquared = static_cast<uint32_t>(x * x) + static_cast<uint32_t>(y * y);
+    const bool engaged = binding.sector != s_noSector;
+    const uint32_t limit = engaged ? binding.releaseRadius : binding.radius;
+    if (radiusSquared < limit * limit) {
+      binding.sector = s_noSector;
+    } else if (!engaged || !InSector(x, y, binding.sector, binding.stayTangent)) {
+      const uint8_t step = (binding.directions == StickDirections::FOUR_WAY) ? 2 : 1;
+      binding.sector = s_noSector;
+      for (uint8_t sector = 0; sector < 8; sector = static_cast<uint8_t>(sector + step)) {
+        if (InSector(x, y, sector, binding.enterTangent)) {
+          binding.sector = sector;
+          break;
+        }
+      }
+    }
+    const uint8_t mask = GetJoystickMask(joystickID);
+    m_pressed = static_cast<uint8_t>((m_pressed & ~mask) | SectorMask(binding));
+    return mask;
+  }
+
+  uint8_t AxisButtons::BoundMask() const {
+    uint8_t mask = 0;
+    for (uint8_t i = 0; i < TriggerCount(); ++i) {
+      mask = static_cast<uint8_t>(mask | m_triggers[i].mask);
+    }
+    for (uint8_t i = 0; i < JoystickCount(); ++i) {
+      mask = static_cast<uint8_t>(mask | GetJoystickMask(static_cast<JoystickID>(i)));
+    }
+    return mask;
+  }
+
+  uint8_t AxisButtons::VirtualMask(ButtonID buttonID) {
+    uint8_t index = 0;
+    return VirtualButtons::FindButton(buttonID, index) ? static_cast<uint8_t>(1u << index) : 0;
+  }
+
+  // Sectors are numbered in 45° steps counterclockwise from +X. The vector is rotated so
+  // the sector's center lies on +X (90° turns swap axes, the 45° turn scales by √2, which
+  // cancels in the ratio), then |y| / x is compared against the sector's half-width tangent.
+  bool AxisButtons::InSector(int32_t x, int32_t y, uint8_t sector, uint16_t tangent) {
+    for (uint8_t i = 0; i < sector / 2; ++i) {
+      const int32_t previousX = x;
+      x = y;
+      y = -previousX;
+    }
+    if (sector & 1u) {
+      const int32_t previousX = x;
+      x = x + y;
+      y = y - previousX;
+    }
+    if (x <= 0) {
+      return false;
+    }
+    const int32_t absoluteY = (y < 0) ? -y : y;
+    return (absoluteY << 12) <= x * tangent;
+  }
+
+  uint8_t AxisButtons::SectorMask(const JoystickBinding& binding) const {
+    if (binding.sector == s_noSector) {
+      return 0;
+    }
+    const uint8_t direction = static_cast<uint8_t>(binding.sector / 2);
+    if ((binding.sector & 1u) == 0) {
+      return binding.masks[direction];
+    }
+    return static_cast<uint8_t>(binding.masks[direction] | binding.masks[(direction + 1) % 4]);
+  }
+} // namespace GSB
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Gamepad/InputIDs.h"
+
+namespace GSB {
+  enum class StickDirections : uint8_t {
+    OFF,
+    FOUR_WAY,  // 90° sectors; at most one direction held
+    EIGHT_WAY, // 45° sectors; diagonals hold both neighbouring directions
+    COUNT
+  };
+
+  constexpr bool IsValid(StickDirections directions) noexcept {
+    return directions < StickDirections::COUNT;
+  }
+
+  // Per-gamepad virtual buttons (ButtonID::VIRTUAL_1..8) derived from trigger and stick
+  // values, e.g.
+  //   axisButtons.BindTrigger(TriggerID::TRIGGER_1, ButtonID::VIRTUAL_1, 600, 50);
+  //   axisButtons.BindJoystick(JoystickID::JOYSTICK_1, StickDirections::EIGHT_WAY,
+  //     {ButtonID::VIRTUAL_2, ButtonID::VIRTUAL_3, ButtonID::VIRTUAL_4, ButtonID::VIRTUAL_5}, 200, 40, 8);
+  // Gamepad evaluates a binding only when its trigger or stick value changed and sends the
+  // resulting edges through the normal button press/release callbacks.
+  // Triggers press at threshold and release below threshold - hysteresis. Sticks engage at
+  // radius and disengage below radius - radialHysteresis; while engaged, the held sector is
+  // widened by angularHysteresis degrees on each side so the direction does not chatter on
+  // a boundary. Sectors are found with integer cross-multiplies, no trigonometry at runtime.
+  class AxisButtons {
+    public:
+      AxisButtons();
+
+      static constexpr uint8_t MaxAngularHysteresis() noexcept {
+        return 15;
+      }
+
+      // button must be a virtual ButtonID; false leaves the binding unchanged
+      bool BindTrigger(TriggerID triggerID, ButtonID buttonID, int16_t threshold, uint16_t hysteresis);
+      // buttons are the +X, +Y, -X and -Y directions, all virtual ButtonIDs
+      bool BindJoystick(JoystickID joystickID, StickDirections directions, const ButtonID (&buttons)[4], uint16_t radius, uint16_t radialHysteresis, uint8_t angularHysteresis);
+      void UnbindTrigger(TriggerID triggerID);
+      void UnbindJoystick(JoystickID joystickID);
+      void Clear();
+
+      bool IsPressed(ButtonID buttonID) const;
+      // Virtual buttons bound to this input, as a mask over VirtualButtons::buttonIDs
+      uint8_t GetTriggerMask(TriggerID triggerID) const;
+      uint8_t GetJoystickMask(JoystickID joystickID) const;
+
+      // Called by Gamepad with the changed value; returns the mask of buttons it re-evaluated
+      uint8_t OnTrigger(TriggerID triggerID, int16_t value);
+      uint8_t OnJoystick(JoystickID joystickID, int16_t valueX, int16_t valueY);
+
+    private:
+      static constexpr uint8_t s_noSector = 0xFF;
+
+      struct TriggerBinding {
+        uint8_t mask{0};
+        int16_t threshold{0};
+        uint16_t hysteresis{0};
+      };
+
+      struct JoystickBinding {
+        StickDirections directions{StickDirections::OFF};
+        uint8_t masks[4]{};
+        uint8_t sector{s_noSector};
+        uint16_t radius{0};
+        uint16_t releaseRadius{0};
+        // tan(half sector) and tan(half sector + angular hysteresis), Q12
+        uint16_t enterTangent{0};
+        uint16_t stayTangent{0};
+      };
+
+      uint8_t BoundMask() const;
+      static uint8_t VirtualMask(ButtonID buttonID);
+      static bool InSector(int32_t x, int32_t y, uint8_t sector, uint16_t tangent);
+      uint8_t SectorMask(const JoystickBinding& binding) const;
+
+      TriggerBinding m_triggers[TriggerCount()];
+      JoystickBinding m_joysticks[JoystickCount()];
+      uint8_t m_pressed{0};
+  };
+} // namespace GSB
@@ -0,0 +1,149 @@
+#include "Gamepad/AxisInterpolator.h"
+
+namespace GSB {
+  namespace {
+    int16_t Clamp16(int32_t value) {
+      return static_cast<int16_t>((value > 32767) ? 32767 : (value < -32768) ? -32768 : value);
+    }
+
+    // Wrapped micros differences above this are samples taken before the reference time
+    constexpr unsigned long s_maxElapsedMicros = 0x7FFFFFFFUL;
+  } // namespace
+
+  void AxisInterpolator::SetConfig(const AxisInterpolatorConfig& config) {
+    m_config = config;
+  }
+
+  const AxisInterpolatorConfig& AxisInterpolator::GetConfig() const {
+    return m_config;
+  }
+
+  void AxisInterpolator::Reset(const internal::Status& status, unsigned long nowMicros) {
+    for (uint8_t channel = 0; channel < s_channelCount; ++channel) {
+      ChannelState& state = m_channels[channel];
+      const int16_t value = status.GetValue(GroupOf(channel), InputOf(channel), AxisOf(channel));
+      state.from = value;
+      state.to = value;
+      state.arrivalMicros = nowMicros;
+      state.intervalMicros = static_cast<unsigned long>(m_config.maxRampMillis) * 1000UL;
+      state.output = static_cast<int32_t>(value) * 256;
+      state.sampleMicros = nowMicros;
+      state.frames = 0;
+      state.sampled = false;
+    }
+  }
+
+  void AxisInterpolator::OnFrame(const internal::Status& status, uint8_t groups, unsigned long nowMicros) {
+    const unsigned long maxRampMicros = static_cast<unsigned long>(m_config.maxRampMillis) * 1000UL;
+    for (uint8_t channel = 0; channel < s_channelCount; ++channel) {
+      if (!(groups & InputGroupMask(GroupOf(channel)))) {
+        continue;
+      }
+      ChannelState& state = m_channels[channel];
+      // The new ramp starts where the old one is now, before its interval changes
+      state.from = Interpolate(state, nowMicros);
+      // Frame interval as a 1/4 moving average; gaps longer than a ramp are idle streams or
+      // lost links, not the frame rate
+      const unsigned long measured = nowMicros - state.arrivalMicros;
+      if (state.intervalMicros > maxRampMicros) {
+        state.intervalMicros = maxRampMicros;
+      }
+      if (state.frames == 1 && measured <= maxRampMicros) {
+        state.intervalMicros = measured;
+      } else if (state.frames > 1 && measured <= maxRampMicros) {
+        if (measured > state.intervalMicros) {
+          state.intervalMicros += (measured - state.intervalMicros) >> 2;
+        } else {
+          state.intervalMicros -= (state.intervalMicros - measured) >> 2;
+        }
+      }
+      state.to = status.GetValue(GroupOf(channel), InputOf(channel), AxisOf(channel));
+      state.arrivalMicros = nowMicros;
+      if (state.frames < 2) {
+        ++state.frames;
+      }
+    }
+  }
+
+  int16_t AxisInterpolator::Sample(uint8_t channel, unsigned long nowMicros) {
+    if (channel >= s_channelCount) {
+      return 0;
+    }
+    ChannelState& state = m_channels[channel];
+    const int32_t target = static_cast<int32_t>(Interpolate(state, nowMicros)) * 256;
+    if (m_config.slewPerSecond == 0 || !state.sampled) {
+      state.output = target;
+    } else {
+      unsigned long elapsed = nowMicros - state.sampleMicros;
+      if (elapsed > s_maxElapsedMicros) {
+        elapsed = 0;
+      } else if (elapsed > s_maxStepMicros) {
+        elapsed = s_maxStepMicros;
+      }
+      // Q8 units per microsecond: slewPerSecond * 256 / 1e6 = slewPerSecond / 3906.25
+      const int32_t allowed = static_cast<int32_t>((static_cast<uint32_t>(m_config.slewPerSecond) * elapsed) / 3906UL);
+      if (target > state.output + allowed) {
+        state.output += allowed;
+      } else if (target < state.output - allowed) {
+        state.output -= allowed;
+      } else {
+        state.output = target;
+      }
+    }
+    state.sampleMicros = nowMicros;
+    state.sampled = true;
+    return static_cast<int16_t>((state.output + 128) >> 8);
+  }
+
+  int16_t AxisInterpolator::GetTarget(uint8_t channel) const {
+    return (channel < s_channelCount) ? m_channels[channel].to : 0;
+  }
+
+  unsigned long AxisInterpolator::GetInterval(uint8_t channel) const {
+    return (channel < s_channelCount) ? m_channels[channel].intervalMicros : 0;
+  }
+
+  InputGroup AxisInterpolator::GroupOf(uint8_t channel) {
+    return (channel < TriggerCount()) ? InputGroup::TRIGGERS : InputGroup::JOYSTICKS;
+  }
+
+  uint8_t AxisInterpolator::InputOf(uint8_t channel) {
+    return (channel < TriggerCount()) ? channel : (channel - TriggerCount()) / 2;
+  }
+
+  uint8_t AxisInterpolator::AxisOf(uint8_t channel) {
+    return (channel < TriggerCount()) ? 0 : (channel - TriggerCount()) % 2;
+  }
+
+  int16_t AxisInterpolator::Interpolate(const ChannelState& state, unsigned long nowMicros) const {
+    unsigned long elapsed = nowMicros - state.arrivalMicros;
+    if (elapsed > s_maxElapsedMicros || state.intervalMicros == 0) {
+      return (elapsed > s_maxElapsedMicros) ? state.from : state.to;
+    }
+    const int32_t span = static_cast<int32_t>(state.to) - state.from;
+    if (elapsed < state.intervalMicros) {
+      return Clamp16(state.from + Step(span, elapsed, state.intervalMicros));
+    }
+    // Past the ramp's end the frame is late: continue the slope for a while, then hold
+    unsigned long extra = elapsed - state.intervalMicros;
+    const unsigned long limit = static_cast<unsigned long>(m_config.extrapolateMillis) * 1000UL;
+    if (extra > limit) {
+      extra = limit;
+    }
+    if (extra > state.intervalMicros) {
+      extra = state.intervalMicros;
+    }
+    return Clamp16(state.to + Step(span, extra, state.intervalMicros));
+  }
+
+  int32_t AxisInterpolator::Step(int32_t span, unsigned long elapsed, unsigned long interval) {
+    // elapsed <= interval; scaling both keeps |span| * elapsed within 32 bits
+    while (interval > s_maxStepMicros) {
+      interval >>= 1;
+      elapsed >>= 1;
+    }
+    const uint32_t magnitude = static_cast<uint32_t>((span < 0) ? -span : span);
+    const int32_t step = static_cast<int32_t>((magnitude * elapsed) / interval);
+    return (span < 0) ? -step : step;
+  }
+} // namespace GSB
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Gamepad/InputIDs.h"
+#include "internal/Status.h"
+
+namespace GSB {
+  struct AxisInterpolatorConfig {
+    uint16_t maxRampMillis{100};     // longest ramp between frames; longer gaps (idle streams) are not learned
+    uint16_t slewPerSecond{0};       // max output change per second in input units, 0 = unlimited
+    uint16_t extrapolateMillis{0};   // keeps the last slope this long (at most one frame interval) past a ramp's end, 0 = hold
+  };
+
+  // Upsamples trigger and joystick values for loops that run faster than status frames
+  // arrive (e.g. 200 Hz servos fed at 20-60 Hz). Each frame starts a linear ramp from the
+  // value being output at its arrival to the received value, lasting the measured frame
+  // interval, so the output trails the input by about one frame but never steps. When a
+  // frame is late the last slope can continue briefly, and the next frame ramps on from
+  // wherever the output is. Integer only; owned by the caller and attached per gamepad.
+  // Channels are the triggers, then the joystick axes (see Channel):
+  //   const int16_t x = interpolator.Sample(AxisInterpolator::Channel(JoystickID::JOYSTICK_1, 0), micros());
+  class AxisInterpolator {
+    public:
+      static constexpr uint8_t ChannelCount() noexcept {
+        return s_channelCount;
+      }
+
+      static constexpr uint8_t Channel(TriggerID triggerID) noexcept {
+        return TriggerIndex(triggerID);
+      }
+
+      // axis: X = 0, Y = 1
+      static constexpr uint8_t Channel(JoystickID joystickID, uint8_t axis) noexcept {
+        return (IsValid(joystickID) && axis < 2) ? TriggerCount() + JoystickIndex(joystickID) * 2 + axis : ChannelCount();
+      }
+
+      void SetConfig(const AxisInterpolatorConfig& config);
+      const AxisInterpolatorConfig& GetConfig() const;
+      // Jumps every channel to the status values; the link calls this on attach
+      void Reset(const internal::Status& status, unsigned long nowMicros);
+      // A frame carrying the given groups arrived; the link calls this after applying it
+      void OnFrame(const internal::Status& status, uint8_t groups, unsigned long nowMicros);
+
+      // Smoothed value of a channel at nowMicros; 0 for an invalid channel. The slew limit is
+      // applied between calls, so sample each channel regularly (gaps count as at most 65 ms).
+      int16_t Sample(uint8_t channel, unsigned long nowMicros);
+      // Latest received value of a channel
+      int16_t GetTarget(uint8_t channel) const;
+      // Measured frame interval of a channel in microseconds
+      unsigned long GetInterval(uint8_t channel) const;
+
+    private:
+      static constexpr uint8_t s_channelCount = TriggerCount() + JoystickCount() * 2;
+      // Keeps span times elapsed micros within 32 bits
+      static constexpr unsigned long s_maxStepMicros = 65535;
+
+      struct ChannelState {
+        int16_t from{0};
+        int16_t to{0};
+        unsigned long arrivalMicros{0};
+        unsigned long intervalMicros{0};
+        int32_t output{0}; // Q8, after the slew limit
+        unsigned long sampleMicros{0};
+        uint8_t frames{0}; // since Reset, counting to 2: the first gap measured seeds the interval
+        bool sampled{false};
+      };
+
+      static InputGroup GroupOf(uint8_t channel);
+      static uint8_t InputOf(uint8_t channel);
+      static uint8_t AxisOf(uint8_t channel);
+      // The ramp (or extrapolated) value of a channel before the slew limit
+      int16_t Interpolate(const ChannelState& state, unsigned long nowMicros) const;
+      static int32_t Step(int32_t span, unsigned long elapsed, unsigned long interval);
+
+      AxisInterpolatorConfig m_config{};
+      ChannelState m_channels[s_channelCount]{};
+  };
+} // namespace GSB
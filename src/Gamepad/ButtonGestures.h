@@ -0,0 +1,43 @@
+#pragma once
+
+#include <Arduino.h>
+
+namespace GSB {
+  // Timed button events, delivered through SetButtonOnGesture for subscribed buttons
+  enum class ButtonGesture : uint8_t {
+    HOLD,       // still pressed after holdMillis (once per press)
+    LONG_PRESS, // still pressed after longPressMillis (once per press)
+    DOUBLE_TAP, // pressed again within doubleTapMillis of a short press being released
+    REPEAT,     // after repeatDelayMillis, then every repeatIntervalMillis while pressed
+    COUNT
+  };
+
+  constexpr bool IsValid(ButtonGesture gesture) noexcept {
+    return gesture < ButtonGesture::COUNT;
+  }
+
+  constexpr uint8_t ButtonGestureMask(ButtonGesture gesture) noexcept {
+    return IsValid(gesture) ? static_cast<uint8_t>(1u << static_cast<uint8_t>(gesture)) : 0;
+  }
+
+  constexpr uint8_t AllButtonGesturesMask() noexcept {
+    return static_cast<uint8_t>((1u << static_cast<uint8_t>(ButtonGesture::COUNT)) - 1u);
+  }
+
+  // Thresholds shared by every timed button on a link. Resolution is ButtonTiming::TickMillis().
+  struct ButtonTiming {
+    uint16_t holdMillis{300};
+    uint16_t longPressMillis{800};
+    uint16_t doubleTapMillis{250};
+    uint16_t repeatDelayMillis{500};
+    uint16_t repeatIntervalMillis{100};
+
+    static constexpr uint8_t TickShift() noexcept {
+      return 3;
+    }
+
+    static constexpr uint8_t TickMillis() noexcept {
+      return 1u << TickShift();
+    }
+  };
+} // namespace GSB
@@ -0,0 +1,255 @@
+#include "Gamepad/Calibration.h"
+
+namespace GSB {
+  namespace {
+    void WriteInt16(uint8_t* data, int16_t value) {
+      const uint16_t bits = static_cast<uint16_t>(value);
+      data[0] = static_cast<uint8_t>(bits & 0xFF);
+      data[1] = static_cast<uint8_t>(bits >> 8);
+    }
+
+    int16_t ReadInt16(const uint8_t* data) {
+      return static_cast<int16_t>(static_cast<uint16_t>(data[0]) | (static_cast<uint16_t>(data[1]) << 8));
+    }
+
+    bool IsOrdered(uint8_t axis, const AxisCalibration& calibration) {
+      if (calibration.maximum <= calibration.center) {
+        return false;
+      }
+      return Calibration::IsTriggerAxis(axis) || calibration.minimum < calibration.center;
+    }
+  } // namespace
+
+  // ---------- Calibration ----------
+  Calibration::Calibration() {
+    Clear();
+  }
+
+  bool Calibration::IsEnabled() const {
+    return m_enabled;
+  }
+
+  void Calibration::SetEnabled(bool enabled) {
+    m_enabled = enabled;
+  }
+
+  void Calibration::Clear() {
+    for (uint8_t axis = 0; axis < AxisCount(); ++axis) {
+      m_axes[axis] = Identity(axis);
+    }
+    m_enabled = false;
+  }
+
+  const AxisCalibration& Calibration::GetAxis(uint8_t axis) const {
+    return m_axes[(axis < AxisCount()) ? axis : 0];
+  }
+
+  bool Calibration::SetAxis(uint8_t axis, const AxisCalibration& calibration) {
+    if (axis >= AxisCount() || !IsOrdered(axis, calibration)) {
+      return false;
+    }
+    m_axes[axis] = calibration;
+    return true;
+  }
+
+  int16_t Calibration::Apply(uint8_t axis, int16_t raw) const {
+    if (!m_enabled || axis >= AxisCount()) {
+      return raw;
+    }
+    const AxisCalibration& calibration = m_axes[axis];
+    const int32_t offset = static_cast<int32_t>(raw) - calibration.center;
+    if (IsTriggerAxis(axis)) {
+      if (offset <= 0) {
+        return 0;
+      }
+      const int32_t scaled = (offset * TriggerScale()) / (static_cast<int32_t>(calibration.maximum) - calibration.center);
+      return static_cast<int16_t>((scaled > TriggerScale()) ? TriggerScale() : scaled);
+    }
+    // Each side of the stick has its own span
+    if (offset >= 0) {
+      const int32_t scaled = (offset * JoystickScale()) / (static_cast<int32_t>(calibration.maximum) - calibration.center);
+      return static_cast<int16_t>((scaled > JoystickScale()) ? JoystickScale() : scaled);
+    }
+    const int32_t scaled = (offset * JoystickScale()) / (static_cast<int32_t>(calibration.center) - calibration.minimum);
+    return static_cast<int16_t>((scaled < -JoystickScale()) ? -JoystickScale() : scaled);
+  }
+
+  uint16_t Calibration::NoiseTolerance(uint8_t axis) const {
+    if (axis >= AxisCount()) {
+      return 0;
+    }
+    const AxisCalibration& calibration = m_axes[axis];
+    int32_t span = static_cast<int32_t>(calibration.maximum) - calibration.center;
+    int32_t scale = TriggerScale();
+    if (!IsTriggerAxis(axis)) {
+      // The shorter side magnifies the noise the most
+      const int32_t lower = static_cast<int32_t>(calibration.center) - calibration.minimum;
+      span = (lower < span) ? lower : span;
+      scale = JoystickScale();
+    }
+    if (span <= 0) {
+      return static_cast<uint16_t>(calibration.noise + 1);
+    }
+    return static_cast<uint16_t>((static_cast<int32_t>(calibration.noise) * scale + span - 1) / span + 1);
+  }
+
+  size_t Calibration::Export(uint8_t* data, size_t capacity) const {
+    if (!data || capacity < BlobLength()) {
+      return 0;
+    }
+    size_t offset = 0;
+    data[offset++] = BlobVersion();
+    data[offset++] = AxisCount();
+    for (uint8_t axis = 0; axis < AxisCount(); ++axis) {
+      const AxisCalibration& calibration = m_axes[axis];
+      WriteInt16(&data[offset], calibration.center);
+      WriteInt16(&data[offset + 2], calibration.minimum);
+      WriteInt16(&data[offset + 4], calibration.maximum);
+      data[offset + 6] = calibration.noise;
+      offset += 7;
+    }
+    uint8_t sum = 0;
+    for (size_t i = 0; i < offset; ++i) {
+      sum = static_cast<uint8_t>(sum + data[i]);
+    }
+    data[offset++] = static_cast<uint8_t>(0x100 - sum);
+    return offset;
+  }
+
+  bool Calibration::Import(const uint8_t* data, size_t length) {
+    if (!data || length < BlobLength() || data[0] != BlobVersion() || data[1] != AxisCount()) {
+      return false;
+    }
+    uint8_t sum = 0;
+    for (size_t i = 0; i < BlobLength(); ++i) {
+      sum = static_cast<uint8_t>(sum + data[i]);
+    }
+    if (sum != 0) {
+      return false;
+    }
+    AxisCalibration axes[CalibratedAxisCount()];
+    for (uint8_t axis = 0; axis < AxisCount(); ++axis) {
+      const uint8_t* entry = &data[2 + axis * 7];
+      axes[axis].center = ReadInt16(entry);
+      axes[axis].minimum = ReadInt16(entry + 2);
+      axes[axis].maximum = ReadInt16(entry + 4);
+      axes[axis].noise = entry[6];
+      if (!IsOrdered(axis, axes[axis])) {
+        return false;
+      }
+    }
+    for (uint8_t axis = 0; axis < AxisCount(); ++axis) {
+      m_axes[axis] = axes[axis];
+    }
+    m_enabled = true;
+    return true;
+  }
+
+  AxisCalibration Calibration::Identity(uint8_t axis) {
+    AxisCalibration calibration;
+    if (IsTriggerAxis(axis)) {
+      calibration.maximum = TriggerScale();
+    } else {
+      calibration.minimum = -JoystickScale();
+      calibration.maximum = JoystickScale();
+    }
+    return calibration;
+  }
+
+  // ---------- CalibrationSession ----------
+  void CalibrationSession::Start(uint8_t restSamples) {
+    for (uint8_t axis = 0; axis < Calibration::AxisCount(); ++axis) {
+      m_stats[axis] = AxisStats{};
+    }
+    // Two or more, so every axis reports once before the first one completes its set
+    m_restSamples = (restSamples < 2) ? 2 : restSamples;
+    m_phase = Phase::REST;
+  }
+
+  void CalibrationSession::Cancel() {
+    m_phase = Phase::IDLE;
+  }
+
+  CalibrationSession::Phase CalibrationSession::GetPhase() const {
+    return m_phase;
+  }
+
+  void CalibrationSession::Sample(uint8_t axis, int16_t raw) {
+    if (m_phase == Phase::IDLE || axis >= Calibration::AxisCount()) {
+      return;
+    }
+    AxisStats& stats = m_stats[axis];
+    if (m_phase == Phase::SWEEP) {
+      // Only axes that were seen at rest have a center to sweep around
+      if (stats.restCount != 0) {
+        stats.minimum = (raw < stats.minimum) ? raw : stats.minimum;
+        stats.maximum = (raw > stats.maximum) ? raw : stats.maximum;
+      }
+      return;
+    }
+    if (stats.restCount >= m_restSamples) {
+      return;
+    }
+    if (stats.restCount == 0) {
+      stats.restMinimum = raw;
+      stats.restMaximum = raw;
+      stats.minimum = raw;
+      stats.maximum = raw;
+    }
+    stats.sum += raw;
+    stats.restMinimum = (raw < stats.restMinimum) ? raw : stats.restMinimum;
+    stats.restMaximum = (raw > stats.restMaximum) ? raw : stats.restMaximum;
+    stats.minimum = stats.restMinimum;
+    stats.maximum = stats.restMaximum;
+    ++stats.restCount;
+
+    // Sweep starts once every axis that reports has its full set of rest samples
+    for (uint8_t i = 0; i < Calibration::AxisCount(); ++i) {
+      if (m_stats[i].restCount != 0 && m_stats[i].restCount < m_restSamples) {
+        return;
+      }
+    }
+    m_phase = Phase::SWEEP;
+  }
+
+  bool CalibrationSession::Finish(Calibration& calibration) {
+    if (m_phase != Phase::SWEEP) {
+      return false;
+    }
+    AxisCalibration learned[CalibratedAxisCount()];
+    bool reported = false;
+    for (uint8_t axis = 0; axis < Calibration::AxisCount(); ++axis) {
+      const AxisStats& stats = m_stats[axis];
+      if (stats.restCount == 0) {
+        continue;
+      }
+      reported = true;
+      const int32_t jitter = (static_cast<int32_t>(stats.restMaximum) - stats.restMinimum + 1) / 2;
+      AxisCalibration& result = learned[axis];
+      result.center = static_cast<int16_t>(stats.sum / stats.restCount);
+      result.minimum = stats.minimum;
+      result.maximum = stats.maximum;
+      result.noise = static_cast<uint8_t>((jitter > 255) ? 255 : jitter);
+      // Travel must clear the noise floor by a wide margin on every side that moves
+      const int32_t margin = 4 * (static_cast<int32_t>(result.noise) + 1);
+      if (static_cast<int32_t>(result.maximum) - result.center < margin) {
+        return false;
+      }
+      if (!Calibration::IsTriggerAxis(axis) && static_cast<int32_t>(result.center) - result.minimum < margin) {
+        return false;
+      }
+    }
+    if (!reported) {
+      return false;
+    }
+    calibration.Clear();
+    for (uint8_t axis = 0; axis < Calibration::AxisCount(); ++axis) {
+      if (m_stats[axis].restCount != 0) {
+        calibration.SetAxis(axis, learned[axis]);
+      }
+    }
+    calibration.SetEnabled(true);
+    m_phase = Phase::IDLE;
+    return true;
+  }
+} // namespace GSB
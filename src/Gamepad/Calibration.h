@@ -0,0 +1,125 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Gamepad/InputIDs.h"
+
+namespace GSB {
+  // Learned range of one stick or trigger axis, in raw units
+  struct AxisCalibration {
+    int16_t center{0};
+    int16_t minimum{0};
+    int16_t maximum{0};
+    uint8_t noise{0}; // half the peak-to-peak jitter seen at rest
+  };
+
+  // Both axes of each stick plus each trigger
+  constexpr uint8_t CalibratedAxisCount() noexcept {
+    return JoystickCount() * 2 + TriggerCount();
+  }
+
+  // Per-gamepad calibration for both sticks and both triggers. Raw values are mapped with
+  // integer scaling so center reads 0 and each end of the learned range reads full scale
+  // (JoystickScale() for sticks, TriggerScale() for triggers); each side of a stick is
+  // scaled on its own. Disabled until Import or a finished CalibrationSession fills it in.
+  class Calibration {
+    public:
+      Calibration();
+
+      // Axis order: joystick 1 X, Y, joystick 2 X, Y, trigger 1, trigger 2
+      static constexpr uint8_t AxisCount() noexcept {
+        return CalibratedAxisCount();
+      }
+
+      // AxisCount() when the group has no calibrated axes or the input or axis is out of range
+      static constexpr uint8_t AxisIndex(InputGroup group, uint8_t input, uint8_t axis) noexcept {
+        return (group == InputGroup::JOYSTICKS && input < JoystickCount() && axis < 2) ? static_cast<uint8_t>(input * 2 + axis)
+          : (group == InputGroup::TRIGGERS && input < TriggerCount() && axis == 0) ? static_cast<uint8_t>(JoystickCount() * 2 + input)
+          : AxisCount();
+      }
+
+      static constexpr bool IsTriggerAxis(uint8_t axis) noexcept {
+        return axis >= JoystickCount() * 2 && axis < AxisCount();
+      }
+
+      static constexpr int16_t JoystickScale() noexcept {
+        return 512;
+      }
+
+      static constexpr int16_t TriggerScale() noexcept {
+        return 1023;
+      }
+
+      // Blob layout: version, axis count, per axis center/minimum/maximum (int16 LE) and
+      // noise, then a checksum byte that makes all bytes sum to 0 (mod 256)
+      static constexpr uint8_t BlobVersion() noexcept {
+        return 1;
+      }
+
+      static constexpr size_t BlobLength() noexcept {
+        return 3 + AxisCount() * 7;
+      }
+
+      bool IsEnabled() const;
+      void SetEnabled(bool enabled);
+      // Resets every axis to the identity mapping and disables the calibration
+      void Clear();
+
+      const AxisCalibration& GetAxis(uint8_t axis) const;
+      bool SetAxis(uint8_t axis, const AxisCalibration& calibration);
+
+      // Raw -> normalized; passes the value through while disabled
+      int16_t Apply(uint8_t axis, int16_t raw) const;
+      // Smallest normalized step just above the rest noise of this axis
+      uint16_t NoiseTolerance(uint8_t axis) const;
+
+      // Returns bytes written, 0 if capacity < BlobLength()
+      size_t Export(uint8_t* data, size_t capacity) const;
+      // Replaces and enables the calibration; false (nothing changed) on a bad blob
+      bool Import(const uint8_t* data, size_t length);
+
+    private:
+      static AxisCalibration Identity(uint8_t axis);
+
+      AxisCalibration m_axes[CalibratedAxisCount()];
+      bool m_enabled{false};
+  };
+
+  // Collects the statistics for one calibration run. Feed it raw values (Gamepad does this
+  // while a session is attached): the first restSamples values per axis are taken with the
+  // controls released and set center and noise floor, then the phase moves to SWEEP and
+  // the extremes seen until Finish set the range.
+  class CalibrationSession {
+    public:
+      enum class Phase : uint8_t {
+        IDLE,
+        REST,
+        SWEEP
+      };
+
+      CalibrationSession() = default;
+
+      void Start(uint8_t restSamples);
+      void Cancel();
+      Phase GetPhase() const;
+      void Sample(uint8_t axis, int16_t raw);
+
+      // Writes the learned ranges into calibration and enables it. Axes that never reported
+      // keep the identity mapping. False (calibration unchanged) when no axis reported or a
+      // reporting axis did not travel well beyond its noise floor.
+      bool Finish(Calibration& calibration);
+
+    private:
+      struct AxisStats {
+        int32_t sum;
+        int16_t restMinimum;
+        int16_t restMaximum;
+        int16_t minimum;
+        int16_t maximum;
+        uint8_t restCount;
+      };
+
+      AxisStats m_stats[Calibration::AxisCount()]{};
+      Phase m_phase{Phase::IDLE};
+      uint8_t m_restSamples{0};
+  };
+} // namespace GSB
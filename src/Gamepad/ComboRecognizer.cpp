@@ -0,0 +1,215 @@
+#include "Gamepad/ComboRecognizer.h"
+
+namespace GSB {
+  static_assert(ButtonCount() <= 32, "Chord masks hold one bit per button");
+
+  ComboRecognizer::ComboRecognizer(Chord* chords, uint16_t* windows, uint8_t maxCombos, Node* nodes, uint8_t maxNodes, PadState* pads, uint8_t maxGamepads)
+    : m_chords(chords),
+      m_windows(windows),
+      m_nodes(nodes),
+      m_pads(pads),
+      m_maxCombos(maxCombos),
+      m_maxNodes(maxNodes),
+      m_maxGamepads(maxGamepads) {
+    Compile(nullptr, 0);
+  }
+
+  bool ComboRecognizer::Compile(const ComboDefinition* combos, uint8_t count) {
+    m_comboCount = 0;
+    m_chordCount = 0;
+    m_nodeCount = 1;
+    m_nodes[s_root] = Node{0, 0, s_none, s_none, s_root, s_none, s_none};
+    for (uint8_t i = 0; i < m_maxGamepads; ++i) {
+      Reset(i);
+    }
+    if (count > m_maxCombos || (count != 0 && !combos)) {
+      return false;
+    }
+    for (uint8_t i = 0; i < count; ++i) {
+      const ComboDefinition& combo = combos[i];
+      bool valid = IsValid(combo.type) && combo.length != 0 && combo.length <= ComboMaxLength();
+      for (uint8_t step = 0; valid && step < combo.length; ++step) {
+        valid = IsValid(combo.buttons[step]);
+      }
+      if (!valid) {
+        Compile(nullptr, 0);
+        return false;
+      }
+      m_windows[i] = combo.windowMillis;
+      if (combo.type == ComboType::SEQUENCE) {
+        if (!AddSequence(combo, i)) {
+          Compile(nullptr, 0);
+          return false;
+        }
+        continue;
+      }
+      uint32_t mask = 0;
+      for (uint8_t step = 0; step < combo.length; ++step) {
+        mask |= 1UL << static_cast<uint8_t>(combo.buttons[step]);
+      }
+      // Insertion keeps the table sorted for the binary search; a repeated mask keeps its first combo
+      uint8_t position = m_chordCount;
+      while (position > 0 && m_chords[position - 1].mask > mask) {
+        --position;
+      }
+      if (position > 0 && m_chords[position - 1].mask == mask) {
+        continue;
+      }
+      for (uint8_t j = m_chordCount; j > position; --j) {
+        m_chords[j] = m_chords[j - 1];
+      }
+      m_chords[position] = Chord{mask, i};
+      ++m_chordCount;
+    }
+    LinkFailures();
+    m_comboCount = count;
+    return true;
+  }
+
+  void ComboRecognizer::SetOnCombo(void (*fxPtr)(uint8_t gamepadIndex, uint8_t comboIndex)) {
+    m_onCombo = fxPtr;
+  }
+
+  void ComboRecognizer::OnButton(uint8_t gamepadIndex, ButtonID buttonID, bool pressed, unsigned long nowMillis) {
+    uint8_t matches[ComboMaxMatches()];
+    const uint8_t count = OnButton(gamepadIndex, buttonID, pressed, nowMillis, matches);
+    for (uint8_t i = 0; i < count; ++i) {
+      NotifyCombo(gamepadIndex, matches[i]);
+    }
+  }
+
+  uint8_t ComboRecognizer::OnButton(uint8_t gamepadIndex, ButtonID buttonID, bool pressed, unsigned long nowMillis, uint8_t (&matches)[ComboMaxMatches()]) {
+    if (gamepadIndex >= m_maxGamepads || !IsValid(buttonID) || m_comboCount == 0) {
+      return 0;
+    }
+    PadState& pad = m_pads[gamepadIndex];
+    const uint32_t bit = 1UL << static_cast<uint8_t>(buttonID);
+    if (!pressed) {
+      pad.held &= ~bit;
+      return 0;
+    }
+    pad.held |= bit;
+    uint8_t count = 0;
+    if (m_chordCount != 0) {
+      count = MatchChord(pad.held, matches);
+    }
+    count = static_cast<uint8_t>(count + MatchSequences(pad, static_cast<uint8_t>(buttonID), static_cast<uint16_t>(nowMillis), &matches[count]));
+    return m_onCombo ? count : 0;
+  }
+
+  void ComboRecognizer::NotifyCombo(uint8_t gamepadIndex, uint8_t comboIndex) const {
+    if (m_onCombo) {
+      m_onCombo(gamepadIndex, comboIndex);
+    }
+  }
+
+  void ComboRecognizer::Reset(uint8_t gamepadIndex) {
+    if (gamepadIndex >= m_maxGamepads) {
+      return;
+    }
+    m_pads[gamepadIndex] = PadState{};
+    m_pads[gamepadIndex].node = s_root;
+  }
+
+  uint8_t ComboRecognizer::GetComboCount() const {
+    return m_comboCount;
+  }
+
+  uint8_t ComboRecognizer::GetNodeCount() const {
+    return m_nodeCount;
+  }
+
+  uint8_t ComboRecognizer::FindChild(uint8_t node, uint8_t button) const {
+    uint8_t child = m_nodes[node].firstChild;
+    while (child != s_none && m_nodes[child].button != button) {
+      child = m_nodes[child].nextSibling;
+    }
+    return child;
+  }
+
+  // Goto with failure fallback; never fails at the root
+  uint8_t ComboRecognizer::Advance(uint8_t node, uint8_t button) const {
+    uint8_t child = FindChild(node, button);
+    while (child == s_none && node != s_root) {
+      node = m_nodes[node].fail;
+      child = FindChild(node, button);
+    }
+    return (child == s_none) ? static_cast<uint8_t>(s_root) : child;
+  }
+
+  bool ComboRecognizer::AddSequence(const ComboDefinition& combo, uint8_t comboIndex) {
+    uint8_t node = s_root;
+    for (uint8_t step = 0; step < combo.length; ++step) {
+      const uint8_t button = static_cast<uint8_t>(combo.buttons[step]);
+      uint8_t child = FindChild(node, button);
+      if (child == s_none) {
+        if (m_nodeCount >= m_maxNodes) {
+          return false;
+        }
+        child = m_nodeCount++;
+        m_nodes[child] = Node{button, static_cast<uint8_t>(step + 1), s_none, m_nodes[node].firstChild, s_root, s_none, s_none};
+        m_nodes[node].firstChild = child;
+      }
+      node = child;
+    }
+    // A repeated sequence keeps its first combo
+    if (m_nodes[node].combo == s_none) {
+      m_nodes[node].combo = comboIndex;
+    }
+    return true;
+  }
+
+  // Breadth-first by depth, so a node's failure target is always linked before its children
+  void ComboRecognizer::LinkFailures() {
+    for (uint8_t depth = 0; depth < ComboMaxLength(); ++depth) {
+      for (uint8_t parent = 0; parent < m_nodeCount; ++parent) {
+        if (m_nodes[parent].depth != depth) {
+          continue;
+        }
+        for (uint8_t child = m_nodes[parent].firstChild; child != s_none; child = m_nodes[child].nextSibling) {
+          Node& node = m_nodes[child];
+          node.fail = (parent == s_root) ? static_cast<uint8_t>(s_root) : Advance(m_nodes[parent].fail, node.button);
+          const Node& fail = m_nodes[node.fail];
+          node.outputLink = (fail.combo != s_none) ? node.fail : fail.outputLink;
+        }
+      }
+    }
+  }
+
+  uint8_t ComboRecognizer::MatchChord(uint32_t held, uint8_t* matches) const {
+    uint8_t low = 0;
+    uint8_t high = m_chordCount;
+    while (low < high) {
+      const uint8_t middle = static_cast<uint8_t>((low + high) / 2);
+      if (m_chords[middle].mask < held) {
+        low = static_cast<uint8_t>(middle + 1);
+      } else {
+        high = middle;
+      }
+    }
+    if (low < m_chordCount && m_chords[low].mask == held) {
+      matches[0] = m_chords[low].combo;
+      return 1;
+    }
+    return 0;
+  }
+
+  // Each match on the output chain is shorter than the last, so at most ComboMaxLength() are written
+  uint8_t ComboRecognizer::MatchSequences(PadState& pad, uint8_t button, uint16_t now, uint8_t* matches) const {
+    uint8_t count = 0;
+    pad.pressTimes[pad.pressIndex] = now;
+    pad.node = Advance(pad.node, button);
+    uint8_t match = (m_nodes[pad.node].combo != s_none) ? pad.node : m_nodes[pad.node].outputLink;
+    for (; match != s_none; match = m_nodes[match].outputLink) {
+      const Node& node = m_nodes[match];
+      // Press that started this match: depth - 1 presses back in the ring
+      const uint8_t first = static_cast<uint8_t>((pad.pressIndex + ComboMaxLength() - (node.depth - 1)) % ComboMaxLength());
+      const uint16_t window = m_windows[node.combo];
+      if (window == 0 || static_cast<uint16_t>(now - pad.pressTimes[first]) <= window) {
+        matches[count++] = node.combo;
+      }
+    }
+    pad.pressIndex = static_cast<uint8_t>((pad.pressIndex + 1) % ComboMaxLength());
+    return count;
+  }
+} // namespace GSB
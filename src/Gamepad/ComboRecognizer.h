@@ -0,0 +1,132 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Gamepad/InputIDs.h"
+
+namespace GSB {
+  enum class ComboType : uint8_t {
+    CHORD,    // fires when exactly these buttons are held, on the press that completes the set
+    SEQUENCE, // fires when these buttons are pressed in order within windowMillis
+    COUNT
+  };
+
+  constexpr bool IsValid(ComboType type) noexcept {
+    return type < ComboType::COUNT;
+  }
+
+  constexpr uint8_t ComboMaxLength() noexcept {
+    return 8;
+  }
+
+  // Combos one press can complete: a chord plus one sequence per suffix length
+  constexpr uint8_t ComboMaxMatches() noexcept {
+    return ComboMaxLength() + 1;
+  }
+
+  // One entry of a combo table, e.g.
+  //   constexpr ComboDefinition combos[] = {
+  //     {ComboType::CHORD, 0, 3, {Xbox::Buttons::LB, Xbox::Buttons::RB, Xbox::Buttons::A}},
+  //     {ComboType::SEQUENCE, 1000, 4, {Xbox::DPad::UP, Xbox::DPad::UP, Xbox::DPad::DOWN, Xbox::DPad::DOWN}},
+  //   };
+  // The combo callback receives the entry's index in the table.
+  struct ComboDefinition {
+    ComboType type;
+    uint16_t windowMillis; // SEQUENCE only: first press to last press (0 = no limit)
+    uint8_t length;
+    ButtonID buttons[ComboMaxLength()];
+  };
+
+  // Compiles a combo table into a state machine shared by every gamepad it is attached to.
+  // Chords become a sorted table of button masks matched against the held set with a binary
+  // search. Sequences become a trie with failure links (Aho-Corasick), so each press takes
+  // at most one transition chain from the current state instead of testing every combo;
+  // the last ComboMaxLength() press times per gamepad check the time window.
+  // Storage is supplied by BasicComboRecognizer so Gamepad can hold a size-agnostic pointer.
+  class ComboRecognizer {
+    public:
+      // Replaces the compiled table; false (nothing compiled) when a definition is invalid
+      // or the table does not fit this recognizer's capacity
+      bool Compile(const ComboDefinition* combos, uint8_t count);
+      void SetOnCombo(void (*fxPtr)(uint8_t gamepadIndex, uint8_t comboIndex));
+      // Feeds one button edge and runs the combo callback for every combo it completes
+      void OnButton(uint8_t gamepadIndex, ButtonID buttonID, bool pressed, unsigned long nowMillis);
+      // Same, but writes the completed combo indices to matches (up to ComboMaxMatches()) and
+      // returns how many, leaving delivery to the caller; Gamepad uses this to queue combos.
+      // Nothing is reported while no combo callback is set.
+      uint8_t OnButton(uint8_t gamepadIndex, ButtonID buttonID, bool pressed, unsigned long nowMillis, uint8_t (&matches)[ComboMaxMatches()]);
+      // Runs the combo callback, if set
+      void NotifyCombo(uint8_t gamepadIndex, uint8_t comboIndex) const;
+      // Forgets held buttons and sequence progress, e.g. after a disconnect
+      void Reset(uint8_t gamepadIndex);
+
+      uint8_t GetComboCount() const;
+      uint8_t GetNodeCount() const;
+
+    protected:
+      struct Chord {
+        uint32_t mask;
+        uint8_t combo;
+      };
+
+      struct Node {
+        uint8_t button;
+        uint8_t depth;
+        uint8_t firstChild;
+        uint8_t nextSibling;
+        uint8_t fail;
+        uint8_t combo;      // sequence ending here, or s_none
+        uint8_t outputLink; // nearest node on the failure chain that ends a sequence
+      };
+
+      struct PadState {
+        uint32_t held;
+        uint16_t pressTimes[ComboMaxLength()];
+        uint8_t pressIndex;
+        uint8_t node;
+      };
+
+      ComboRecognizer(Chord* chords, uint16_t* windows, uint8_t maxCombos, Node* nodes, uint8_t maxNodes, PadState* pads, uint8_t maxGamepads);
+      ComboRecognizer(const ComboRecognizer&) = delete;
+      ComboRecognizer& operator=(const ComboRecognizer&) = delete;
+
+    private:
+      static constexpr uint8_t s_none = 0xFF;
+      static constexpr uint8_t s_root = 0;
+
+      uint8_t FindChild(uint8_t node, uint8_t button) const;
+      uint8_t Advance(uint8_t node, uint8_t button) const;
+      bool AddSequence(const ComboDefinition& combo, uint8_t comboIndex);
+      void LinkFailures();
+      uint8_t MatchChord(uint32_t held, uint8_t* matches) const;
+      uint8_t MatchSequences(PadState& pad, uint8_t button, uint16_t now, uint8_t* matches) const;
+
+      Chord* m_chords;
+      uint16_t* m_windows;
+      Node* m_nodes;
+      PadState* m_pads;
+      uint8_t m_maxCombos;
+      uint8_t m_maxNodes;
+      uint8_t m_maxGamepads;
+      uint8_t m_comboCount{0};
+      uint8_t m_chordCount{0};
+      uint8_t m_nodeCount{1};
+      void (*m_onCombo)(uint8_t gamepadIndex, uint8_t comboIndex){nullptr};
+  };
+
+  template<uint8_t MaxCombos = 8, uint8_t MaxNodes = 32, uint8_t MaxGamepads = 4>
+  class BasicComboRecognizer : public ComboRecognizer {
+    public:
+      BasicComboRecognizer() : ComboRecognizer(m_chordStorage, m_windowStorage, MaxCombos, m_nodeStorage, MaxNodes, m_padStorage, MaxGamepads) {
+
+      }
+
+    private:
+      static_assert(MaxCombos > 0 && MaxCombos < 0xFF, "Combo indices must fit below the empty marker");
+      static_assert(MaxNodes > 0 && MaxNodes < 0xFF, "Node indices must fit below the empty marker");
+      static_assert(MaxGamepads > 0, "At least one gamepad is required");
+      Chord m_chordStorage[MaxCombos]{};
+      uint16_t m_windowStorage[MaxCombos]{};
+      Node m_nodeStorage[MaxNodes]{};
+      PadState m_padStorage[MaxGamepads]{};
+  };
+} // namespace GSB
@@ -1,34 +1,142 @@
 #pragma once
 #include <Arduino.h>
+#include "Gamepad/AxisButtons.h"
+#include "Gamepad/AxisInterpolator.h"
+#include "Gamepad/Calibration.h"
+#include "Gamepad/ComboRecognizer.h"
+#include "Gamepad/ImuFusion.h"
+#include "Gamepad/InputHistory.h"
 #include "Gamepad/Inputs.h"
 #include "Gamepad/InputIDs.h"
+#include "Gamepad/JoystickPolar.h"
+#include "Gamepad/JoystickShaper.h"
 #include "Gamepad/Outputs.h"
+#include "Gamepad/PinMap.h"
+#include "Gamepad/RuleVm.h"
 #include "Gamepad/OutputIDs.h"
+#include "Gamepad/GamepadProfile.h"
 #include "internal/Status.h"
+#include "internal/SensorBatch.h"
+#include "internal/EventQueue.h"
+#include "internal/ButtonTimers.h"
+#include "internal/JoystickState.h"
 
 namespace GSB {
-  class Gamepad {
+  namespace internal {
+    // BasicGamepad's callbacks and attached features, each enabled only when the profile has
+    // the groups it works on. Bases inherits them all so the disabled ones take no storage.
+    template<typename Profile>
+    struct GamepadSlots {
+      static constexpr bool s_inputs = Profile::inputGroups != 0;
+      static constexpr bool s_buttons = Profile::Has(InputGroup::BUTTONS);
+      static constexpr bool s_axes = Profile::Has(InputGroup::TRIGGERS) || Profile::Has(InputGroup::JOYSTICKS);
+
+      struct ButtonOnPressTag;
+      struct ButtonOnReleaseTag;
+      struct ButtonOnGestureTag;
+      struct TriggerOnChangeTag;
+      struct JoystickOnChangeTag;
+      struct JoystickOnPolarTag;
+      struct JoystickOnSectorTag;
+      struct BatteryOnChangeTag;
+      struct SensorOnChangeTag;
+      struct OrientationOnChangeTag;
+      struct SensorOnBatchTag;
+      struct RumbleOnChangeTag;
+      struct PlayerLedOnChangeTag;
+      struct ColorLedOnChangeTag;
+      struct EventQueueTag;
+      struct ButtonTimersTag;
+      struct ComboRecognizerTag;
+      struct AxisButtonsTag;
+      struct InputHistoryTag;
+      struct ImuFusionTag;
+      struct PinMapTag;
+      struct RuleVmTag;
+      struct AxisInterpolatorTag;
+      struct CalibrationTag;
+      struct CalibrationSessionTag;
+
+      using ButtonOnPress = PointerSlot<void (*)(uint8_t gamepadIndex, ButtonID buttonID), s_buttons, ButtonOnPressTag>;
+      using ButtonOnRelease = PointerSlot<void (*)(uint8_t gamepadIndex, ButtonID buttonID), s_buttons, ButtonOnReleaseTag>;
+      using ButtonOnGesture = PointerSlot<void (*)(uint8_t gamepadIndex, ButtonID buttonID, ButtonGesture gesture), s_buttons, ButtonOnGestureTag>;
+      using TriggerOnChange = PointerSlot<void (*)(uint8_t gamepadIndex, TriggerID triggerID, int16_t value), Profile::Has(InputGroup::TRIGGERS), TriggerOnChangeTag>;
+      using JoystickOnChange = PointerSlot<void (*)(uint8_t gamepadIndex, JoystickID joystickID, int16_t valueX, int16_t valueY), Profile::Has(InputGroup::JOYSTICKS), JoystickOnChangeTag>;
+      using JoystickOnPolar = PointerSlot<void (*)(uint8_t gamepadIndex, JoystickID joystickID, uint16_t magnitude, uint16_t angle), Profile::Has(InputGroup::JOYSTICKS), JoystickOnPolarTag>;
+      using JoystickOnSector = PointerSlot<void (*)(uint8_t gamepadIndex, JoystickID joystickID, uint8_t sector), Profile::Has(InputGroup::JOYSTICKS), JoystickOnSectorTag>;
+      using BatteryOnChange = PointerSlot<void (*)(uint8_t gamepadIndex, BatteryID batteryID, uint8_t value), Profile::Has(InputGroup::BATTERY), BatteryOnChangeTag>;
+      using SensorOnChange = PointerSlot<void (*)(uint8_t gamepadIndex, SensorID sensorID, int16_t valueX, int16_t valueY, int16_t valueZ), Profile::Has(InputGroup::SENSORS), SensorOnChangeTag>;
+      using OrientationOnChange = PointerSlot<void (*)(uint8_t gamepadIndex, int16_t roll, int16_t pitch, int16_t yaw), Profile::Has(InputGroup::SENSORS), OrientationOnChangeTag>;
+      using SensorOnBatch = PointerSlot<void (*)(uint8_t gamepadIndex, const SensorSample& sample, unsigned long sampleMicros), Profile::Has(InputGroup::SENSORS), SensorOnBatchTag>;
+      using RumbleOnChange = PointerSlot<void (*)(uint8_t gamepadIndex, RumbleID rumbleID, uint8_t force, uint8_t duration), Profile::Has(OutputGroup::RUMBLE), RumbleOnChangeTag>;
+      using PlayerLedOnChange = PointerSlot<void (*)(uint8_t gamepadIndex, PlayerLedID playerLedID, bool illuminated), Profile::Has(OutputGroup::PLAYER_LEDS), PlayerLedOnChangeTag>;
+      using ColorLedOnChange = PointerSlot<void (*)(uint8_t gamepadIndex, ColorLedID colorLedID, bool illuminated, uint8_t red, uint8_t green, uint8_t blue), Profile::Has(OutputGroup::COLOR_LEDS), ColorLedOnChangeTag>;
+
+      using EventQueueSlot = PointerSlot<EventQueue*, s_inputs, EventQueueTag>;
+      using ButtonTimersSlot = PointerSlot<ButtonTimers*, s_buttons, ButtonTimersTag>;
+      using ComboRecognizerSlot = PointerSlot<ComboRecognizer*, s_buttons, ComboRecognizerTag>;
+      using AxisButtonsSlot = PointerSlot<AxisButtons*, s_buttons && s_axes, AxisButtonsTag>;
+      using InputHistorySlot = PointerSlot<InputHistory*, s_inputs, InputHistoryTag>;
+      using ImuFusionSlot = PointerSlot<ImuFusion*, Profile::Has(InputGroup::SENSORS), ImuFusionTag>;
+      using PinMapSlot = PointerSlot<PinMap*, s_inputs, PinMapTag>;
+      using RuleVmSlot = PointerSlot<RuleVm*, s_inputs, RuleVmTag>;
+      using AxisInterpolatorSlot = PointerSlot<AxisInterpolator*, s_axes, AxisInterpolatorTag>;
+      using CalibrationSlot = PointerSlot<Calibration*, s_axes, CalibrationTag>;
+      using CalibrationSessionSlot = PointerSlot<CalibrationSession*, s_axes, CalibrationSessionTag>;
+
+      class Bases :
+        public ButtonOnPress, public ButtonOnRelease, public ButtonOnGesture, public TriggerOnChange,
+        public JoystickOnChange, public JoystickOnPolar, public JoystickOnSector, public BatteryOnChange,
+        public SensorOnChange, public OrientationOnChange, public SensorOnBatch, public RumbleOnChange,
+        public PlayerLedOnChange, public ColorLedOnChange,
+        public EventQueueSlot, public ButtonTimersSlot, public ComboRecognizerSlot, public AxisButtonsSlot,
+        public InputHistorySlot, public ImuFusionSlot, public PinMapSlot, public RuleVmSlot,
+        public AxisInterpolatorSlot, public CalibrationSlot, public CalibrationSessionSlot {};
+    };
+  } // namespace internal
+
+  // Profile selects which input/output groups exist (see GamepadProfile.h). Callbacks,
+  // attached features and per-stick state outside the profile are ignored and take no storage.
+  template<typename Profile = FullProfile>
+  class BasicGamepad :
+    private internal::GamepadSlots<Profile>::Bases,
+    private internal::JoystickStates<Profile::JoystickCount()> {
     public:
-      Gamepad() = delete;
-      explicit Gamepad(uint8_t index) noexcept;
+      // Links build their gamepads in place and number them with Init
+      BasicGamepad() noexcept;
+      explicit BasicGamepad(uint8_t index) noexcept;
+      void Init(uint8_t index) noexcept;
 
-      Gamepad(const Gamepad&) = delete;
-      Gamepad& operator=(const Gamepad&) = delete;
-      Gamepad(Gamepad&&) = delete;
-      Gamepad& operator=(Gamepad&&) = delete;
+      BasicGamepad(const BasicGamepad&) = delete;
+      BasicGamepad& operator=(const BasicGamepad&) = delete;
+      BasicGamepad(BasicGamepad&&) = delete;
+      BasicGamepad& operator=(BasicGamepad&&) = delete;
 
       const internal::Status& GetStatus() const noexcept;
       internal::Status& GetStatus() noexcept;
       uint8_t GetIndex() const noexcept;
+      // Input groups whose status fields changed since they were last cleared (e.g. by a send)
+      uint8_t GetChangedGroups() const noexcept;
+      void ClearChangedGroups(uint8_t groups) noexcept;
 
       //Inputs
       void SetButtonOnPress(void (*fxPtr)(uint8_t gamepadIndex, ButtonID buttonID));
       void SetButtonOnRelease(void (*fxPtr)(uint8_t gamepadIndex, ButtonID buttonID));
+      void SetButtonOnGesture(void (*fxPtr)(uint8_t gamepadIndex, ButtonID buttonID, ButtonGesture gesture));
       void SetTriggerOnChange(void (*fxPtr)(uint8_t gamepadIndex, TriggerID triggerID, int16_t value));
       void SetJoystickOnChange(void (*fxPtr)(uint8_t gamepadIndex, JoystickID joystickID, int16_t valueX, int16_t valueY));
+      // Magnitude and binary angle (see JoystickPolar.h) of each stick change, computed only
+      // while this callback is set or the stick tracks sectors
+      void SetJoystickOnPolar(void (*fxPtr)(uint8_t gamepadIndex, JoystickID joystickID, uint16_t magnitude, uint16_t angle));
+      void SetJoystickOnSector(void (*fxPtr)(uint8_t gamepadIndex, JoystickID joystickID, uint8_t sector));
       void SetBatteryOnChange(void (*fxPtr)(uint8_t gamepadIndex, BatteryID batteryID, uint8_t value));
       void SetSensorOnChange(void (*fxPtr)(uint8_t gamepadIndex, SensorID sensorID, int16_t valueX, int16_t valueY, int16_t valueZ));
+      // Roll, pitch and yaw (Q15 binary angles, see ImuFusion.h) from the attached fusion stage
+      void SetOrientationOnChange(void (*fxPtr)(uint8_t gamepadIndex, int16_t roll, int16_t pitch, int16_t yaw));
+      // Every sample of a received sensor batch, in order, stamped with its estimated micros()
+      void SetSensorOnBatch(void (*fxPtr)(uint8_t gamepadIndex, const SensorSample& sample, unsigned long sampleMicros));
 
+      // Physical buttons only; virtual ButtonIDs follow the attached AxisButtons
       void SetButton(ButtonID buttonID, bool pressed);
       void SetTrigger(TriggerID triggerID, int16_t value);
       void SetJoystick(JoystickID joystickID, int16_t valueX, int16_t valueY);
@@ -39,6 +147,9 @@ namespace GSB {
       void SetSensorX(SensorID sensorID, int16_t value);
       void SetSensorY(SensorID sensorID, int16_t value);
       void SetSensorZ(SensorID sensorID, int16_t value);
+      // Applies a whole snapshot (gamepadIndex is ignored) in one pass: button masks are diffed
+      // with XOR, each axis is tolerance-checked once. Same callbacks as the single setters.
+      void SetStatus(const internal::Status& status, uint8_t groups = AllInputGroupsMask());
 
       void SetTriggerTolerance(TriggerID triggerID, uint16_t tolerance);
       void SetJoystickTolerance(JoystickID joystickID, uint16_t toleranceX, uint16_t toleranceY);
@@ -49,6 +160,76 @@ namespace GSB {
       void SetSensorToleranceX(SensorID sensorID, uint16_t tolerance);
       void SetSensorToleranceY(SensorID sensorID, uint16_t tolerance);
       void SetSensorToleranceZ(SensorID sensorID, uint16_t tolerance);
+      // Filter of one axis addressed by (group, input ID, axis: X = 0, Y = 1, Z = 2);
+      // BATTERY takes axis 0 and ignores deadzone. Out-of-profile inputs read 0 / return false.
+      uint16_t GetTolerance(InputGroup group, uint8_t input, uint8_t axis) const;
+      uint16_t GetDeadzone(InputGroup group, uint8_t input, uint8_t axis) const;
+      bool SetFilter(InputGroup group, uint8_t input, uint8_t axis, uint16_t tolerance, uint16_t deadzone = 0);
+
+      // Stick shaping, applied before the tolerance check (see JoystickShaper.h)
+      void SetJoystickShape(JoystickID joystickID, const JoystickShape& shape);
+      const JoystickShape& GetJoystickShape(JoystickID joystickID) const;
+
+      // Polar view of the current stick value, computed on call
+      PolarValue GetJoystickPolar(JoystickID joystickID) const;
+      // Splits the stick into count equal sectors (0 = off), sector 0 centered on +X; the sector
+      // callback fires on each change, with count meaning centered (below minimumMagnitude)
+      void SetJoystickSectors(JoystickID joystickID, uint8_t count, uint16_t minimumMagnitude);
+      uint8_t GetJoystickSector(JoystickID joystickID) const;
+
+      // Smoothing for every axis of an input (see Axis::SetFilter)
+      void SetTriggerFilter(TriggerID triggerID, uint8_t emaShift, bool median);
+      void SetJoystickFilter(JoystickID joystickID, uint8_t emaShift, bool median);
+      void SetSensorFilter(SensorID sensorID, uint8_t emaShift, bool median);
+
+      // Stick and trigger values are normalized through an attached calibration before
+      // shaping and filtering; an attached session is fed the raw values (see Calibration.h).
+      // Both are owned by the caller; nullptr detaches.
+      void SetCalibration(Calibration* calibration);
+      Calibration* GetCalibration() const;
+      void SetCalibrationSession(CalibrationSession* session);
+      // Sets each calibrated axis's tolerance just above its measured noise
+      void ApplyCalibrationTolerances();
+
+      // When a queue is attached, input changes are queued instead of invoking callbacks
+      void SetEventQueue(internal::EventQueue* eventQueue);
+      void DispatchEvent(const internal::Event& event);
+      // When timers are attached, press/release edges of subscribed buttons drive them;
+      // gestures found by ButtonTimers::Expire are delivered through NotifyButtonGesture
+      void SetButtonTimers(internal::ButtonTimers* buttonTimers);
+      void NotifyButtonGesture(ButtonID buttonID, ButtonGesture gesture);
+      // Button edges are fed to an attached recognizer (see ComboRecognizer.h); nullptr detaches
+      void SetComboRecognizer(ComboRecognizer* recognizer);
+      // Virtual buttons are re-evaluated when their trigger or stick changes (see AxisButtons.h).
+      // Owned by the caller; nullptr detaches and releases any held virtual buttons.
+      void SetAxisButtons(AxisButtons* axisButtons);
+      AxisButtons* GetAxisButtons() const;
+      // Applied status frames are recorded by the link into an attached history; nullptr detaches
+      void SetInputHistory(InputHistory* history);
+      InputHistory* GetInputHistory() const;
+      // Gyro (SENSOR_1) and accelerometer (SENSOR_2) values are fused into an orientation by an
+      // attached ImuFusion, which is reset on attach; nullptr detaches
+      void SetImuFusion(ImuFusion* fusion);
+      ImuFusion* GetImuFusion() const;
+      // Feeds the current sensor values to the fusion stage; the link calls this per sensor frame
+      void UpdateOrientation(unsigned long nowMicros);
+      // One batched sensor sample: sets the sensors and runs the fusion stage at the sample's time.
+      // The link delivers the batch callback, queued or inline, with NotifySensorBatch.
+      void ApplySensorSample(const SensorSample& sample, unsigned long sampleMicros);
+      void NotifySensorBatch(const SensorSample& sample, unsigned long sampleMicros);
+      bool HasSensorOnBatch() const;
+      // Applied status frames drive pins through an attached table (see PinMap.h); the link
+      // updates it after each frame and expires its pulses. Owned by the caller; nullptr detaches.
+      void SetPinMap(PinMap* pinMap);
+      PinMap* GetPinMap() const;
+      // An attached rule program runs over the status after each applied frame (see RuleVm.h).
+      // Owned by the caller; nullptr detaches.
+      void SetRuleVm(RuleVm* ruleVm);
+      RuleVm* GetRuleVm() const;
+      // Trigger and joystick frames feed an attached interpolator with their arrival times (see
+      // AxisInterpolator.h). Owned by the caller; nullptr detaches.
+      void SetAxisInterpolator(AxisInterpolator* interpolator);
+      AxisInterpolator* GetAxisInterpolator() const;
 
       //Outputs
       void SetOnDisconnect(void (*fxPtr)(uint8_t gamepadIndex));
@@ -64,10 +245,12 @@ namespace GSB {
       void SetColorLed(ColorLedID colorLedID, bool illuminated, uint8_t red, uint8_t green, uint8_t blue);
       void SetColorLed(ColorLedID colorLedID, bool illuminated, Color color);
       void ToggleColorLed(ColorLedID colorLedID);
+      Color GetColorLedColor(ColorLedID colorLedID) const;
 
     private:
       uint8_t m_index;
       internal::Status m_status{};
+      uint8_t m_changedGroups{0};
 
       //Inputs
       Button& GetButton(ButtonID buttonID);
@@ -76,23 +259,38 @@ namespace GSB {
       const Trigger& GetTrigger(TriggerID triggerID) const;
       Joystick& GetJoystick(JoystickID joystickID);
       const Joystick& GetJoystick(JoystickID joystickID) const;
+      internal::JoystickState& GetJoystickState(JoystickID joystickID);
+      const internal::JoystickState& GetJoystickState(JoystickID joystickID) const;
       Battery& GetBattery(BatteryID batteryID);
       const Battery& GetBattery(BatteryID batteryID) const;
       Sensor& GetSensor(SensorID sensorID);
       const Sensor& GetSensor(SensorID sensorID) const;
+      const Axis* FindAxis(InputGroup group, uint8_t input, uint8_t axis) const;
+      void SetAxisFilters(InputGroup group, uint8_t input, uint8_t emaShift, bool median);
+      int16_t Calibrate(InputGroup group, uint8_t input, uint8_t axis, int16_t raw);
 
-      void (*m_buttonOnPress)(uint8_t gamepadIndex, ButtonID buttonID);
-      void (*m_buttonOnRelease)(uint8_t gamepadIndex, ButtonID buttonID);
-      void (*m_triggerOnChange)(uint8_t gamepadIndex, TriggerID triggerID, int16_t value);
-      void (*m_joystickOnChange)(uint8_t gamepadIndex, JoystickID joystickID, int16_t valueX, int16_t valueY);
-      void (*m_batteryOnChange)(uint8_t gamepadIndex, BatteryID batteryID, uint8_t value);
-      void (*m_sensorOnChange)(uint8_t gamepadIndex, SensorID sensorID, int16_t valueX, int16_t valueY, int16_t valueZ);
+      void NotifyButton(ButtonID buttonID, bool pressed);
+      // Brings the virtual buttons in mask (over VirtualButtons::buttonIDs) in line with AxisButtons
+      void SyncVirtualButtons(uint8_t mask);
+      void NotifyTrigger(TriggerID triggerID, int16_t value);
+      void NotifyJoystick(JoystickID joystickID, int16_t valueX, int16_t valueY);
+      // Change, polar and sector callbacks, inline or from the event queue
+      void DeliverJoystick(JoystickID joystickID, int16_t valueX, int16_t valueY);
+      void NotifyBattery(BatteryID batteryID, uint8_t value);
+      void NotifySensor(SensorID sensorID, int16_t valueX, int16_t valueY, int16_t valueZ);
+      bool QueueEvent(internal::EventType type, uint8_t id, int16_t value0, int16_t value1 = 0, int16_t value2 = 0);
+      template<typename Mask>
+      void ApplyButtonMask(const ButtonID* buttonIDs, uint8_t count, Mask current, Mask next);
 
-      Button m_buttons[ButtonCount() + 1];
-      Trigger m_triggers[TriggerCount() + 1];
-      Joystick m_joysticks[JoystickCount() + 1];
-      Battery m_batteries[BatteryCount() + 1];
-      Sensor m_sensors[SensorCount() + 1];
+      using Slots = internal::GamepadSlots<Profile>;
+      using JoystickStorage = internal::JoystickStates<Profile::JoystickCount()>;
+
+      // Stripped groups keep only the sentinel slot
+      Button m_buttons[Profile::ButtonCount() + 1];
+      Trigger m_triggers[Profile::TriggerCount() + 1];
+      Joystick m_joysticks[Profile::JoystickCount() + 1];
+      Battery m_batteries[Profile::BatteryCount() + 1];
+      Sensor m_sensors[Profile::SensorCount() + 1];
 
       //Outputs
       Rumble& GetRumble(RumbleID rumbleID);
@@ -102,13 +300,14 @@ namespace GSB {
       ColorLed& GetColorLed(ColorLedID colorLedID);
       const ColorLed& GetColorLed(ColorLedID colorLedID) const;
 
-      void (*m_rumbleOnChange)(uint8_t gamepadIndex, RumbleID rumbleID, uint8_t force, uint8_t duration);
-      void (*m_playerLedOnChange)(uint8_t gamepadIndex, PlayerLedID playerLedID, bool illuminated);
-      void (*m_colorLedOnChange)(uint8_t gamepadIndex, ColorLedID colorLedID, bool illuminated, uint8_t red, uint8_t green, uint8_t blue);
       void (*m_onDisconnect)(uint8_t gamepadIndex);
 
-      Rumble m_rumbles[RumbleCount() + 1];
-      PlayerLed m_playerLeds[PlayerLedCount() + 1];
-      ColorLed m_colorLeds[ColorLedCount() + 1];
+      Rumble m_rumbles[Profile::RumbleCount() + 1];
+      PlayerLed m_playerLeds[Profile::PlayerLedCount() + 1];
+      ColorLed m_colorLeds[Profile::ColorLedCount() + 1];
   };
-} // namespace GSB
\ No newline at end of file
+
+  using Gamepad = BasicGamepad<>;
+} // namespace GSB
+
+#include "Gamepad/Gamepad.tpp"
\ No newline at end of file
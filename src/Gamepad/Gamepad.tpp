@@ -0,0 +1,1136 @@
+// Template definitions for BasicGamepad; included at the bottom of Gamepad.h
+
+namespace GSB {
+  // ---------- ctor / callback setters ----------
+  template<typename Profile>
+  BasicGamepad<Profile>::BasicGamepad() noexcept
+    : BasicGamepad(0) {
+
+  }
+
+  template<typename Profile>
+  BasicGamepad<Profile>::BasicGamepad(uint8_t index) noexcept
+    : m_onDisconnect(nullptr),
+      m_index(index) {
+    m_status.gamepadIndex = m_index;
+    for (uint8_t i = 0; i < Profile::PlayerLedCount(); ++i) {
+      m_playerLeds[i].SetID(static_cast<PlayerLedID>(i));
+    }
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::Init(uint8_t index) noexcept {
+    m_index = index;
+    m_status.gamepadIndex = index;
+  }
+
+  template<typename Profile>
+  const internal::Status& BasicGamepad<Profile>::GetStatus() const noexcept {
+    return m_status;
+  }
+
+  template<typename Profile>
+  internal::Status& BasicGamepad<Profile>::GetStatus() noexcept {
+    return m_status;
+  }
+
+  template<typename Profile>
+  uint8_t BasicGamepad<Profile>::GetChangedGroups() const noexcept {
+    return m_changedGroups;
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::ClearChangedGroups(uint8_t groups) noexcept {
+    m_changedGroups = static_cast<uint8_t>(m_changedGroups & ~groups);
+  }
+
+  template<typename Profile>
+  uint8_t BasicGamepad<Profile>::GetIndex() const noexcept {
+    return m_index;
+  }
+
+  // Inputs
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetButtonOnPress(void (*fxPtr)(uint8_t gamepadIndex, ButtonID buttonID)) {
+    Slots::ButtonOnPress::Set(fxPtr);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetButtonOnRelease(void (*fxPtr)(uint8_t gamepadIndex, ButtonID buttonID)) {
+    Slots::ButtonOnRelease::Set(fxPtr);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetButtonOnGesture(void (*fxPtr)(uint8_t gamepadIndex, ButtonID buttonID, ButtonGesture gesture)) {
+    Slots::ButtonOnGesture::Set(fxPtr);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetTriggerOnChange(void (*fxPtr)(uint8_t gamepadIndex, TriggerID triggerID, int16_t value)) {
+    Slots::TriggerOnChange::Set(fxPtr);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetJoystickOnChange(void (*fxPtr)(uint8_t gamepadIndex, JoystickID joystickID, int16_t valueX, int16_t valueY)) {
+    Slots::JoystickOnChange::Set(fxPtr);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetJoystickOnPolar(void (*fxPtr)(uint8_t gamepadIndex, JoystickID joystickID, uint16_t magnitude, uint16_t angle)) {
+    Slots::JoystickOnPolar::Set(fxPtr);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetJoystickOnSector(void (*fxPtr)(uint8_t gamepadIndex, JoystickID joystickID, uint8_t sector)) {
+    Slots::JoystickOnSector::Set(fxPtr);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetBatteryOnChange(void (*fxPtr)(uint8_t gamepadIndex, BatteryID batteryID, uint8_t value)) {
+    Slots::BatteryOnChange::Set(fxPtr);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetSensorOnChange(void (*fxPtr)(uint8_t gamepadIndex, SensorID sensorID, int16_t valueX, int16_t valueY, int16_t valueZ)) {
+    Slots::SensorOnChange::Set(fxPtr);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetOrientationOnChange(void (*fxPtr)(uint8_t gamepadIndex, int16_t roll, int16_t pitch, int16_t yaw)) {
+    Slots::OrientationOnChange::Set(fxPtr);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetSensorOnBatch(void (*fxPtr)(uint8_t gamepadIndex, const SensorSample& sample, unsigned long sampleMicros)) {
+    Slots::SensorOnBatch::Set(fxPtr);
+  }
+
+  // ---------- state update methods (only fire on real changes) ----------
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetButton(ButtonID buttonID, bool pressed) {
+    if (!Profile::IsValid(buttonID) || IsVirtual(buttonID)) {
+      return;
+    }
+    Button& button = GetButton(buttonID);
+    if (button.SetPressed(pressed)) {
+      m_status.Update(buttonID, pressed);
+      m_changedGroups = static_cast<uint8_t>(m_changedGroups | InputGroupMask(InputGroup::BUTTONS));
+      NotifyButton(buttonID, pressed);
+    }
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetTrigger(TriggerID triggerID, int16_t value) {
+    if (!Profile::IsValid(triggerID)) {
+      return;
+    }
+    Trigger& trigger = GetTrigger(triggerID);
+    if (trigger.SetValue(Calibrate(InputGroup::TRIGGERS, static_cast<uint8_t>(triggerID), 0, value))) {
+      m_status.Update(triggerID, trigger.GetValue());
+      m_changedGroups = static_cast<uint8_t>(m_changedGroups | InputGroupMask(InputGroup::TRIGGERS));
+      NotifyTrigger(triggerID, trigger.GetValue());
+      if (AxisButtons* axisButtons = Slots::AxisButtonsSlot::Get()) {
+        SyncVirtualButtons(axisButtons->OnTrigger(triggerID, trigger.GetValue()));
+      }
+    }
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetJoystick(JoystickID joystickID, int16_t valueX, int16_t valueY) {
+    if (!Profile::IsValid(joystickID)) {
+      return;
+    }
+    int16_t* inputs = GetJoystickState(joystickID).inputs;
+    inputs[0] = valueX;
+    inputs[1] = valueY;
+    // Calibrated and shaped values are what tolerance, status and callbacks see
+    const uint8_t input = static_cast<uint8_t>(joystickID);
+    valueX = Calibrate(InputGroup::JOYSTICKS, input, 0, valueX);
+    valueY = Calibrate(InputGroup::JOYSTICKS, input, 1, valueY);
+    GetJoystickState(joystickID).shaper.Shape(valueX, valueY);
+    Joystick& joystick = GetJoystick(joystickID);
+    const bool changedX = joystick.SetValueX(valueX);
+    const bool changedY = joystick.SetValueY(valueY);
+    if (changedX || changedY) {
+      m_status.Update(joystickID, joystick.GetValueX(), joystick.GetValueY());
+      m_changedGroups = static_cast<uint8_t>(m_changedGroups | InputGroupMask(InputGroup::JOYSTICKS));
+      NotifyJoystick(joystickID, joystick.GetValueX(), joystick.GetValueY());
+      if (AxisButtons* axisButtons = Slots::AxisButtonsSlot::Get()) {
+        SyncVirtualButtons(axisButtons->OnJoystick(joystickID, joystick.GetValueX(), joystick.GetValueY()));
+      }
+    }
+  }
+
+  // Shaping is two-dimensional, so single-axis updates reshape with the other axis's last raw value
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetJoystickX(JoystickID joystickID, int16_t value) {
+    if (!Profile::IsValid(joystickID)) {
+      return;
+    }
+    SetJoystick(joystickID, value, GetJoystickState(joystickID).inputs[1]);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetJoystickY(JoystickID joystickID, int16_t value) {
+    if (!Profile::IsValid(joystickID)) {
+      return;
+    }
+    SetJoystick(joystickID, GetJoystickState(joystickID).inputs[0], value);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetBattery(BatteryID batteryID, uint8_t value) {
+    if (!Profile::IsValid(batteryID)) {
+      return;
+    }
+    Battery& battery = GetBattery(batteryID);
+    if (battery.SetValue(value)) {
+      m_status.Update(batteryID, battery.GetValue());
+      m_changedGroups = static_cast<uint8_t>(m_changedGroups | InputGroupMask(InputGroup::BATTERY));
+      NotifyBattery(batteryID, battery.GetValue());
+    }
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetSensor(SensorID sensorID, int16_t valueX, int16_t valueY, int16_t valueZ) {
+    if (!Profile::IsValid(sensorID)) {
+      return;
+    }
+    Sensor& sensor = GetSensor(sensorID);
+    // Every axis must take its new value, so none may be skipped by short-circuiting
+    const bool changedX = sensor.SetValueX(valueX);
+    const bool changedY = sensor.SetValueY(valueY);
+    const bool changedZ = sensor.SetValueZ(valueZ);
+    if (changedX || changedY || changedZ) {
+      m_status.Update(sensorID, sensor.GetValueX(), sensor.GetValueY(), sensor.GetValueZ());
+      m_changedGroups = static_cast<uint8_t>(m_changedGroups | InputGroupMask(InputGroup::SENSORS));
+      NotifySensor(sensorID, sensor.GetValueX(), sensor.GetValueY(), sensor.GetValueZ());
+    }
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetSensorX(SensorID sensorID, int16_t value) {
+    if (!Profile::IsValid(sensorID)) {
+      return;
+    }
+    Sensor& sensor = GetSensor(sensorID);
+    if (sensor.SetValueX(value)) {
+      m_status.Update(sensorID, sensor.GetValueX(), sensor.GetValueY(), sensor.GetValueZ());
+      m_changedGroups = static_cast<uint8_t>(m_changedGroups | InputGroupMask(InputGroup::SENSORS));
+      NotifySensor(sensorID, sensor.GetValueX(), sensor.GetValueY(), sensor.GetValueZ());
+    }
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetSensorY(SensorID sensorID, int16_t value) {
+    if (!Profile::IsValid(sensorID)) {
+      return;
+    }
+    Sensor& sensor = GetSensor(sensorID);
+    if (sensor.SetValueY(value)) {
+      m_status.Update(sensorID, sensor.GetValueX(), sensor.GetValueY(), sensor.GetValueZ());
+      m_changedGroups = static_cast<uint8_t>(m_changedGroups | InputGroupMask(InputGroup::SENSORS));
+      NotifySensor(sensorID, sensor.GetValueX(), sensor.GetValueY(), sensor.GetValueZ());
+    }
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetSensorZ(SensorID sensorID, int16_t value) {
+    if (!Profile::IsValid(sensorID)) {
+      return;
+    }
+    Sensor& sensor = GetSensor(sensorID);
+    if (sensor.SetValueZ(value)) {
+      m_status.Update(sensorID, sensor.GetValueX(), sensor.GetValueY(), sensor.GetValueZ());
+      m_changedGroups = static_cast<uint8_t>(m_changedGroups | InputGroupMask(InputGroup::SENSORS));
+      NotifySensor(sensorID, sensor.GetValueX(), sensor.GetValueY(), sensor.GetValueZ());
+    }
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetStatus(const internal::Status& status, uint8_t groups) {
+    groups &= Profile::inputGroups;
+    if (groups & InputGroupMask(InputGroup::BUTTONS)) {
+      ApplyButtonMask(DPadButtons::buttonIDs, DPadButtons::Count(), m_status.dpadMask, status.dpadMask);
+      ApplyButtonMask(MainButtons::buttonIDs, MainButtons::Count(), m_status.mainButtonsMask, status.mainButtonsMask);
+      ApplyButtonMask(MiscButtons::buttonIDs, MiscButtons::Count(), m_status.miscButtonsMask, status.miscButtonsMask);
+    }
+    if (groups & InputGroupMask(InputGroup::JOYSTICKS)) {
+      static_assert(JoystickCount() == 2, "SetStatus reads joystick1 and joystick2");
+      const int16_t values[JoystickCount()][2] = {
+        {status.joystick1X, status.joystick1Y},
+        {status.joystick2X, status.joystick2Y},
+      };
+      for (uint8_t i = 0; i < JoystickCount(); ++i) {
+        const JoystickID joystickID = static_cast<JoystickID>(i);
+        if (Profile::IsValid(joystickID)) {
+          SetJoystick(joystickID, values[i][0], values[i][1]);
+        }
+      }
+    }
+    if (groups & InputGroupMask(InputGroup::TRIGGERS)) {
+      static_assert(TriggerCount() == 2, "SetStatus reads trigger1 and trigger2");
+      const int16_t values[TriggerCount()] = {status.trigger1, status.trigger2};
+      for (uint8_t i = 0; i < TriggerCount(); ++i) {
+        const TriggerID triggerID = static_cast<TriggerID>(i);
+        if (Profile::IsValid(triggerID)) {
+          SetTrigger(triggerID, values[i]);
+        }
+      }
+    }
+    if (groups & InputGroupMask(InputGroup::BATTERY)) {
+      static_assert(BatteryCount() == 1, "SetStatus reads battery1");
+      SetBattery(BatteryID::BATTERY_1, status.battery1);
+    }
+    if (groups & InputGroupMask(InputGroup::SENSORS)) {
+      static_assert(SensorCount() == 2, "SetStatus reads sensor1 and sensor2");
+      const int16_t values[SensorCount()][3] = {
+        {status.sensor1X, status.sensor1Y, status.sensor1Z},
+        {status.sensor2X, status.sensor2Y, status.sensor2Z},
+      };
+      for (uint8_t i = 0; i < SensorCount(); ++i) {
+        const SensorID sensorID = static_cast<SensorID>(i);
+        if (!Profile::IsValid(sensorID)) {
+          continue;
+        }
+        Sensor& sensor = GetSensor(sensorID);
+        const bool changedX = sensor.SetValueX(values[i][0]);
+        const bool changedY = sensor.SetValueY(values[i][1]);
+        const bool changedZ = sensor.SetValueZ(values[i][2]);
+        if (changedX || changedY || changedZ) {
+          m_status.Update(sensorID, sensor.GetValueX(), sensor.GetValueY(), sensor.GetValueZ());
+          m_changedGroups = static_cast<uint8_t>(m_changedGroups | InputGroupMask(InputGroup::SENSORS));
+          NotifySensor(sensorID, sensor.GetValueX(), sensor.GetValueY(), sensor.GetValueZ());
+        }
+      }
+    }
+  }
+
+  // Walks only the bits that differ between the current and next mask; bits past the
+  // table's count are not buttons and are ignored
+  template<typename Profile>
+  template<typename Mask>
+  void BasicGamepad<Profile>::ApplyButtonMask(const ButtonID* buttonIDs, uint8_t count, Mask current, Mask next) {
+    Mask flips = static_cast<Mask>(current ^ next);
+    for (uint8_t i = 0; i < count && flips != 0; ++i, flips = static_cast<Mask>(flips >> 1)) {
+      if (!(flips & 1u) || !Profile::IsValid(buttonIDs[i])) {
+        continue;
+      }
+      const bool pressed = ((next >> i) & 1u) != 0;
+      GetButton(buttonIDs[i]).SetPressed(pressed);
+      m_status.Update(buttonIDs[i], pressed);
+      m_changedGroups = static_cast<uint8_t>(m_changedGroups | InputGroupMask(InputGroup::BUTTONS));
+      NotifyButton(buttonIDs[i], pressed);
+    }
+  }
+
+  // ---------- tolerance update methods ----------
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetTriggerTolerance(TriggerID triggerID, uint16_t tolerance) {
+    if (!Profile::IsValid(triggerID)) {
+      return;
+    }
+    Trigger& trigger = GetTrigger(triggerID);
+    trigger.SetTolerance(tolerance);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetJoystickTolerance(JoystickID joystickID, uint16_t toleranceX, uint16_t toleranceY) {
+    if (!Profile::IsValid(joystickID)) {
+      return;
+    }
+    SetJoystickToleranceX(joystickID, toleranceX);
+    SetJoystickToleranceY(joystickID, toleranceY);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetJoystickToleranceX(JoystickID joystickID, uint16_t tolerance) {
+    if (!Profile::IsValid(joystickID)) {
+      return;
+    }
+    Joystick& joystick = GetJoystick(joystickID);
+    joystick.SetToleranceX(tolerance);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetJoystickToleranceY(JoystickID joystickID, uint16_t tolerance) {
+    if (!Profile::IsValid(joystickID)) {
+      return;
+    }
+    Joystick& joystick = GetJoystick(joystickID);
+    joystick.SetToleranceY(tolerance);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetBatteryTolerance(BatteryID batteryID, uint8_t tolerance) {
+    if (!Profile::IsValid(batteryID)) {
+      return;
+    }
+    Battery& battery = GetBattery(batteryID);
+    battery.SetTolerance(tolerance);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetSensorTolerance(SensorID sensorID, uint16_t toleranceX, uint16_t toleranceY, uint16_t toleranceZ) {
+    if (!Profile::IsValid(sensorID)) {
+      return;
+    }
+    SetSensorToleranceX(sensorID, toleranceX);
+    SetSensorToleranceY(sensorID, toleranceY);
+    SetSensorToleranceZ(sensorID, toleranceZ);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetSensorToleranceX(SensorID sensorID, uint16_t tolerance) {
+    if (!Profile::IsValid(sensorID)) {
+      return;
+    }
+    Sensor& sensor = GetSensor(sensorID);
+    sensor.SetToleranceX(tolerance);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetSensorToleranceY(SensorID sensorID, uint16_t tolerance) {
+    if (!Profile::IsValid(sensorID)) {
+      return;
+    }
+    Sensor& sensor = GetSensor(sensorID);
+    sensor.SetToleranceY(tolerance);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetSensorToleranceZ(SensorID sensorID, uint16_t tolerance) {
+    if (!Profile::IsValid(sensorID)) {
+      return;
+    }
+    Sensor& sensor = GetSensor(sensorID);
+    sensor.SetToleranceZ(tolerance);
+  }
+
+  template<typename Profile>
+  uint16_t BasicGamepad<Profile>::GetTolerance(InputGroup group, uint8_t input, uint8_t axis) const {
+    if (group == InputGroup::BATTERY) {
+      const BatteryID batteryID = static_cast<BatteryID>(input);
+      return (axis == 0 && Profile::IsValid(batteryID)) ? GetBattery(batteryID).GetTolerance() : 0;
+    }
+    const Axis* found = FindAxis(group, input, axis);
+    return found ? found->GetTolerance() : 0;
+  }
+
+  template<typename Profile>
+  uint16_t BasicGamepad<Profile>::GetDeadzone(InputGroup group, uint8_t input, uint8_t axis) const {
+    const Axis* found = FindAxis(group, input, axis);
+    return found ? found->GetDeadzone() : 0;
+  }
+
+  template<typename Profile>
+  bool BasicGamepad<Profile>::SetFilter(InputGroup group, uint8_t input, uint8_t axis, uint16_t tolerance, uint16_t deadzone) {
+    if (group == InputGroup::BATTERY) {
+      const BatteryID batteryID = static_cast<BatteryID>(input);
+      if (axis != 0 || !Profile::IsValid(batteryID)) {
+        return false;
+      }
+      GetBattery(batteryID).SetTolerance(static_cast<uint8_t>(tolerance > 255 ? 255 : tolerance));
+      return true;
+    }
+    Axis* found = const_cast<Axis*>(static_cast<const BasicGamepad*>(this)->FindAxis(group, input, axis));
+    if (!found) {
+      return false;
+    }
+    found->SetTolerance(tolerance);
+    found->SetDeadzone(deadzone);
+    return true;
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetTriggerFilter(TriggerID triggerID, uint8_t emaShift, bool median) {
+    SetAxisFilters(InputGroup::TRIGGERS, static_cast<uint8_t>(triggerID), emaShift, median);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetJoystickFilter(JoystickID joystickID, uint8_t emaShift, bool median) {
+    SetAxisFilters(InputGroup::JOYSTICKS, static_cast<uint8_t>(joystickID), emaShift, median);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetSensorFilter(SensorID sensorID, uint8_t emaShift, bool median) {
+    SetAxisFilters(InputGroup::SENSORS, static_cast<uint8_t>(sensorID), emaShift, median);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetAxisFilters(InputGroup group, uint8_t input, uint8_t emaShift, bool median) {
+    for (uint8_t axis = 0; axis < 3; ++axis) {
+      Axis* found = const_cast<Axis*>(static_cast<const BasicGamepad*>(this)->FindAxis(group, input, axis));
+      if (found) {
+        found->SetFilter(emaShift, median);
+      }
+    }
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetCalibration(Calibration* calibration) {
+    Slots::CalibrationSlot::Set(calibration);
+  }
+
+  template<typename Profile>
+  Calibration* BasicGamepad<Profile>::GetCalibration() const {
+    return Slots::CalibrationSlot::Get();
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetCalibrationSession(CalibrationSession* session) {
+    Slots::CalibrationSessionSlot::Set(session);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::ApplyCalibrationTolerances() {
+    const Calibration* calibration = Slots::CalibrationSlot::Get();
+    if (!calibration || !calibration->IsEnabled()) {
+      return;
+    }
+    for (uint8_t input = 0; input < JoystickCount(); ++input) {
+      SetFilter(InputGroup::JOYSTICKS, input, 0, calibration->NoiseTolerance(Calibration::AxisIndex(InputGroup::JOYSTICKS, input, 0)), GetDeadzone(InputGroup::JOYSTICKS, input, 0));
+      SetFilter(InputGroup::JOYSTICKS, input, 1, calibration->NoiseTolerance(Calibration::AxisIndex(InputGroup::JOYSTICKS, input, 1)), GetDeadzone(InputGroup::JOYSTICKS, input, 1));
+    }
+    for (uint8_t input = 0; input < TriggerCount(); ++input) {
+      SetFilter(InputGroup::TRIGGERS, input, 0, calibration->NoiseTolerance(Calibration::AxisIndex(InputGroup::TRIGGERS, input, 0)), GetDeadzone(InputGroup::TRIGGERS, input, 0));
+    }
+  }
+
+  template<typename Profile>
+  int16_t BasicGamepad<Profile>::Calibrate(InputGroup group, uint8_t input, uint8_t axis, int16_t raw) {
+    Calibration* calibration = Slots::CalibrationSlot::Get();
+    CalibrationSession* session = Slots::CalibrationSessionSlot::Get();
+    if (!calibration && !session) {
+      return raw;
+    }
+    const uint8_t index = Calibration::AxisIndex(group, input, axis);
+    if (session) {
+      session->Sample(index, raw);
+    }
+    return calibration ? calibration->Apply(index, raw) : raw;
+  }
+
+  // nullptr when the group has no axes, or the input or axis is outside the profile
+  template<typename Profile>
+  const Axis* BasicGamepad<Profile>::FindAxis(InputGroup group, uint8_t input, uint8_t axis) const {
+    switch (group) {
+      case InputGroup::JOYSTICKS: {
+        const JoystickID joystickID = static_cast<JoystickID>(input);
+        if (!Profile::IsValid(joystickID) || axis > 1) {
+          return nullptr;
+        }
+        const Joystick& joystick = GetJoystick(joystickID);
+        return (axis == 0) ? &joystick.GetXAxis() : &joystick.GetYAxis();
+      }
+      case InputGroup::TRIGGERS: {
+        const TriggerID triggerID = static_cast<TriggerID>(input);
+        if (!Profile::IsValid(triggerID) || axis != 0) {
+          return nullptr;
+        }
+        return &GetTrigger(triggerID).GetAxis();
+      }
+      case InputGroup::SENSORS: {
+        const SensorID sensorID = static_cast<SensorID>(input);
+        if (!Profile::IsValid(sensorID) || axis > 2) {
+          return nullptr;
+        }
+        const Sensor& sensor = GetSensor(sensorID);
+        return (axis == 0) ? &sensor.GetXAxis() : (axis == 1) ? &sensor.GetYAxis() : &sensor.GetZAxis();
+      }
+      default: {
+        return nullptr;
+      }
+    }
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetJoystickShape(JoystickID joystickID, const JoystickShape& shape) {
+    if (!Profile::IsValid(joystickID)) {
+      return;
+    }
+    GetJoystickState(joystickID).shaper.SetShape(shape);
+  }
+
+  template<typename Profile>
+  const JoystickShape& BasicGamepad<Profile>::GetJoystickShape(JoystickID joystickID) const {
+    return GetJoystickState(joystickID).shaper.GetShape();
+  }
+
+  // ---------- polar ----------
+  template<typename Profile>
+  PolarValue BasicGamepad<Profile>::GetJoystickPolar(JoystickID joystickID) const {
+    if (!Profile::IsValid(joystickID)) {
+      return PolarValue{};
+    }
+    const Joystick& joystick = GetJoystick(joystickID);
+    return JoystickPolar::FromCartesian(joystick.GetValueX(), joystick.GetValueY());
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetJoystickSectors(JoystickID joystickID, uint8_t count, uint16_t minimumMagnitude) {
+    if (!Profile::IsValid(joystickID)) {
+      return;
+    }
+    JoystickSectors& sectors = GetJoystickState(joystickID).sectors;
+    sectors.Configure(count, minimumMagnitude);
+    sectors.Update(GetJoystickPolar(joystickID));
+  }
+
+  template<typename Profile>
+  uint8_t BasicGamepad<Profile>::GetJoystickSector(JoystickID joystickID) const {
+    return GetJoystickState(joystickID).sectors.GetSector();
+  }
+
+  // ---------- event queue ----------
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetEventQueue(internal::EventQueue* eventQueue) {
+    Slots::EventQueueSlot::Set(eventQueue);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::DispatchEvent(const internal::Event& event) {
+    switch (event.type) {
+      case internal::EventType::BUTTON_PRESS: {
+        if (Slots::ButtonOnPress::Get()) {
+          Slots::ButtonOnPress::Get()(m_index, static_cast<ButtonID>(event.id));
+        }
+        break;
+      }
+      case internal::EventType::BUTTON_RELEASE: {
+        if (Slots::ButtonOnRelease::Get()) {
+          Slots::ButtonOnRelease::Get()(m_index, static_cast<ButtonID>(event.id));
+        }
+        break;
+      }
+      case internal::EventType::TRIGGER: {
+        if (Slots::TriggerOnChange::Get()) {
+          Slots::TriggerOnChange::Get()(m_index, static_cast<TriggerID>(event.id), event.values[0]);
+        }
+        break;
+      }
+      case internal::EventType::JOYSTICK: {
+        DeliverJoystick(static_cast<JoystickID>(event.id), event.values[0], event.values[1]);
+        break;
+      }
+      case internal::EventType::BATTERY: {
+        if (Slots::BatteryOnChange::Get()) {
+          Slots::BatteryOnChange::Get()(m_index, static_cast<BatteryID>(event.id), static_cast<uint8_t>(event.values[0]));
+        }
+        break;
+      }
+      case internal::EventType::SENSOR: {
+        if (Slots::SensorOnChange::Get()) {
+          Slots::SensorOnChange::Get()(m_index, static_cast<SensorID>(event.id), event.values[0], event.values[1], event.values[2]);
+        }
+        break;
+      }
+      case internal::EventType::BUTTON_GESTURE: {
+        if (Slots::ButtonOnGesture::Get()) {
+          Slots::ButtonOnGesture::Get()(m_index, static_cast<ButtonID>(event.id), static_cast<ButtonGesture>(event.values[0]));
+        }
+        break;
+      }
+      case internal::EventType::ORIENTATION: {
+        if (Slots::OrientationOnChange::Get()) {
+          Slots::OrientationOnChange::Get()(m_index, event.values[0], event.values[1], event.values[2]);
+        }
+        break;
+      }
+      case internal::EventType::SENSOR_BATCH: {
+        // The link holds the sample and delivers it with NotifySensorBatch
+        break;
+      }
+      case internal::EventType::COMBO: {
+        // A recognizer detached since the combo was queued drops it
+        if (const ComboRecognizer* recognizer = Slots::ComboRecognizerSlot::Get()) {
+          recognizer->NotifyCombo(m_index, event.id);
+        }
+        break;
+      }
+    }
+  }
+
+  // ---------- button timing ----------
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetButtonTimers(internal::ButtonTimers* buttonTimers) {
+    Slots::ButtonTimersSlot::Set(buttonTimers);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetComboRecognizer(ComboRecognizer* recognizer) {
+    Slots::ComboRecognizerSlot::Set(recognizer);
+  }
+
+  // ---------- axis buttons ----------
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetAxisButtons(AxisButtons* axisButtons) {
+    Slots::AxisButtonsSlot::Set(axisButtons);
+    SyncVirtualButtons(static_cast<uint8_t>((1u << VirtualButtons::Count()) - 1u));
+  }
+
+  template<typename Profile>
+  AxisButtons* BasicGamepad<Profile>::GetAxisButtons() const {
+    return Slots::AxisButtonsSlot::Get();
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SyncVirtualButtons(uint8_t mask) {
+    const AxisButtons* axisButtons = Slots::AxisButtonsSlot::Get();
+    for (uint8_t i = 0; mask != 0; ++i, mask = static_cast<uint8_t>(mask >> 1)) {
+      const ButtonID buttonID = VirtualButtons::buttonIDs[i];
+      if (!(mask & 1u) || !Profile::IsValid(buttonID)) {
+        continue;
+      }
+      const bool pressed = axisButtons && axisButtons->IsPressed(buttonID);
+      // Not part of the status frame, so m_status and the changed groups are left alone
+      if (GetButton(buttonID).SetPressed(pressed)) {
+        NotifyButton(buttonID, pressed);
+      }
+    }
+  }
+
+  // ---------- input history ----------
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetInputHistory(InputHistory* history) {
+    Slots::InputHistorySlot::Set(history);
+  }
+
+  template<typename Profile>
+  InputHistory* BasicGamepad<Profile>::GetInputHistory() const {
+    return Slots::InputHistorySlot::Get();
+  }
+
+  // ---------- orientation ----------
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetImuFusion(ImuFusion* fusion) {
+    Slots::ImuFusionSlot::Set(fusion);
+    if (fusion) {
+      fusion->Reset();
+    }
+  }
+
+  template<typename Profile>
+  ImuFusion* BasicGamepad<Profile>::GetImuFusion() const {
+    return Slots::ImuFusionSlot::Get();
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::UpdateOrientation(unsigned long nowMicros) {
+    ImuFusion* fusion = Slots::ImuFusionSlot::Get();
+    if (!fusion) {
+      return;
+    }
+    const Sensor& gyroscope = GetSensor(SensorID::SENSOR_1);
+    const Sensor& accelerometer = GetSensor(SensorID::SENSOR_2);
+    const int16_t gyro[3] = {gyroscope.GetValueX(), gyroscope.GetValueY(), gyroscope.GetValueZ()};
+    const int16_t accel[3] = {accelerometer.GetValueX(), accelerometer.GetValueY(), accelerometer.GetValueZ()};
+    if (!fusion->Update(gyro, accel, nowMicros) || !Slots::OrientationOnChange::Get()) {
+      return;
+    }
+    // Queued like a sensor value: a newer orientation replaces one not yet dispatched
+    const int16_t roll = fusion->GetRoll();
+    const int16_t pitch = fusion->GetPitch();
+    const int16_t yaw = fusion->GetYaw();
+    if (!QueueEvent(internal::EventType::ORIENTATION, 0, roll, pitch, yaw)) {
+      Slots::OrientationOnChange::Get()(m_index, roll, pitch, yaw);
+    }
+  }
+
+  // ---------- pin mapping ----------
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetPinMap(PinMap* pinMap) {
+    Slots::PinMapSlot::Set(pinMap);
+  }
+
+  template<typename Profile>
+  PinMap* BasicGamepad<Profile>::GetPinMap() const {
+    return Slots::PinMapSlot::Get();
+  }
+
+  // ---------- rules ----------
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetRuleVm(RuleVm* ruleVm) {
+    Slots::RuleVmSlot::Set(ruleVm);
+  }
+
+  template<typename Profile>
+  RuleVm* BasicGamepad<Profile>::GetRuleVm() const {
+    return Slots::RuleVmSlot::Get();
+  }
+
+  // ---------- interpolation ----------
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetAxisInterpolator(AxisInterpolator* interpolator) {
+    Slots::AxisInterpolatorSlot::Set(interpolator);
+  }
+
+  template<typename Profile>
+  AxisInterpolator* BasicGamepad<Profile>::GetAxisInterpolator() const {
+    return Slots::AxisInterpolatorSlot::Get();
+  }
+
+  // ---------- sensor batches ----------
+  template<typename Profile>
+  void BasicGamepad<Profile>::ApplySensorSample(const SensorSample& sample, unsigned long sampleMicros) {
+    if (!Profile::Has(InputGroup::SENSORS)) {
+      return;
+    }
+    for (uint8_t i = 0; i < SensorCount(); ++i) {
+      SetSensor(static_cast<SensorID>(i), sample.values[i][0], sample.values[i][1], sample.values[i][2]);
+    }
+    UpdateOrientation(sampleMicros);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::NotifySensorBatch(const SensorSample& sample, unsigned long sampleMicros) {
+    if (Slots::SensorOnBatch::Get()) {
+      Slots::SensorOnBatch::Get()(m_index, sample, sampleMicros);
+    }
+  }
+
+  template<typename Profile>
+  bool BasicGamepad<Profile>::HasSensorOnBatch() const {
+    return Slots::SensorOnBatch::Get() != nullptr;
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::NotifyButtonGesture(ButtonID buttonID, ButtonGesture gesture) {
+    if (!Slots::ButtonOnGesture::Get()) {
+      return;
+    }
+    if (QueueEvent(internal::EventType::BUTTON_GESTURE, static_cast<uint8_t>(buttonID), static_cast<int16_t>(gesture))) {
+      return;
+    }
+    Slots::ButtonOnGesture::Get()(m_index, buttonID, gesture);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::NotifyButton(ButtonID buttonID, bool pressed) {
+    // Edges of untracked buttons cost one lookup in the (small) timer table
+    internal::ButtonTimers* buttonTimers = Slots::ButtonTimersSlot::Get();
+    const ButtonGesture gesture = buttonTimers ? buttonTimers->OnButton(m_index, buttonID, pressed, millis()) : ButtonGesture::COUNT;
+    if (pressed ? Slots::ButtonOnPress::Get() : Slots::ButtonOnRelease::Get()) {
+      const internal::EventType type = pressed ? internal::EventType::BUTTON_PRESS : internal::EventType::BUTTON_RELEASE;
+      if (!QueueEvent(type, static_cast<uint8_t>(buttonID), 0)) {
+        if (pressed) {
+          Slots::ButtonOnPress::Get()(m_index, buttonID);
+        } else {
+          Slots::ButtonOnRelease::Get()(m_index, buttonID);
+        }
+      }
+    }
+    if (IsValid(gesture)) {
+      NotifyButtonGesture(buttonID, gesture);
+    }
+    if (ComboRecognizer* recognizer = Slots::ComboRecognizerSlot::Get()) {
+      uint8_t matches[ComboMaxMatches()];
+      const uint8_t count = recognizer->OnButton(m_index, buttonID, pressed, millis(), matches);
+      for (uint8_t i = 0; i < count; ++i) {
+        if (!QueueEvent(internal::EventType::COMBO, matches[i], 0)) {
+          recognizer->NotifyCombo(m_index, matches[i]);
+        }
+      }
+    }
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::NotifyTrigger(TriggerID triggerID, int16_t value) {
+    if (!Slots::TriggerOnChange::Get()) {
+      return;
+    }
+    if (QueueEvent(internal::EventType::TRIGGER, static_cast<uint8_t>(triggerID), value)) {
+      return;
+    }
+    Slots::TriggerOnChange::Get()(m_index, triggerID, value);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::NotifyJoystick(JoystickID joystickID, int16_t valueX, int16_t valueY) {
+    if (!Slots::JoystickOnChange::Get() && !Slots::JoystickOnPolar::Get() && GetJoystickState(joystickID).sectors.GetCount() == 0) {
+      return;
+    }
+    if (QueueEvent(internal::EventType::JOYSTICK, static_cast<uint8_t>(joystickID), valueX, valueY)) {
+      return;
+    }
+    DeliverJoystick(joystickID, valueX, valueY);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::DeliverJoystick(JoystickID joystickID, int16_t valueX, int16_t valueY) {
+    if (Slots::JoystickOnChange::Get()) {
+      Slots::JoystickOnChange::Get()(m_index, joystickID, valueX, valueY);
+    }
+    JoystickSectors& sectors = GetJoystickState(joystickID).sectors;
+    if (!Slots::JoystickOnPolar::Get() && sectors.GetCount() == 0) {
+      return;
+    }
+    const PolarValue polar = JoystickPolar::FromCartesian(valueX, valueY);
+    if (Slots::JoystickOnPolar::Get()) {
+      Slots::JoystickOnPolar::Get()(m_index, joystickID, polar.magnitude, polar.angle);
+    }
+    if (sectors.Update(polar) && Slots::JoystickOnSector::Get()) {
+      Slots::JoystickOnSector::Get()(m_index, joystickID, sectors.GetSector());
+    }
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::NotifyBattery(BatteryID batteryID, uint8_t value) {
+    if (!Slots::BatteryOnChange::Get()) {
+      return;
+    }
+    if (QueueEvent(internal::EventType::BATTERY, static_cast<uint8_t>(batteryID), value)) {
+      return;
+    }
+    Slots::BatteryOnChange::Get()(m_index, batteryID, value);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::NotifySensor(SensorID sensorID, int16_t valueX, int16_t valueY, int16_t valueZ) {
+    if (!Slots::SensorOnChange::Get()) {
+      return;
+    }
+    if (QueueEvent(internal::EventType::SENSOR, static_cast<uint8_t>(sensorID), valueX, valueY, valueZ)) {
+      return;
+    }
+    Slots::SensorOnChange::Get()(m_index, sensorID, valueX, valueY, valueZ);
+  }
+
+  // Returns false when no queue is attached so the caller dispatches inline. With a queue,
+  // callbacks never run from here, even if the queue is full.
+  template<typename Profile>
+  bool BasicGamepad<Profile>::QueueEvent(internal::EventType type, uint8_t id, int16_t value0, int16_t value1, int16_t value2) {
+    internal::EventQueue* const eventQueue = Slots::EventQueueSlot::Get();
+    if (!eventQueue) {
+      return false;
+    }
+    internal::Event event;
+    event.type = type;
+    event.gamepadIndex = m_index;
+    event.id = id;
+    event.values[0] = value0;
+    event.values[1] = value1;
+    event.values[2] = value2;
+    eventQueue->Push(event);
+    return true;
+  }
+
+  // Outputs
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetRumbleOnChange(void (*fxPtr)(uint8_t gamepadIndex, RumbleID rumbleID, uint8_t force, uint8_t duration)) {
+    Slots::RumbleOnChange::Set(fxPtr);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetPlayerLedOnChange(void (*fxPtr)(uint8_t gamepadIndex, PlayerLedID playerLedID, bool illuminated)) {
+    Slots::PlayerLedOnChange::Set(fxPtr);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetColorLedOnChange(void (*fxPtr)(uint8_t gamepadIndex, ColorLedID colorLedID, bool illuminated, uint8_t red, uint8_t green, uint8_t blue)) {
+    Slots::ColorLedOnChange::Set(fxPtr);
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetOnDisconnect(void (*fxPtr)(uint8_t gamepadIndex)) {
+    m_onDisconnect = fxPtr;
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetRumble(RumbleID rumbleID, uint8_t force, uint8_t duration) {
+    if (!Profile::IsValid(rumbleID)) {
+      return;
+    }
+    Rumble& rumble = GetRumble(rumbleID);
+    rumble.Set(force, duration);
+    if (Slots::RumbleOnChange::Get()) {
+      Slots::RumbleOnChange::Get()(m_index, rumbleID, rumble.GetForce(), rumble.GetDuration());
+    }
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetPlayerLeds(uint8_t playerBitmask) {
+    for (uint8_t i = 0; i < Profile::PlayerLedCount(); ++i) {
+      PlayerLed& playerLed = m_playerLeds[i];
+      if (playerLed.SetPlayer(playerBitmask) && Slots::PlayerLedOnChange::Get()) {
+        Slots::PlayerLedOnChange::Get()(m_index, static_cast<PlayerLedID>(i), playerLed.GetIlluminated());
+      }
+    }
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetPlayerLed(PlayerLedID playerLedID, bool illuminated) {
+    if (!Profile::IsValid(playerLedID)) {
+      return;
+    }
+    PlayerLed& playerLed = GetPlayerLed(playerLedID);
+    if (playerLed.Set(illuminated)) {
+      if (Slots::PlayerLedOnChange::Get()) {
+        Slots::PlayerLedOnChange::Get()(m_index, playerLedID, playerLed.GetIlluminated());
+      }
+    }
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::TogglePlayerLed(PlayerLedID playerLedID) {
+    if (!Profile::IsValid(playerLedID)) {
+      return;
+    }
+    PlayerLed& playerLed = GetPlayerLed(playerLedID);
+    playerLed.Toggle();
+    if (Slots::PlayerLedOnChange::Get()) {
+      Slots::PlayerLedOnChange::Get()(m_index, playerLedID, playerLed.GetIlluminated());
+    }
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetColorLed(ColorLedID colorLedID, bool illuminated, uint8_t red, uint8_t green, uint8_t blue) {
+    if (!Profile::IsValid(colorLedID)) {
+      return;
+    }
+    ColorLed& colorLed = GetColorLed(colorLedID);
+    bool changed = colorLed.SetColor(red, green, blue);
+    changed |= colorLed.Set(illuminated);
+    if (changed) {
+      if (Slots::ColorLedOnChange::Get()) {
+        Color color = colorLed.GetColor();
+        Slots::ColorLedOnChange::Get()(m_index, colorLedID, colorLed.GetIlluminated(), color.red, color.green, color.blue);
+      }
+    }
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetColorLed(ColorLedID colorLedID, bool illuminated, Color color) {
+    if (!Profile::IsValid(colorLedID)) {
+      return;
+    }
+    ColorLed& colorLed = GetColorLed(colorLedID);
+    bool changed = colorLed.SetColor(color);
+    changed |= colorLed.Set(illuminated);
+    if (changed) {
+      if (Slots::ColorLedOnChange::Get()) {
+        color = colorLed.GetColor();
+        Slots::ColorLedOnChange::Get()(m_index, colorLedID, colorLed.GetIlluminated(), color.red, color.green, color.blue);
+      }
+    }
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::ToggleColorLed(ColorLedID colorLedID) {
+    if (!Profile::IsValid(colorLedID)) {
+      return;
+    }
+    ColorLed& colorLed = GetColorLed(colorLedID);
+    colorLed.Toggle();
+    if (Slots::ColorLedOnChange::Get()) {
+      Color color = colorLed.GetColor();
+      Slots::ColorLedOnChange::Get()(m_index, colorLedID, colorLed.GetIlluminated(), color.red, color.green, color.blue);
+    }
+  }
+
+  template<typename Profile>
+  Color BasicGamepad<Profile>::GetColorLedColor(ColorLedID colorLedID) const {
+    return GetColorLed(colorLedID).GetColor();
+  }
+
+  template<typename Profile>
+  void BasicGamepad<Profile>::SetDisconnect() {
+    if (m_onDisconnect) {
+      m_onDisconnect(m_index);
+    }
+  }
+
+
+  // ---------- private accessors (use per-enum Index helpers) ----------
+  // Inputs
+  template<typename Profile>
+  Button& BasicGamepad<Profile>::GetButton(ButtonID buttonID) {
+    return m_buttons[Profile::Index(buttonID)];
+  }
+
+  template<typename Profile>
+  const Button& BasicGamepad<Profile>::GetButton(ButtonID buttonID) const {
+    return m_buttons[Profile::Index(buttonID)];
+  }
+
+  template<typename Profile>
+  Trigger& BasicGamepad<Profile>::GetTrigger(TriggerID triggerID) {
+    return m_triggers[Profile::Index(triggerID)];
+  }
+
+  template<typename Profile>
+  const Trigger& BasicGamepad<Profile>::GetTrigger(TriggerID triggerID) const {
+    return m_triggers[Profile::Index(triggerID)];
+  }
+
+  template<typename Profile>
+  Joystick& BasicGamepad<Profile>::GetJoystick(JoystickID joystickID) {
+    return m_joysticks[Profile::Index(joystickID)];
+  }
+
+  template<typename Profile>
+  const Joystick& BasicGamepad<Profile>::GetJoystick(JoystickID joystickID) const {
+    return m_joysticks[Profile::Index(joystickID)];
+  }
+
+  template<typename Profile>
+  internal::JoystickState& BasicGamepad<Profile>::GetJoystickState(JoystickID joystickID) {
+    return JoystickStorage::At(Profile::Index(joystickID));
+  }
+
+  template<typename Profile>
+  const internal::JoystickState& BasicGamepad<Profile>::GetJoystickState(JoystickID joystickID) const {
+    return JoystickStorage::At(Profile::Index(joystickID));
+  }
+
+  template<typename Profile>
+  Battery& BasicGamepad<Profile>::GetBattery(BatteryID batteryID) {
+    return m_batteries[Profile::Index(batteryID)];
+  }
+  
+  template<typename Profile>
+  const Battery& BasicGamepad<Profile>::GetBattery(BatteryID batteryID) const {
+    return m_batteries[Profile::Index(batteryID)];
+  }
+
+  template<typename Profile>
+  Sensor& BasicGamepad<Profile>::GetSensor(SensorID sensorID) {
+    return m_sensors[Profile::Index(sensorID)];
+  }
+
+  template<typename Profile>
+  const Sensor& BasicGamepad<Profile>::GetSensor(SensorID sensorID) const {
+    return m_sensors[Profile::Index(sensorID)];
+  }
+
+  // Outputs
+  template<typename Profile>
+  Rumble& BasicGamepad<Profile>::GetRumble(RumbleID rumbleID) {
+    return m_rumbles[Profile::Index(rumbleID)];
+  }
+  
+  template<typename Profile>
+  const Rumble& BasicGamepad<Profile>::GetRumble(RumbleID rumbleID) const {
+    return m_rumbles[Profile::Index(rumbleID)];
+  }
+
+  template<typename Profile>
+  PlayerLed& BasicGamepad<Profile>::GetPlayerLed(PlayerLedID playerLedID) {
+    return m_playerLeds[Profile::Index(playerLedID)];
+  }
+
+  template<typename Profile>
+  const PlayerLed& BasicGamepad<Profile>::GetPlayerLed(PlayerLedID playerLedID) const {
+    return m_playerLeds[Profile::Index(playerLedID)];
+  }
+
+  template<typename Profile>
+  ColorLed& BasicGamepad<Profile>::GetColorLed(ColorLedID colorLedID) {
+    return m_colorLeds[Profile::Index(colorLedID)];
+  }
+
+  template<typename Profile>
+  const ColorLed& BasicGamepad<Profile>::GetColorLed(ColorLedID colorLedID) const {
+    return m_colorLeds[Profile::Index(colorLedID)];
+  }
+} // namespace GSB
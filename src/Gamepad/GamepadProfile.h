@@ -0,0 +1,157 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Gamepad/InputIDs.h"
+#include "Gamepad/OutputIDs.h"
+
+namespace GSB {
+  // Compile-time capability set for a gamepad.
+  // Groups left out of a profile keep only a sentinel slot in BasicGamepad (their
+  // callbacks and per-stick state take none), never appear in status frames and have
+  // their commands rejected, so RAM, flash and frame size all shrink together.
+  // The status frame carries the input group mask on the wire.
+  template<uint8_t InputGroups, uint8_t OutputGroups>
+  struct GamepadProfile {
+    static constexpr uint8_t inputGroups = InputGroups & AllInputGroupsMask();
+    static constexpr uint8_t outputGroups = OutputGroups & AllOutputGroupsMask();
+
+    static constexpr bool Has(InputGroup group) noexcept {
+      return (inputGroups & InputGroupMask(group)) != 0;
+    }
+
+    static constexpr bool Has(OutputGroup group) noexcept {
+      return (outputGroups & OutputGroupMask(group)) != 0;
+    }
+
+    // Per-profile counts; 0 for a stripped group
+    static constexpr uint8_t ButtonCount() noexcept {
+      return Has(InputGroup::BUTTONS) ? GSB::ButtonCount() : 0;
+    }
+
+    static constexpr uint8_t TriggerCount() noexcept {
+      return Has(InputGroup::TRIGGERS) ? GSB::TriggerCount() : 0;
+    }
+
+    static constexpr uint8_t JoystickCount() noexcept {
+      return Has(InputGroup::JOYSTICKS) ? GSB::JoystickCount() : 0;
+    }
+
+    static constexpr uint8_t BatteryCount() noexcept {
+      return Has(InputGroup::BATTERY) ? GSB::BatteryCount() : 0;
+    }
+
+    static constexpr uint8_t SensorCount() noexcept {
+      return Has(InputGroup::SENSORS) ? GSB::SensorCount() : 0;
+    }
+
+    static constexpr uint8_t RumbleCount() noexcept {
+      return Has(OutputGroup::RUMBLE) ? GSB::RumbleCount() : 0;
+    }
+
+    static constexpr uint8_t PlayerLedCount() noexcept {
+      return Has(OutputGroup::PLAYER_LEDS) ? GSB::PlayerLedCount() : 0;
+    }
+
+    static constexpr uint8_t ColorLedCount() noexcept {
+      return Has(OutputGroup::COLOR_LEDS) ? GSB::ColorLedCount() : 0;
+    }
+
+    // Valid only when the ID exists and its group is in the profile
+    static constexpr bool IsValid(ButtonID id) noexcept {
+      return static_cast<uint8_t>(id) < ButtonCount();
+    }
+
+    static constexpr bool IsValid(TriggerID id) noexcept {
+      return static_cast<uint8_t>(id) < TriggerCount();
+    }
+
+    static constexpr bool IsValid(JoystickID id) noexcept {
+      return static_cast<uint8_t>(id) < JoystickCount();
+    }
+
+    static constexpr bool IsValid(BatteryID id) noexcept {
+      return static_cast<uint8_t>(id) < BatteryCount();
+    }
+
+    static constexpr bool IsValid(SensorID id) noexcept {
+      return static_cast<uint8_t>(id) < SensorCount();
+    }
+
+    static constexpr bool IsValid(RumbleID id) noexcept {
+      return static_cast<uint8_t>(id) < RumbleCount();
+    }
+
+    static constexpr bool IsValid(PlayerLedID id) noexcept {
+      return static_cast<uint8_t>(id) < PlayerLedCount();
+    }
+
+    static constexpr bool IsValid(ColorLedID id) noexcept {
+      return static_cast<uint8_t>(id) < ColorLedCount();
+    }
+
+    // Storage index; invalid IDs map to the trailing sentinel slot
+    static constexpr uint8_t Index(ButtonID id) noexcept {
+      return IsValid(id) ? static_cast<uint8_t>(id) : ButtonCount();
+    }
+
+    static constexpr uint8_t Index(TriggerID id) noexcept {
+      return IsValid(id) ? static_cast<uint8_t>(id) : TriggerCount();
+    }
+
+    static constexpr uint8_t Index(JoystickID id) noexcept {
+      return IsValid(id) ? static_cast<uint8_t>(id) : JoystickCount();
+    }
+
+    static constexpr uint8_t Index(BatteryID id) noexcept {
+      return IsValid(id) ? static_cast<uint8_t>(id) : BatteryCount();
+    }
+
+    static constexpr uint8_t Index(SensorID id) noexcept {
+      return IsValid(id) ? static_cast<uint8_t>(id) : SensorCount();
+    }
+
+    static constexpr uint8_t Index(RumbleID id) noexcept {
+      return IsValid(id) ? static_cast<uint8_t>(id) : RumbleCount();
+    }
+
+    static constexpr uint8_t Index(PlayerLedID id) noexcept {
+      return IsValid(id) ? static_cast<uint8_t>(id) : PlayerLedCount();
+    }
+
+    static constexpr uint8_t Index(ColorLedID id) noexcept {
+      return IsValid(id) ? static_cast<uint8_t>(id) : ColorLedCount();
+    }
+  };
+
+  using FullProfile = GamepadProfile<AllInputGroupsMask(), AllOutputGroupsMask()>;
+
+  namespace internal {
+    // Callback or attached-feature pointer that compiles away when its groups are stripped.
+    // An empty data member still takes a byte, so BasicGamepad inherits its slots and the
+    // empty base optimization drops the disabled ones; Tag keeps equal slot types distinct.
+    template<typename Pointer, bool Enabled, typename Tag>
+    class PointerSlot {
+      public:
+        void Set(Pointer pointer) noexcept {
+          m_pointer = pointer;
+        }
+
+        Pointer Get() const noexcept {
+          return m_pointer;
+        }
+
+      private:
+        Pointer m_pointer{nullptr};
+    };
+
+    template<typename Pointer, typename Tag>
+    class PointerSlot<Pointer, false, Tag> {
+      public:
+        void Set(Pointer) noexcept {}
+
+        constexpr Pointer Get() const noexcept {
+          return nullptr;
+        }
+    };
+  } // namespace internal
+} // namespace GSB
@@ -0,0 +1,174 @@
+#include "Gamepad/ImuFusion.h"
+#include "Gamepad/JoystickPolar.h"
+
+namespace GSB {
+  namespace {
+    int16_t Clamp16(int32_t value) {
+      return static_cast<int16_t>((value > 32767) ? 32767 : (value < -32768) ? -32768 : value);
+    }
+  } // namespace
+
+  ImuFusion::ImuFusion() {
+    SetConfig(ImuFusionConfig{});
+  }
+
+  void ImuFusion::SetConfig(const ImuFusionConfig& config) {
+    m_config = config;
+    if (m_config.gyroFullScale == 0) {
+      m_config.gyroFullScale = 1;
+    }
+    if (m_config.gyroFullScale > 2000) {
+      m_config.gyroFullScale = 2000;
+    }
+    if (m_config.accelOneG <= 0) {
+      m_config.accelOneG = 1;
+    }
+    if (m_config.accelShift > 15) {
+      m_config.accelShift = 15;
+    }
+    if (m_config.biasShift > 15) {
+      m_config.biasShift = 15;
+    }
+    // Turn fraction (2^32 per turn) per raw count per microsecond, in Q16:
+    // fullScale / 32768 / 360 / 1e6 * 2^32 * 2^16 = fullScale * 2^33 / 3.6e8
+    m_rateScale = static_cast<uint32_t>((static_cast<uint64_t>(m_config.gyroFullScale) << 33) / 360000000ULL);
+    Reset();
+  }
+
+  const ImuFusionConfig& ImuFusion::GetConfig() const {
+    return m_config;
+  }
+
+  void ImuFusion::Reset() {
+    for (uint8_t i = 0; i < s_axisCount; ++i) {
+      m_angles[i] = 0;
+      m_reported[i] = 0;
+      m_bias[i] = 0;
+      m_previousGyro[i] = 0;
+    }
+    m_restCount = 0;
+    m_biasLearned = false;
+    m_seeded = false;
+  }
+
+  void ImuFusion::ResetYaw() {
+    m_angles[2] = 0;
+  }
+
+  bool ImuFusion::Update(const int16_t (&gyro)[3], const int16_t (&accel)[3], unsigned long nowMicros) {
+    // Gravity direction: roll from (Z, Y), then pitch from (|YZ|, -X), which also yields |a|
+    const PolarValue roll = JoystickPolar::FromCartesian(accel[2], accel[1]);
+    uint16_t side = roll.magnitude;
+    int32_t forward = -static_cast<int32_t>(accel[0]);
+    uint8_t halved = 0;
+    if (side > 32767 || forward > 32767) {
+      side = static_cast<uint16_t>(side >> 1);
+      forward >>= 1;
+      halved = 1;
+    }
+    const PolarValue pitch = JoystickPolar::FromCartesian(static_cast<int16_t>(side), static_cast<int16_t>(forward));
+    const int32_t magnitude = static_cast<int32_t>(pitch.magnitude) << halved;
+    const int32_t deviation = magnitude - m_config.accelOneG;
+    const bool steady = ((deviation < 0) ? -deviation : deviation) <= (m_config.accelOneG >> 2);
+
+    int16_t rates[s_axisCount];
+    for (uint8_t i = 0; i < s_axisCount; ++i) {
+      rates[i] = Clamp16(static_cast<int32_t>(gyro[i]) - ((m_bias[i] + 128) >> 8));
+    }
+    LearnBias(gyro, steady);
+
+    const unsigned long elapsed = nowMicros - m_lastMicros;
+    m_lastMicros = nowMicros;
+    if (!m_seeded) {
+      if (!steady) {
+        return false;
+      }
+      m_angles[0] = static_cast<uint32_t>(roll.angle) << 16;
+      m_angles[1] = static_cast<uint32_t>(pitch.angle) << 16;
+      m_seeded = true;
+    } else {
+      const uint16_t step = static_cast<uint16_t>((elapsed > s_maxStepMicros) ? s_maxStepMicros : elapsed);
+      for (uint8_t i = 0; i < s_axisCount; ++i) {
+        m_angles[i] += static_cast<uint32_t>(Integrate(rates[i], step));
+      }
+      if (steady) {
+        const uint16_t measured[2] = {roll.angle, pitch.angle};
+        for (uint8_t i = 0; i < 2; ++i) {
+          // Wrapping subtraction gives the shortest signed turn between the two estimates
+          const int32_t error = static_cast<int32_t>((static_cast<uint32_t>(measured[i]) << 16) - m_angles[i]);
+          m_angles[i] += static_cast<uint32_t>(error >> m_config.accelShift);
+        }
+      }
+    }
+
+    bool changed = false;
+    for (uint8_t i = 0; i < s_axisCount; ++i) {
+      const int16_t difference = static_cast<int16_t>(static_cast<int16_t>(m_angles[i] >> 16) - m_reported[i]);
+      const uint16_t distance = static_cast<uint16_t>((difference < 0) ? -static_cast<int32_t>(difference) : difference);
+      changed = changed || distance >= m_config.changeThreshold;
+    }
+    if (changed) {
+      for (uint8_t i = 0; i < s_axisCount; ++i) {
+        m_reported[i] = static_cast<int16_t>(m_angles[i] >> 16);
+      }
+    }
+    return changed;
+  }
+
+  int16_t ImuFusion::GetRoll() const {
+    return static_cast<int16_t>(m_angles[0] >> 16);
+  }
+
+  int16_t ImuFusion::GetPitch() const {
+    return static_cast<int16_t>(m_angles[1] >> 16);
+  }
+
+  int16_t ImuFusion::GetYaw() const {
+    return static_cast<int16_t>(m_angles[2] >> 16);
+  }
+
+  bool ImuFusion::IsAtRest() const {
+    return m_restCount >= m_config.restSamples;
+  }
+
+  int16_t ImuFusion::GetGyroBias(uint8_t axis) const {
+    return (axis < s_axisCount) ? Clamp16((m_bias[axis] + 128) >> 8) : 0;
+  }
+
+  // rate * elapsed fits 32 bits unsigned; the Q16 scale is applied to its high and low halves
+  int32_t ImuFusion::Integrate(int16_t rate, uint16_t elapsedMicros) const {
+    const bool negative = rate < 0;
+    const uint32_t magnitude = static_cast<uint32_t>(negative ? -static_cast<int32_t>(rate) : rate);
+    const uint32_t product = magnitude * elapsedMicros;
+    const uint32_t turn = (product >> 16) * m_rateScale + (((product & 0xFFFFUL) * m_rateScale) >> 16);
+    return negative ? -static_cast<int32_t>(turn) : static_cast<int32_t>(turn);
+  }
+
+  // Rest means little change between samples and, once a bias is known, little deviation
+  // from it; a steady turn only looks still by the first test. The first quiet window sets
+  // the bias outright (so an offset beyond restThreshold is still found), later ones blend
+  // in, and only after restSamples quiet samples in a row.
+  void ImuFusion::LearnBias(const int16_t (&gyro)[3], bool steady) {
+    bool resting = steady;
+    for (uint8_t i = 0; i < s_axisCount; ++i) {
+      const int32_t change = static_cast<int32_t>(gyro[i]) - m_previousGyro[i];
+      const int32_t deviation = static_cast<int32_t>(gyro[i]) - ((m_bias[i] + 128) >> 8);
+      resting = resting && ((change < 0) ? -change : change) <= m_config.restThreshold;
+      resting = resting && (!m_biasLearned || ((deviation < 0) ? -deviation : deviation) <= m_config.restThreshold);
+      m_previousGyro[i] = gyro[i];
+    }
+    if (!resting) {
+      m_restCount = 0;
+      return;
+    }
+    if (m_restCount < m_config.restSamples) {
+      ++m_restCount;
+      return;
+    }
+    for (uint8_t i = 0; i < s_axisCount; ++i) {
+      const int32_t sample = static_cast<int32_t>(gyro[i]) << 8;
+      m_bias[i] = m_biasLearned ? m_bias[i] + ((sample - m_bias[i]) >> m_config.biasShift) : sample;
+    }
+    m_biasLearned = true;
+  }
+} // namespace GSB
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <Arduino.h>
+
+namespace GSB {
+  // Raw units of the sender's IMU. SENSOR_1 is the gyroscope and SENSOR_2 the accelerometer;
+  // body axes are X = roll, Y = pitch, Z = yaw (remap on the sender if a controller differs).
+  struct ImuFusionConfig {
+    uint16_t gyroFullScale{2000};  // °/s at a raw gyro reading of 32768, at most 2000
+    int16_t accelOneG{8192};       // raw accelerometer reading for 1 g
+    uint8_t accelShift{6};         // each sample pulls roll and pitch 1/2^accelShift toward the accelerometer
+    uint16_t restThreshold{64};    // raw gyro change (and deviation from the bias) still counted as at rest
+    uint8_t restSamples{32};       // consecutive rest samples before the bias is learned
+    uint8_t biasShift{5};          // bias update weight 1/2^biasShift per rest sample
+    uint16_t changeThreshold{32};  // angle change (see ImuFusion) that counts as a change
+  };
+
+  // Complementary filter from gyroscope and accelerometer to orientation, integer only.
+  // Angles are Q15 binary angles: 32768 is 180°, so an int16_t wraps exactly once per turn.
+  // Gyro rates are integrated every sample with the time since the previous sample; roll and
+  // pitch are then pulled toward the gravity direction, but only while the accelerometer
+  // reads close to 1 g so shakes do not tilt the estimate. Yaw has no absolute reference
+  // and is gyro-only, which is why the gyro bias is re-learned whenever the pad rests.
+  // Owned by the caller and attached per gamepad.
+  class ImuFusion {
+    public:
+      ImuFusion();
+
+      void SetConfig(const ImuFusionConfig& config);
+      const ImuFusionConfig& GetConfig() const;
+      // Forgets orientation and bias; the next accelerometer sample seeds roll and pitch
+      void Reset();
+      void ResetYaw();
+
+      // One gyro and accelerometer sample; returns true when an angle moved by at least
+      // changeThreshold since the last time it returned true
+      bool Update(const int16_t (&gyro)[3], const int16_t (&accel)[3], unsigned long nowMicros);
+
+      int16_t GetRoll() const;
+      int16_t GetPitch() const;
+      int16_t GetYaw() const;
+      bool IsAtRest() const;
+      // Learned gyro bias in raw units
+      int16_t GetGyroBias(uint8_t axis) const;
+
+      static constexpr int32_t ToCentidegrees(int16_t angle) noexcept {
+        return (static_cast<int32_t>(angle) * 18000L) / 32768L;
+      }
+
+    private:
+      static constexpr uint8_t s_axisCount = 3;
+      // Integration steps are capped so raw rate times elapsed micros fits in 32 bits
+      static constexpr unsigned long s_maxStepMicros = 65535;
+
+      int32_t Integrate(int16_t rate, uint16_t elapsedMicros) const;
+      void LearnBias(const int16_t (&gyro)[3], bool steady);
+
+      ImuFusionConfig m_config{};
+      uint32_t m_rateScale{0};
+      // Full turn = 2^32, so the sums wrap like the angles they hold
+      uint32_t m_angles[s_axisCount]{};
+      int16_t m_reported[s_axisCount]{};
+      int32_t m_bias[s_axisCount]{}; // Q8
+      int16_t m_previousGyro[s_axisCount]{};
+      unsigned long m_lastMicros{0};
+      uint8_t m_restCount{0};
+      bool m_biasLearned{false};
+      bool m_seeded{false};
+  };
+} // namespace GSB
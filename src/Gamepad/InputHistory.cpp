@@ -0,0 +1,217 @@
+#include "Gamepad/InputHistory.h"
+
+namespace GSB {
+  InputHistory::InputHistory(uint8_t* buffer, size_t capacity)
+    : m_buffer(buffer),
+      m_capacity(capacity) {
+
+  }
+
+  bool InputHistory::Record(const internal::Status& status, uint8_t groups, unsigned long nowMicros) {
+    groups &= AllInputGroupsMask();
+    // The first record is a full snapshot of what the frame carried
+    const uint8_t changed = (m_count == 0) ? groups : static_cast<uint8_t>(internal::Status::ChangedGroups(m_last, status) & groups);
+    if (changed == 0) {
+      return false;
+    }
+    // Batched sensor samples are stamped in the past; never let the timeline run backwards
+    if (m_count != 0 && static_cast<long>(nowMicros - m_newestMicros) < 0) {
+      nowMicros = m_newestMicros;
+    }
+    uint8_t record[MaxRecordLength()];
+    size_t length = 0;
+    unsigned long delta = (m_count == 0) ? 0 : nowMicros - m_newestMicros;
+    do {
+      const uint8_t low = static_cast<uint8_t>(delta & 0x7F);
+      delta >>= 7;
+      record[length++] = (delta != 0) ? static_cast<uint8_t>(low | 0x80) : low;
+    } while (delta != 0);
+    record[length++] = changed;
+    const size_t packedLength = internal::StatusLayout::PackedLength(changed);
+    internal::BitWriter writer(&record[length], packedLength);
+    internal::StatusLayout::WritePacked(status, writer, changed);
+    length += packedLength;
+
+    // Track what was stored (saturated to the packed widths), not the raw frame
+    internal::BitReader reader(&record[length - packedLength], packedLength);
+    internal::StatusLayout::ReadPacked(m_last, reader, changed);
+
+    while (m_capacity - m_used < length) {
+      DropOldest();
+    }
+    size_t position = m_head + m_used;
+    for (size_t i = 0; i < length; ++i, ++position) {
+      m_buffer[(position >= m_capacity) ? position - m_capacity : position] = record[i];
+    }
+    m_used += length;
+    if (m_count == 0) {
+      m_oldestMicros = nowMicros;
+    }
+    ++m_count;
+    m_newestMicros = nowMicros;
+    return true;
+  }
+
+  void InputHistory::Clear() {
+    m_head = 0;
+    m_used = 0;
+    m_count = 0;
+    m_base = internal::Status{};
+    m_last = internal::Status{};
+  }
+
+  uint16_t InputHistory::GetCount() const {
+    return m_count;
+  }
+
+  size_t InputHistory::GetUsedBytes() const {
+    return m_used;
+  }
+
+  size_t InputHistory::GetCapacity() const {
+    return m_capacity;
+  }
+
+  unsigned long InputHistory::GetOldestMicros() const {
+    return m_oldestMicros;
+  }
+
+  unsigned long InputHistory::GetNewestMicros() const {
+    return m_newestMicros;
+  }
+
+  uint16_t InputHistory::Visit(unsigned long fromMicros, unsigned long toMicros, Visitor visitor, void* context) const {
+    if (!visitor) {
+      return 0;
+    }
+    internal::Status status = m_base;
+    unsigned long timeMicros = m_oldestMicros;
+    uint16_t visited = 0;
+    size_t offset = 0;
+    for (uint16_t i = 0; i < m_count; ++i) {
+      uint8_t record[MaxRecordLength()];
+      unsigned long delta = 0;
+      const size_t length = ReadRecord(offset, record, delta);
+      offset += length;
+      // The oldest record's delta points at a record that has been dropped
+      if (i != 0) {
+        timeMicros += delta;
+      }
+      const uint8_t changed = ApplyRecord(record, length, status);
+      // Unsigned differences keep the window correct across micros() rollover
+      if (timeMicros - fromMicros <= toMicros - fromMicros) {
+        visitor(context, timeMicros, status, changed);
+        ++visited;
+      }
+    }
+    return visited;
+  }
+
+  uint16_t InputHistory::Dump(Print& out, unsigned long fromMicros, unsigned long toMicros) const {
+    return Visit(fromMicros, toMicros, &PrintRecord, &out);
+  }
+
+  uint8_t InputHistory::At(size_t offset) const {
+    const size_t position = m_head + offset;
+    return m_buffer[(position >= m_capacity) ? position - m_capacity : position];
+  }
+
+  size_t InputHistory::ReadRecord(size_t offset, uint8_t* record, unsigned long& delta) const {
+    size_t length = 0;
+    uint8_t shift = 0;
+    delta = 0;
+    uint8_t byte = 0;
+    do {
+      byte = At(offset + length);
+      record[length++] = byte;
+      delta |= static_cast<unsigned long>(byte & 0x7F) << shift;
+      shift = static_cast<uint8_t>(shift + 7);
+    } while ((byte & 0x80) != 0 && length < 5);
+    const uint8_t changed = At(offset + length);
+    record[length++] = changed;
+    const size_t packedLength = internal::StatusLayout::PackedLength(changed);
+    for (size_t i = 0; i < packedLength; ++i, ++length) {
+      record[length] = At(offset + length);
+    }
+    return length;
+  }
+
+  uint8_t InputHistory::ApplyRecord(const uint8_t* record, size_t length, internal::Status& status) {
+    size_t offset = 0;
+    while ((record[offset] & 0x80) != 0) {
+      ++offset;
+    }
+    ++offset;
+    const uint8_t changed = record[offset++];
+    internal::BitReader reader(&record[offset], length - offset);
+    internal::StatusLayout::ReadPacked(status, reader, changed);
+    return changed;
+  }
+
+  void InputHistory::DropOldest() {
+    uint8_t record[MaxRecordLength()];
+    unsigned long delta = 0;
+    const size_t length = ReadRecord(0, record, delta);
+    ApplyRecord(record, length, m_base);
+    m_head += length;
+    if (m_head >= m_capacity) {
+      m_head -= m_capacity;
+    }
+    m_used -= length;
+    --m_count;
+    if (m_count != 0) {
+      ReadRecord(0, record, delta);
+      m_oldestMicros += delta;
+    }
+  }
+
+  void InputHistory::PrintRecord(void* context, unsigned long timeMicros, const internal::Status& status, uint8_t changedGroups) {
+    Print& out = *static_cast<Print*>(context);
+    out.print(timeMicros);
+    out.print(F(" g=0x"));
+    out.print(changedGroups, HEX);
+    if (changedGroups & InputGroupMask(InputGroup::BUTTONS)) {
+      out.print(F(" dpad=0x"));
+      out.print(status.dpadMask, HEX);
+      out.print(F(" main=0x"));
+      out.print(status.mainButtonsMask, HEX);
+      out.print(F(" misc=0x"));
+      out.print(status.miscButtonsMask, HEX);
+    }
+    if (changedGroups & InputGroupMask(InputGroup::JOYSTICKS)) {
+      out.print(F(" j1="));
+      out.print(status.joystick1X);
+      out.print(',');
+      out.print(status.joystick1Y);
+      out.print(F(" j2="));
+      out.print(status.joystick2X);
+      out.print(',');
+      out.print(status.joystick2Y);
+    }
+    if (changedGroups & InputGroupMask(InputGroup::TRIGGERS)) {
+      out.print(F(" t="));
+      out.print(status.trigger1);
+      out.print(',');
+      out.print(status.trigger2);
+    }
+    if (changedGroups & InputGroupMask(InputGroup::BATTERY)) {
+      out.print(F(" bat="));
+      out.print(status.battery1);
+    }
+    if (changedGroups & InputGroupMask(InputGroup::SENSORS)) {
+      out.print(F(" s1="));
+      out.print(status.sensor1X);
+      out.print(',');
+      out.print(status.sensor1Y);
+      out.print(',');
+      out.print(status.sensor1Z);
+      out.print(F(" s2="));
+      out.print(status.sensor2X);
+      out.print(',');
+      out.print(status.sensor2Y);
+      out.print(',');
+      out.print(status.sensor2Z);
+    }
+    out.println();
+  }
+} // namespace GSB
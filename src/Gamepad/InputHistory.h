@@ -0,0 +1,74 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Gamepad/InputIDs.h"
+#include "internal/Status.h"
+
+namespace GSB {
+  // Byte ring of applied status frames for one gamepad. Each record holds the time since
+  // the previous record (varint micros), the mask of input groups that changed and those
+  // groups' values bit-packed at their wire widths; frames that change nothing are not
+  // stored. The oldest records are dropped to make room, folding their values into a base
+  // snapshot so every record can still be read back as a full status.
+  // Storage is supplied by BasicInputHistory so the link can hold a size-agnostic pointer.
+  class InputHistory {
+    public:
+      using Visitor = void (*)(void* context, unsigned long timeMicros, const internal::Status& status, uint8_t changedGroups);
+
+      static constexpr size_t MaxRecordLength() noexcept {
+        return 5 + 1 + internal::StatusLayout::PackedLength(AllInputGroupsMask());
+      }
+
+      // Stores the groups of status that differ from the last record; false when nothing changed
+      bool Record(const internal::Status& status, uint8_t groups, unsigned long nowMicros);
+      void Clear();
+
+      uint16_t GetCount() const;
+      size_t GetUsedBytes() const;
+      size_t GetCapacity() const;
+      unsigned long GetOldestMicros() const;
+      unsigned long GetNewestMicros() const;
+
+      // Calls visitor, oldest first, for each record timed within [fromMicros, toMicros] with
+      // the full status as of that record; returns the number of records visited
+      uint16_t Visit(unsigned long fromMicros, unsigned long toMicros, Visitor visitor, void* context) const;
+      // One line per record in the window: time, changed group mask, then the changed values
+      uint16_t Dump(Print& out, unsigned long fromMicros, unsigned long toMicros) const;
+
+    protected:
+      InputHistory(uint8_t* buffer, size_t capacity);
+      InputHistory(const InputHistory&) = delete;
+      InputHistory& operator=(const InputHistory&) = delete;
+
+    private:
+      uint8_t At(size_t offset) const;
+      // Copies the record at offset (from the oldest byte) out of the ring; returns its length
+      size_t ReadRecord(size_t offset, uint8_t* record, unsigned long& delta) const;
+      // Applies a record's values to status and returns its changed group mask
+      static uint8_t ApplyRecord(const uint8_t* record, size_t length, internal::Status& status);
+      void DropOldest();
+      static void PrintRecord(void* context, unsigned long timeMicros, const internal::Status& status, uint8_t changedGroups);
+
+      uint8_t* m_buffer;
+      size_t m_capacity;
+      size_t m_head{0};
+      size_t m_used{0};
+      uint16_t m_count{0};
+      unsigned long m_oldestMicros{0};
+      unsigned long m_newestMicros{0};
+      internal::Status m_base{};
+      internal::Status m_last{};
+  };
+
+  template<size_t Bytes>
+  class BasicInputHistory : public InputHistory {
+    public:
+      BasicInputHistory() : InputHistory(m_storage, Bytes) {
+
+      }
+
+    private:
+      static_assert(Bytes >= InputHistory::MaxRecordLength(), "Input history must hold at least one full record");
+      uint8_t m_storage[Bytes]{};
+  };
+} // namespace GSB
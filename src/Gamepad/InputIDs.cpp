@@ -5,4 +5,5 @@ namespace GSB {
   constexpr ButtonID DPadButtons::buttonIDs[];
   constexpr ButtonID MainButtons::buttonIDs[];
   constexpr ButtonID MiscButtons::buttonIDs[];
+  constexpr ButtonID VirtualButtons::buttonIDs[];
 } // namespace GSB
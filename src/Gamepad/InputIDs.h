@@ -27,6 +27,15 @@ namespace GSB {
         MISC_2,
         MISC_3,
         MISC_4,
+        // Driven by AxisButtons from stick and trigger values; never sent on the wire
+        VIRTUAL_1,
+        VIRTUAL_2,
+        VIRTUAL_3,
+        VIRTUAL_4,
+        VIRTUAL_5,
+        VIRTUAL_6,
+        VIRTUAL_7,
+        VIRTUAL_8,
         COUNT
     };
 
@@ -53,7 +62,33 @@ namespace GSB {
         COUNT
     };
 
+    // Input groups a gamepad profile can include; also the status frame group bits
+    enum class InputGroup : uint8_t {
+        BUTTONS,
+        JOYSTICKS,
+        TRIGGERS,
+        BATTERY,
+        SENSORS,
+        COUNT
+    };
+
     // Small helpers for sizing/indices
+    constexpr uint8_t InputGroupCount() noexcept {
+        return static_cast<uint8_t>(InputGroup::COUNT);
+    }
+
+    constexpr bool IsValid(InputGroup group) noexcept {
+        return group < InputGroup::COUNT;
+    }
+
+    constexpr uint8_t InputGroupMask(InputGroup group) noexcept {
+        return IsValid(group) ? static_cast<uint8_t>(1u << static_cast<uint8_t>(group)) : 0;
+    }
+
+    constexpr uint8_t AllInputGroupsMask() noexcept {
+        return static_cast<uint8_t>((1u << InputGroupCount()) - 1u);
+    }
+
     constexpr uint8_t ButtonCount() noexcept {
         return static_cast<uint8_t>(ButtonID::COUNT);
     }
@@ -66,6 +101,10 @@ namespace GSB {
         return id < ButtonID::COUNT;
     }
 
+    constexpr bool IsVirtual(ButtonID id) noexcept {
+        return id >= ButtonID::VIRTUAL_1 && id < ButtonID::COUNT;
+    }
+
     constexpr uint8_t TriggerCount() noexcept {
         return static_cast<uint8_t>(TriggerID::COUNT);
     }
@@ -197,4 +236,32 @@ namespace GSB {
             return false;
         }
     };
+
+    struct VirtualButtons {
+        static constexpr ButtonID buttonIDs[] = {
+            ButtonID::VIRTUAL_1,
+            ButtonID::VIRTUAL_2,
+            ButtonID::VIRTUAL_3,
+            ButtonID::VIRTUAL_4,
+            ButtonID::VIRTUAL_5,
+            ButtonID::VIRTUAL_6,
+            ButtonID::VIRTUAL_7,
+            ButtonID::VIRTUAL_8,
+        };
+
+        static constexpr uint8_t Count() noexcept {
+            return static_cast<uint8_t>(sizeof(buttonIDs) / sizeof(buttonIDs[0]));
+        }
+
+        static bool FindButton(ButtonID buttonID, uint8_t& index) noexcept {
+            const uint8_t count = Count();
+            for (uint8_t i = 0; i < count; ++i) {
+                if (buttonIDs[i] == buttonID) {
+                    index = i;
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
 } // namespace GSB
\ No newline at end of file
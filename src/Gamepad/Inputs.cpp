@@ -25,7 +25,43 @@ namespace GSB {
     m_tolerance = tolerance;
   }
 
+  uint16_t Axis::GetTolerance() const {
+    return m_tolerance;
+  }
+
+  void Axis::SetDeadzone(uint16_t deadzone) {
+    m_deadzone = deadzone;
+  }
+
+  uint16_t Axis::GetDeadzone() const {
+    return m_deadzone;
+  }
+
+  void Axis::SetFilter(uint8_t emaShift, bool median) {
+    if (emaShift > s_maxEmaShift) {
+      emaShift = s_maxEmaShift;
+    }
+    m_emaShift = emaShift;
+    m_median = median;
+    m_filterSamples = 0;
+  }
+
+  uint8_t Axis::GetEmaShift() const {
+    return m_emaShift;
+  }
+
+  bool Axis::GetMedianFilter() const {
+    return m_median;
+  }
+
   bool Axis::SetValue(int16_t value) {
+    value = Filter(value);
+    if (m_deadzone != 0) {
+      const int32_t magnitude = (value >= 0) ? static_cast<int32_t>(value) : -static_cast<int32_t>(value);
+      if (magnitude < static_cast<int32_t>(m_deadzone)) {
+        value = 0;
+      }
+    }
     if (value == m_value) {
       return false;
     }
@@ -42,6 +78,47 @@ namespace GSB {
     return m_value;
   }
 
+  int16_t Axis::Filter(int16_t value) {
+    if (!m_median && m_emaShift == 0) {
+      return value;
+    }
+    const bool primed = m_filterSamples != 0;
+    if (m_median) {
+      const int16_t raw = value;
+      if (m_filterSamples >= 2) {
+        value = MedianOfThree(m_history[0], m_history[1], raw);
+      }
+      m_history[0] = m_history[1];
+      m_history[1] = raw;
+    }
+    if (m_emaShift != 0) {
+      if (!primed) {
+        m_ema = static_cast<int32_t>(value) << m_emaShift;
+      } else {
+        m_ema += static_cast<int32_t>(value) - (m_ema >> m_emaShift);
+      }
+      // Round to nearest when dropping the fraction
+      value = static_cast<int16_t>((m_ema + (static_cast<int32_t>(1) << (m_emaShift - 1))) >> m_emaShift);
+    }
+    if (m_filterSamples < 2) {
+      ++m_filterSamples;
+    }
+    return value;
+  }
+
+  int16_t Axis::MedianOfThree(int16_t a, int16_t b, int16_t c) {
+    if (a > b) {
+      const int16_t swap = a;
+      a = b;
+      b = swap;
+    }
+    // With a <= b, c decides: below a -> a, above b -> b, otherwise c
+    if (c <= a) {
+      return a;
+    }
+    return (c < b) ? c : b;
+  }
+
   // ----- Trigger (1D axis + button) -----
   void Trigger::SetTolerance(uint16_t tolerance) {
     m_axis.SetTolerance(tolerance);
@@ -112,6 +189,10 @@ namespace GSB {
     m_tolerance = tolerance;
   }
 
+  uint8_t Battery::GetTolerance() const {
+    return m_tolerance;
+  }
+
   bool Battery::SetValue(uint8_t value) {
     if (value == m_value) {
       return false;
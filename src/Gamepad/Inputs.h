@@ -17,12 +17,34 @@ namespace GSB {
     public:
       Axis() = default;
       void SetTolerance(uint16_t tolerance);
+      uint16_t GetTolerance() const;
+      // Values with a magnitude below deadzone read as 0 (0 = off)
+      void SetDeadzone(uint16_t deadzone);
+      uint16_t GetDeadzone() const;
+      // Optional smoothing run on every sample before deadzone and tolerance:
+      // median of the last 3 samples (spike rejection), then an EMA with
+      // alpha = 1 / 2^emaShift (0 = off, max 7). Changing it restarts the filter.
+      void SetFilter(uint8_t emaShift, bool median);
+      uint8_t GetEmaShift() const;
+      bool GetMedianFilter() const;
       bool SetValue(int16_t value);
       int16_t GetValue() const;
 
     private:
+      int16_t Filter(int16_t value);
+      static int16_t MedianOfThree(int16_t a, int16_t b, int16_t c);
+
+      static constexpr uint8_t s_maxEmaShift = 7;
       uint16_t m_tolerance{1};
+      uint16_t m_deadzone{0};
       int16_t m_value{0};
+      uint8_t m_emaShift{0};
+      bool m_median{false};
+      // Samples seen since the filter was (re)started, saturating at 2
+      uint8_t m_filterSamples{0};
+      int16_t m_history[2]{};
+      // EMA state scaled by 2^emaShift to keep the fraction
+      int32_t m_ema{0};
   };
 
   class Trigger {
@@ -61,6 +83,7 @@ namespace GSB {
     public:
       Battery() = default;
       void SetTolerance(uint8_t tolerance);
+      uint8_t GetTolerance() const;
       bool SetValue(uint8_t value);
       uint8_t GetValue() const;
     
@@ -0,0 +1,88 @@
+#include "Gamepad/JoystickPolar.h"
+
+namespace GSB {
+  namespace {
+    // atan(2^-i) in binary angle units with 2 fraction bits
+    const uint16_t s_arctangents[JoystickPolar::Iterations()] = {
+      32768, 19344, 10221, 5188, 2604, 1303, 652, 326, 163, 81, 41, 20, 10, 5, 3, 1
+    };
+
+    // 1 / CORDIC gain (0.607253) in Q16
+    constexpr uint32_t s_inverseGain = 39797;
+    // Extra input bits so the last iterations still move small vectors; the full-scale
+    // diagonal times the gain (about 1.25e9) still fits in 32 bits
+    constexpr uint8_t s_inputShift = 14;
+  } // namespace
+
+  PolarValue JoystickPolar::FromCartesian(int16_t x, int16_t y) {
+    PolarValue polar;
+    if (x == 0 && y == 0) {
+      return polar;
+    }
+    int32_t rotatedX = static_cast<int32_t>(x) * (1L << s_inputShift);
+    int32_t rotatedY = static_cast<int32_t>(y) * (1L << s_inputShift);
+    // Vectoring converges within ±99°, so start the left half-plane from 180°
+    int32_t angle = 0;
+    if (rotatedX < 0) {
+      rotatedX = -rotatedX;
+      rotatedY = -rotatedY;
+      angle = 0x8000L << 2;
+    }
+    for (uint8_t i = 0; i < Iterations(); ++i) {
+      const int32_t stepX = rotatedX >> i;
+      const int32_t stepY = rotatedY >> i;
+      if (rotatedY > 0) {
+        rotatedX += stepY;
+        rotatedY -= stepX;
+        angle += s_arctangents[i];
+      } else {
+        rotatedX -= stepY;
+        rotatedY += stepX;
+        angle -= s_arctangents[i];
+      }
+    }
+    // rotatedX is the magnitude times the gain and 2^s_inputShift; the integer and fraction
+    // parts are scaled separately so the products stay in 32 bits
+    const uint32_t whole = static_cast<uint32_t>(rotatedX) >> s_inputShift;
+    const uint32_t fraction = static_cast<uint32_t>(rotatedX) & ((1UL << s_inputShift) - 1);
+    const uint32_t magnitude = (whole * s_inverseGain + ((fraction * s_inverseGain) >> s_inputShift) + (1UL << 15)) >> 16;
+    polar.magnitude = static_cast<uint16_t>((magnitude > 0xFFFF) ? 0xFFFF : magnitude);
+    polar.angle = static_cast<uint16_t>((angle + 2) >> 2);
+    return polar;
+  }
+
+  uint8_t JoystickPolar::Sector(uint16_t angle, uint8_t count) {
+    if (count == 0) {
+      return 0;
+    }
+    // Shift by half a sector so sector 0 straddles 0
+    const uint16_t shifted = static_cast<uint16_t>(angle + 0x8000U / count);
+    return static_cast<uint8_t>((static_cast<uint32_t>(shifted) * count) >> 16);
+  }
+
+  void JoystickSectors::Configure(uint8_t count, uint16_t minimumMagnitude) {
+    m_count = (count == 0xFF) ? static_cast<uint8_t>(0xFE) : count;
+    m_minimumMagnitude = minimumMagnitude;
+    m_sector = m_count;
+  }
+
+  uint8_t JoystickSectors::GetCount() const {
+    return m_count;
+  }
+
+  uint8_t JoystickSectors::GetSector() const {
+    return m_sector;
+  }
+
+  bool JoystickSectors::Update(const PolarValue& polar) {
+    if (m_count == 0) {
+      return false;
+    }
+    const uint8_t sector = (polar.magnitude < m_minimumMagnitude || polar.magnitude == 0) ? m_count : JoystickPolar::Sector(polar.angle, m_count);
+    if (sector == m_sector) {
+      return false;
+    }
+    m_sector = sector;
+    return true;
+  }
+} // namespace GSB
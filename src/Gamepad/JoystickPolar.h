@@ -0,0 +1,49 @@
+#pragma once
+
+#include <Arduino.h>
+
+namespace GSB {
+  // Angles are binary: a full turn is 65536, 0 points along +X and angles grow toward +Y
+  struct PolarValue {
+    uint16_t magnitude{0};
+    uint16_t angle{0};
+  };
+
+  // Integer stick magnitude and heading by CORDIC vectoring: the vector is rotated onto +X
+  // by shift-and-add steps of atan(2^-i), summing the rotation as it goes. One pass yields
+  // both values with no multiply in the loop, no divide and no float (tests/JoystickPolar
+  // checks it against double sqrt/atan2; the JoystickPolarBenchmark example measures cost).
+  class JoystickPolar {
+    public:
+      static constexpr uint8_t Iterations() noexcept {
+        return 16;
+      }
+
+      static constexpr uint16_t DegreesToAngle(uint16_t degrees) noexcept {
+        return static_cast<uint16_t>((static_cast<uint32_t>(degrees % 360) * 65536UL + 180) / 360);
+      }
+
+      // Magnitude within 1 unit and angle within 2 binary units (about 0.01°)
+      static PolarValue FromCartesian(int16_t x, int16_t y);
+      // Index of the one of count equal sectors containing angle; sector 0 is centered on +X
+      static uint8_t Sector(uint16_t angle, uint8_t count);
+  };
+
+  // Tracks which of count equal sectors a stick points into. The stick reads as centered
+  // (GetSector() == GetCount()) until its magnitude reaches minimumMagnitude.
+  class JoystickSectors {
+    public:
+      JoystickSectors() = default;
+      // count 0 turns tracking off
+      void Configure(uint8_t count, uint16_t minimumMagnitude);
+      uint8_t GetCount() const;
+      uint8_t GetSector() const;
+      // Returns true when the sector changed
+      bool Update(const PolarValue& polar);
+
+    private:
+      uint8_t m_count{0};
+      uint8_t m_sector{0};
+      uint16_t m_minimumMagnitude{0};
+  };
+} // namespace GSB
@@ -0,0 +1,129 @@
+#include "Gamepad/JoystickShaper.h"
+
+namespace GSB {
+  namespace {
+    // x^2 and x^3 sampled at 17 points over 0..1024
+    const uint16_t s_squareCurve[JoystickShape::CurvePoints()] = {
+      0, 4, 16, 36, 64, 100, 144, 196, 256, 324, 400, 484, 576, 676, 784, 900, 1024
+    };
+    const uint16_t s_cubeCurve[JoystickShape::CurvePoints()] = {
+      0, 0, 2, 7, 16, 31, 54, 86, 128, 182, 250, 333, 432, 549, 686, 844, 1024
+    };
+  } // namespace
+
+  void JoystickShaper::SetShape(const JoystickShape& shape) {
+    m_shape = shape;
+    if (m_shape.range > 32767) {
+      m_shape.range = 32767;
+    }
+    if (!IsValid(m_shape.curve) || (m_shape.curve == ResponseCurve::CUSTOM && !m_shape.customCurve)) {
+      m_shape.curve = ResponseCurve::LINEAR;
+    }
+    if (m_shape.antiDeadzone > m_shape.range) {
+      m_shape.antiDeadzone = m_shape.range;
+    }
+    const bool saturates = m_shape.saturation != 0 && m_shape.saturation < m_shape.range;
+    m_identity = m_shape.range == 0 || (m_shape.radialDeadzone == 0 && m_shape.axialDeadzone == 0 && m_shape.antiDeadzone == 0 && !saturates && m_shape.curve == ResponseCurve::LINEAR);
+  }
+
+  const JoystickShape& JoystickShaper::GetShape() const {
+    return m_shape;
+  }
+
+  void JoystickShaper::Shape(int16_t& x, int16_t& y) {
+    if (m_identity) {
+      return;
+    }
+    const int32_t range = m_shape.range;
+    const int32_t axialX = ApplyAxialDeadzone(x, m_shape.axialDeadzone, m_shape.range);
+    const int32_t axialY = ApplyAxialDeadzone(y, m_shape.axialDeadzone, m_shape.range);
+    const uint32_t squared = static_cast<uint32_t>(axialX * axialX) + static_cast<uint32_t>(axialY * axialY);
+    const uint16_t magnitude = SquareRoot(squared);
+    if (magnitude <= m_shape.radialDeadzone) {
+      x = 0;
+      y = 0;
+      return;
+    }
+
+    // Position between the deadzone and the saturation ring, 0..CurveScale()
+    const uint16_t outer = (m_shape.saturation != 0 && m_shape.saturation < m_shape.range) ? m_shape.saturation : m_shape.range;
+    uint32_t position = JoystickShape::CurveScale();
+    if (magnitude < outer && outer > m_shape.radialDeadzone) {
+      position = (static_cast<uint32_t>(magnitude - m_shape.radialDeadzone) * JoystickShape::CurveScale()) / (outer - m_shape.radialDeadzone);
+    }
+    position = ApplyCurve(static_cast<uint16_t>(position));
+    const int32_t output = m_shape.antiDeadzone + static_cast<int32_t>((position * static_cast<uint32_t>(range - m_shape.antiDeadzone)) / JoystickShape::CurveScale());
+
+    // Rescale the vector to the new magnitude, keeping its direction
+    int32_t shapedX = (axialX * output) / magnitude;
+    int32_t shapedY = (axialY * output) / magnitude;
+    shapedX = (shapedX > range) ? range : (shapedX < -range) ? -range : shapedX;
+    shapedY = (shapedY > range) ? range : (shapedY < -range) ? -range : shapedY;
+    x = static_cast<int16_t>(shapedX);
+    y = static_cast<int16_t>(shapedY);
+  }
+
+  // Bit-by-bit integer square root (floor); no multiply or divide
+  uint16_t JoystickShaper::SquareRoot(uint32_t value) {
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+    while (bit > value) {
+      bit >>= 2;
+    }
+    while (bit != 0) {
+      if (value >= root + bit) {
+        value -= root + bit;
+        root = (root >> 1) + bit;
+      } else {
+        root >>= 1;
+      }
+      bit >>= 2;
+    }
+    return static_cast<uint16_t>(root);
+  }
+
+  uint16_t JoystickShaper::ApplyCurve(uint16_t position) const {
+    const uint16_t* table = nullptr;
+    switch (m_shape.curve) {
+      case ResponseCurve::SQUARE: {
+        table = s_squareCurve;
+        break;
+      }
+      case ResponseCurve::CUBE: {
+        table = s_cubeCurve;
+        break;
+      }
+      case ResponseCurve::CUSTOM: {
+        table = m_shape.customCurve;
+        break;
+      }
+      default: {
+        return position;
+      }
+    }
+    // 16 segments of 64 steps each
+    const uint8_t index = static_cast<uint8_t>(position >> 6);
+    if (index >= JoystickShape::CurvePoints() - 1) {
+      return table[JoystickShape::CurvePoints() - 1];
+    }
+    const int32_t low = table[index];
+    const int32_t high = table[index + 1];
+    return static_cast<uint16_t>(low + (((high - low) * static_cast<int32_t>(position & 63u)) >> 6));
+  }
+
+  int16_t JoystickShaper::ApplyAxialDeadzone(int16_t value, uint16_t deadzone, uint16_t range) {
+    if (deadzone == 0) {
+      return value;
+    }
+    const int32_t magnitude = (value >= 0) ? static_cast<int32_t>(value) : -static_cast<int32_t>(value);
+    if (magnitude <= deadzone || deadzone >= range) {
+      return 0;
+    }
+    // Stretch what is left so the axis still reaches full scale
+    int32_t scaled = ((magnitude - deadzone) * static_cast<int32_t>(range)) / (static_cast<int32_t>(range) - deadzone);
+    if (scaled > 32767) {
+      scaled = 32767;
+    }
+    return static_cast<int16_t>((value >= 0) ? scaled : -scaled);
+  }
+} // namespace GSB
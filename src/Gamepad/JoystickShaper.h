@@ -0,0 +1,60 @@
+#pragma once
+
+#include <Arduino.h>
+
+namespace GSB {
+  // Response curve applied to the stick magnitude once it is outside the deadzone
+  enum class ResponseCurve : uint8_t {
+    LINEAR,
+    SQUARE, // finer control near center
+    CUBE,
+    CUSTOM, // JoystickShape::customCurve
+    COUNT
+  };
+
+  constexpr bool IsValid(ResponseCurve curve) noexcept {
+    return static_cast<uint8_t>(curve) < static_cast<uint8_t>(ResponseCurve::COUNT);
+  }
+
+  // All distances are in raw stick units. The default shape passes values through unchanged.
+  struct JoystickShape {
+    uint16_t range{512};          // full-scale magnitude of the raw and shaped values
+    uint16_t radialDeadzone{0};   // magnitudes up to this read as center
+    uint16_t axialDeadzone{0};    // per-axis band around 0, rescaled away before the radial stage
+    uint16_t antiDeadzone{0};     // smallest output magnitude once outside the radial deadzone
+    uint16_t saturation{0};       // magnitude that already reads as full scale (0 = range)
+    ResponseCurve curve{ResponseCurve::LINEAR};
+    // CUSTOM only: CurvePoints() values from 0 to CurveScale(), evenly spaced over the input
+    const uint16_t* customCurve{nullptr};
+
+    static constexpr uint8_t CurvePoints() noexcept {
+      return 17;
+    }
+
+    static constexpr uint16_t CurveScale() noexcept {
+      return 1024;
+    }
+  };
+
+  // Integer-only stick shaping: axial deadzone -> radial deadzone and saturation ->
+  // response curve (lookup table, linear interpolation) -> anti-deadzone. The direction
+  // of the stick is kept; only its magnitude is remapped.
+  class JoystickShaper {
+    public:
+      JoystickShaper() = default;
+      void SetShape(const JoystickShape& shape);
+      const JoystickShape& GetShape() const;
+
+      // Shapes (x, y) in place
+      void Shape(int16_t& x, int16_t& y);
+
+      static uint16_t SquareRoot(uint32_t value);
+
+    private:
+      uint16_t ApplyCurve(uint16_t position) const;
+      static int16_t ApplyAxialDeadzone(int16_t value, uint16_t deadzone, uint16_t range);
+
+      JoystickShape m_shape{};
+      bool m_identity{true};
+  };
+} // namespace GSB
@@ -20,7 +20,31 @@ namespace GSB {
         COUNT
     };
 
+    // Output groups a gamepad profile can include
+    enum class OutputGroup : uint8_t {
+        RUMBLE,
+        PLAYER_LEDS,
+        COLOR_LEDS,
+        COUNT
+    };
+
     // Small helpers for sizing/indices
+    constexpr uint8_t OutputGroupCount() noexcept {
+        return static_cast<uint8_t>(OutputGroup::COUNT);
+    }
+
+    constexpr bool IsValid(OutputGroup group) noexcept {
+        return group < OutputGroup::COUNT;
+    }
+
+    constexpr uint8_t OutputGroupMask(OutputGroup group) noexcept {
+        return IsValid(group) ? static_cast<uint8_t>(1u << static_cast<uint8_t>(group)) : 0;
+    }
+
+    constexpr uint8_t AllOutputGroupsMask() noexcept {
+        return static_cast<uint8_t>((1u << OutputGroupCount()) - 1u);
+    }
+
     constexpr uint8_t RumbleCount() {
         return static_cast<uint8_t>(RumbleID::COUNT);
     }
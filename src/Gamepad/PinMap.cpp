@@ -0,0 +1,188 @@
+#include "Gamepad/PinMap.h"
+
+namespace GSB {
+  // ---------- ArduinoPinWriter ----------
+  void ArduinoPinWriter::SetupPin(uint8_t pin, PinAction action) {
+    pinMode(pin, OUTPUT);
+    if (IsDigital(action)) {
+      // digitalWrite also detaches a PWM timer left on the pin; the port fast path does not
+      digitalWrite(pin, LOW);
+    }
+  }
+
+  void ArduinoPinWriter::WriteDigital(uint8_t pin, bool high) {
+#if defined(__AVR__)
+    // One read-modify-write of the output register instead of digitalWrite's lookups
+    const uint8_t port = digitalPinToPort(pin);
+    if (port == NOT_A_PIN) {
+      return;
+    }
+    volatile uint8_t* out = portOutputRegister(port);
+    const uint8_t bit = digitalPinToBitMask(pin);
+    const uint8_t oldSREG = SREG;
+    cli();
+    *out = high ? static_cast<uint8_t>(*out | bit) : static_cast<uint8_t>(*out & ~bit);
+    SREG = oldSREG;
+#else
+    digitalWrite(pin, high ? HIGH : LOW);
+#endif
+  }
+
+  void ArduinoPinWriter::WritePwm(uint8_t pin, uint8_t duty) {
+    analogWrite(pin, duty);
+  }
+
+  void ArduinoPinWriter::WriteServo(uint8_t, uint16_t) {
+
+  }
+
+  // ---------- PinMap ----------
+  PinMap::PinMap(PinState* states, uint8_t maxMappings)
+    : m_states(states),
+      m_maxMappings(maxMappings) {
+
+  }
+
+  bool PinMap::SetMappings(const PinMapping* mappings, uint8_t count, PinWriter& writer) {
+    m_mappings = nullptr;
+    m_count = 0;
+    m_writer = nullptr;
+    if (count > m_maxMappings || (count > 0 && !mappings)) {
+      return false;
+    }
+    for (uint8_t i = 0; i < count; ++i) {
+      if (!IsValid(mappings[i])) {
+        return false;
+      }
+    }
+    m_mappings = mappings;
+    m_count = count;
+    m_writer = &writer;
+    return true;
+  }
+
+  uint8_t PinMap::GetCount() const {
+    return m_count;
+  }
+
+  void PinMap::Begin(const internal::Status& status, unsigned long nowMillis) {
+    for (uint8_t i = 0; i < m_count; ++i) {
+      m_writer->SetupPin(m_mappings[i].pin, m_mappings[i].action);
+      m_states[i] = PinState{};
+      Evaluate(i, status, nowMillis, true);
+    }
+  }
+
+  void PinMap::Update(const internal::Status& status, uint8_t changedGroups, unsigned long nowMillis) {
+    if (changedGroups == 0) {
+      return;
+    }
+    for (uint8_t i = 0; i < m_count; ++i) {
+      if (changedGroups & InputGroupMask(m_mappings[i].group)) {
+        Evaluate(i, status, nowMillis, false);
+      }
+    }
+  }
+
+  void PinMap::Expire(unsigned long nowMillis) {
+    const uint16_t now = static_cast<uint16_t>(nowMillis);
+    for (uint8_t i = 0; i < m_count; ++i) {
+      const PinMapping& mapping = m_mappings[i];
+      PinState& state = m_states[i];
+      if (mapping.action == PinAction::MOMENTARY && state.active && static_cast<uint16_t>(now - state.pulseStart) >= mapping.pulseMillis) {
+        state.active = false;
+        state.output = 0;
+        WriteDigital(mapping, false);
+      }
+    }
+  }
+
+  // Clamps value into the input range, then maps it with rounding; all in unsigned 32-bit
+  uint16_t PinMap::Scale(const PinMapping& mapping, int16_t value) {
+    const int16_t low = (mapping.inMin < mapping.inMax) ? mapping.inMin : mapping.inMax;
+    const int16_t high = (mapping.inMin < mapping.inMax) ? mapping.inMax : mapping.inMin;
+    value = (value < low) ? low : (value > high) ? high : value;
+    const int32_t inSpan = static_cast<int32_t>(mapping.inMax) - mapping.inMin;
+    const int32_t offset = static_cast<int32_t>(value) - mapping.inMin;
+    const uint32_t inMagnitude = static_cast<uint32_t>((inSpan < 0) ? -inSpan : inSpan);
+    const uint32_t offsetMagnitude = static_cast<uint32_t>((offset < 0) ? -offset : offset);
+    const bool rising = mapping.outMax >= mapping.outMin;
+    const uint32_t outMagnitude = rising ? mapping.outMax - mapping.outMin : mapping.outMin - mapping.outMax;
+    const uint32_t step = (offsetMagnitude * outMagnitude + inMagnitude / 2) / inMagnitude;
+    return static_cast<uint16_t>(rising ? mapping.outMin + step : mapping.outMin - step);
+  }
+
+  bool PinMap::IsValid(const PinMapping& mapping) {
+    if (!GSB::IsValid(mapping.action)) {
+      return false;
+    }
+    if (IsDigital(mapping.action)) {
+      return mapping.group == InputGroup::BUTTONS && mapping.input < ButtonCount() && !IsVirtual(static_cast<ButtonID>(mapping.input));
+    }
+    if (mapping.inMin == mapping.inMax) {
+      return false;
+    }
+    if (mapping.action == PinAction::PWM && (mapping.outMin > UINT8_MAX || mapping.outMax > UINT8_MAX)) {
+      return false;
+    }
+    if (mapping.group == InputGroup::TRIGGERS) {
+      return mapping.input < TriggerCount() && mapping.axis == 0;
+    }
+    return mapping.group == InputGroup::JOYSTICKS && mapping.input < JoystickCount() && mapping.axis < 2;
+  }
+
+  void PinMap::Evaluate(uint8_t index, const internal::Status& status, unsigned long nowMillis, bool force) {
+    const PinMapping& mapping = m_mappings[index];
+    PinState& state = m_states[index];
+    if (IsDigital(mapping.action)) {
+      const int16_t pressed = status.IsPressed(static_cast<ButtonID>(mapping.input)) ? 1 : 0;
+      const bool edge = pressed != state.input;
+      state.input = pressed;
+      switch (mapping.action) {
+        case PinAction::SET: {
+          state.active = pressed != 0;
+          break;
+        }
+        case PinAction::TOGGLE: {
+          // A button held when the table is attached does not count as a press
+          if (edge && pressed && !force) {
+            state.active = !state.active;
+          }
+          break;
+        }
+        default: {
+          if (edge && pressed && !force) {
+            state.active = true;
+            state.pulseStart = static_cast<uint16_t>(nowMillis);
+          }
+          break;
+        }
+      }
+      const uint16_t output = state.active ? 1 : 0;
+      if (force || output != state.output) {
+        state.output = output;
+        WriteDigital(mapping, state.active);
+      }
+      return;
+    }
+    const int16_t value = status.GetValue(mapping.group, mapping.input, mapping.axis);
+    if (!force && value == state.input) {
+      return;
+    }
+    state.input = value;
+    const uint16_t output = Scale(mapping, value);
+    if (!force && output == state.output) {
+      return;
+    }
+    state.output = output;
+    if (mapping.action == PinAction::PWM) {
+      m_writer->WritePwm(mapping.pin, static_cast<uint8_t>(output));
+    } else {
+      m_writer->WriteServo(mapping.pin, output);
+    }
+  }
+
+  void PinMap::WriteDigital(const PinMapping& mapping, bool active) {
+    m_writer->WriteDigital(mapping.pin, active != mapping.activeLow);
+  }
+} // namespace GSB
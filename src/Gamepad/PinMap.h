@@ -0,0 +1,161 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Gamepad/InputIDs.h"
+#include "internal/Status.h"
+
+namespace GSB {
+  enum class PinAction : uint8_t {
+    SET,       // button: pin is active while the button is held
+    MOMENTARY, // button: each press drives the pin active for pulseMillis
+    TOGGLE,    // button: each press flips the pin
+    PWM,       // axis: value scaled to an analogWrite duty (0..255)
+    SERVO,     // axis: value scaled to a servo pulse width in microseconds
+    COUNT
+  };
+
+  constexpr bool IsValid(PinAction action) noexcept {
+    return action < PinAction::COUNT;
+  }
+
+  constexpr bool IsDigital(PinAction action) noexcept {
+    return action == PinAction::SET || action == PinAction::MOMENTARY || action == PinAction::TOGGLE;
+  }
+
+  // One entry of a pin table, best built with the factories, e.g.
+  //   const PinMapping pins[] = {
+  //     PinMapping::Button(Xbox::Buttons::A, 22),
+  //     PinMapping::Button(Xbox::Buttons::B, 23, PinAction::TOGGLE, true),
+  //     PinMapping::Pulse(Xbox::Buttons::X, 24, 250),
+  //     PinMapping::Pwm(Xbox::Triggers::RT, 5),
+  //     PinMapping::Servo(Xbox::Joysticks::LS, 0, 9),
+  //   };
+  // Axis entries scale [inMin, inMax] linearly onto [outMin, outMax]; either range may run
+  // backwards to invert, and values outside the input range are clamped.
+  struct PinMapping {
+    PinAction action;
+    InputGroup group; // BUTTONS for digital actions, TRIGGERS or JOYSTICKS for PWM/SERVO
+    uint8_t input;    // ButtonID, TriggerID or JoystickID
+    uint8_t axis;     // joysticks: X = 0, Y = 1
+    uint8_t pin;
+    bool activeLow;   // digital actions: drive LOW when active (e.g. relay boards)
+    uint16_t pulseMillis;
+    int16_t inMin;
+    int16_t inMax;
+    uint16_t outMin;
+    uint16_t outMax;
+
+    static constexpr PinMapping Button(ButtonID buttonID, uint8_t pin, PinAction action = PinAction::SET, bool activeLow = false) noexcept {
+      return Digital(buttonID, pin, action, activeLow, 0);
+    }
+
+    static constexpr PinMapping Pulse(ButtonID buttonID, uint8_t pin, uint16_t pulseMillis, bool activeLow = false) noexcept {
+      return Digital(buttonID, pin, PinAction::MOMENTARY, activeLow, pulseMillis);
+    }
+
+    static constexpr PinMapping Pwm(TriggerID triggerID, uint8_t pin, int16_t inMin = 0, int16_t inMax = 1023, uint8_t outMin = 0, uint8_t outMax = 255) noexcept {
+      return Analog(PinAction::PWM, InputGroup::TRIGGERS, static_cast<uint8_t>(triggerID), 0, pin, inMin, inMax, outMin, outMax);
+    }
+
+    static constexpr PinMapping Pwm(JoystickID joystickID, uint8_t axis, uint8_t pin, int16_t inMin = -512, int16_t inMax = 512, uint8_t outMin = 0, uint8_t outMax = 255) noexcept {
+      return Analog(PinAction::PWM, InputGroup::JOYSTICKS, static_cast<uint8_t>(joystickID), axis, pin, inMin, inMax, outMin, outMax);
+    }
+
+    static constexpr PinMapping Servo(TriggerID triggerID, uint8_t pin, int16_t inMin = 0, int16_t inMax = 1023, uint16_t minMicros = 1000, uint16_t maxMicros = 2000) noexcept {
+      return Analog(PinAction::SERVO, InputGroup::TRIGGERS, static_cast<uint8_t>(triggerID), 0, pin, inMin, inMax, minMicros, maxMicros);
+    }
+
+    static constexpr PinMapping Servo(JoystickID joystickID, uint8_t axis, uint8_t pin, int16_t inMin = -512, int16_t inMax = 512, uint16_t minMicros = 1000, uint16_t maxMicros = 2000) noexcept {
+      return Analog(PinAction::SERVO, InputGroup::JOYSTICKS, static_cast<uint8_t>(joystickID), axis, pin, inMin, inMax, minMicros, maxMicros);
+    }
+
+    static constexpr PinMapping Digital(ButtonID buttonID, uint8_t pin, PinAction action, bool activeLow, uint16_t pulseMillis) noexcept {
+      return PinMapping{action, InputGroup::BUTTONS, static_cast<uint8_t>(buttonID), 0, pin, activeLow, pulseMillis, 0, 1, 0, 1};
+    }
+
+    static constexpr PinMapping Analog(PinAction action, InputGroup group, uint8_t input, uint8_t axis, uint8_t pin, int16_t inMin, int16_t inMax, uint16_t outMin, uint16_t outMax) noexcept {
+      return PinMapping{action, group, input, axis, pin, false, 0, inMin, inMax, outMin, outMax};
+    }
+  };
+
+  // Where pin values end up. ArduinoPinWriter is the default; a fake can record writes on a
+  // host, and a sketch can route SERVO entries to Servo objects by overriding WriteServo.
+  class PinWriter {
+    public:
+      // Called once per mapped pin when a table is attached
+      virtual void SetupPin(uint8_t pin, PinAction action) = 0;
+      virtual void WriteDigital(uint8_t pin, bool high) = 0;
+      virtual void WritePwm(uint8_t pin, uint8_t duty) = 0;
+      virtual void WriteServo(uint8_t pin, uint16_t pulseMicros) = 0;
+
+    protected:
+      // Not deleted through a base pointer; no virtual destructor needed
+      ~PinWriter() = default;
+  };
+
+  // pinMode/analogWrite, with digital writes going straight to the port register on AVR.
+  // It has no servo timer of its own, so SERVO entries are ignored unless WriteServo is
+  // overridden (as tests/PinMapReplay does with a recording writer).
+  class ArduinoPinWriter : public PinWriter {
+    public:
+      void SetupPin(uint8_t pin, PinAction action) override;
+      void WriteDigital(uint8_t pin, bool high) override;
+      void WritePwm(uint8_t pin, uint8_t duty) override;
+      void WriteServo(uint8_t pin, uint16_t pulseMicros) override;
+  };
+
+  // Drives pins from one gamepad's status through a caller-owned table. Entries are only
+  // re-evaluated when their input group changed in a frame, and a pin is only written when
+  // its output changes. The table is kept by pointer and must outlive the map.
+  // Storage is supplied by BasicPinMap so Gamepad can hold a size-agnostic pointer.
+  class PinMap {
+    public:
+      // Replaces the table; false (table cleared) when it exceeds capacity or an entry is invalid
+      bool SetMappings(const PinMapping* mappings, uint8_t count, PinWriter& writer);
+      uint8_t GetCount() const;
+      // Sets up every pin and drives it from status
+      void Begin(const internal::Status& status, unsigned long nowMillis);
+      // Re-evaluates the entries whose input group is in changedGroups
+      void Update(const internal::Status& status, uint8_t changedGroups, unsigned long nowMillis);
+      // Ends MOMENTARY pulses that have run their length
+      void Expire(unsigned long nowMillis);
+
+      // Output of an axis entry for value, in duty or microseconds
+      static uint16_t Scale(const PinMapping& mapping, int16_t value);
+
+    protected:
+      struct PinState {
+        int16_t input;   // last button state (0/1) or axis value seen
+        uint16_t output; // last value written
+        uint16_t pulseStart;
+        bool active;     // TOGGLE and MOMENTARY state
+      };
+
+      PinMap(PinState* states, uint8_t maxMappings);
+      PinMap(const PinMap&) = delete;
+      PinMap& operator=(const PinMap&) = delete;
+
+    private:
+      static bool IsValid(const PinMapping& mapping);
+      void Evaluate(uint8_t index, const internal::Status& status, unsigned long nowMillis, bool force);
+      void WriteDigital(const PinMapping& mapping, bool active);
+
+      PinState* m_states;
+      uint8_t m_maxMappings;
+      const PinMapping* m_mappings{nullptr};
+      uint8_t m_count{0};
+      PinWriter* m_writer{nullptr};
+  };
+
+  template<uint8_t MaxMappings = 16>
+  class BasicPinMap : public PinMap {
+    public:
+      BasicPinMap() : PinMap(m_stateStorage, MaxMappings) {
+
+      }
+
+    private:
+      static_assert(MaxMappings > 0, "At least one mapping is required");
+      PinState m_stateStorage[MaxMappings]{};
+  };
+} // namespace GSB
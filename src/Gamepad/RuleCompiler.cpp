@@ -0,0 +1,477 @@
+#include "Gamepad/RuleCompiler.h"
+
+namespace GSB {
+  namespace {
+    struct InputName {
+      const char* prefix;
+      InputGroup group;
+      uint8_t first; // ButtonID of _1 for buttons
+      uint8_t count;
+      uint8_t axes;  // 0 = no .x/.y/.z suffix
+    };
+
+    const InputName inputNames[] = {
+      {"DPAD_", InputGroup::BUTTONS, static_cast<uint8_t>(ButtonID::DPAD_1), DPadButtons::Count(), 0},
+      {"MAIN_", InputGroup::BUTTONS, static_cast<uint8_t>(ButtonID::MAIN_1), MainButtons::Count(), 0},
+      {"MISC_", InputGroup::BUTTONS, static_cast<uint8_t>(ButtonID::MISC_1), MiscButtons::Count(), 0},
+      {"TRIGGER_", InputGroup::TRIGGERS, 0, TriggerCount(), 0},
+      {"BATTERY_", InputGroup::BATTERY, 0, BatteryCount(), 0},
+      {"JOYSTICK_", InputGroup::JOYSTICKS, 0, JoystickCount(), 2},
+      {"SENSOR_", InputGroup::SENSORS, 0, SensorCount(), 3},
+    };
+
+    char Upper(char c) {
+      return (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+    }
+
+    bool IsDigit(char c) {
+      return c >= '0' && c <= '9';
+    }
+
+    bool IsWordChar(char c) {
+      return IsDigit(c) || (Upper(c) >= 'A' && Upper(c) <= 'Z') || c == '_' || c == '.';
+    }
+
+    // Case-insensitive prefix match; rest receives what follows the prefix
+    bool StartsWith(const char* word, const char* prefix, const char*& rest) {
+      while (*prefix) {
+        if (Upper(*word) != Upper(*prefix)) {
+          return false;
+        }
+        ++word;
+        ++prefix;
+      }
+      rest = word;
+      return true;
+    }
+
+    bool Equals(const char* word, const char* keyword) {
+      const char* rest = nullptr;
+      return StartsWith(word, keyword, rest) && *rest == '\0';
+    }
+
+    // r0..r7, or s_registerCount when word is not a register
+    uint8_t RegisterIndex(const char* word) {
+      if (Upper(word[0]) == 'R' && word[1] >= '0' && word[1] < '0' + RuleVm::s_registerCount && word[2] == '\0') {
+        return static_cast<uint8_t>(word[1] - '0');
+      }
+      return RuleVm::s_registerCount;
+    }
+  } // namespace
+
+  uint8_t RuleCompiler::Compile(const char* source, uint8_t* out, uint8_t capacity) {
+    m_cursor = source;
+    m_out = out;
+    m_capacity = capacity;
+    m_length = 0;
+    m_line = 1;
+    m_error = RuleCompileError::NONE;
+    m_depth = 0;
+    if (!source || !out) {
+      Fail(RuleCompileError::SYNTAX);
+      return 0;
+    }
+    while (true) {
+      if (!Statement()) {
+        return 0;
+      }
+      if (*m_cursor == '\0') {
+        break;
+      }
+      ++m_cursor;
+      ++m_line;
+    }
+    if (m_depth != 0) {
+      Fail(RuleCompileError::NESTING);
+      return 0;
+    }
+    return m_length;
+  }
+
+  RuleCompileError RuleCompiler::GetError() const {
+    return m_error;
+  }
+
+  uint16_t RuleCompiler::GetLine() const {
+    return m_line;
+  }
+
+  // ---------- statements ----------
+  bool RuleCompiler::Statement() {
+    if (AtLineEnd()) {
+      return true;
+    }
+    char word[s_maxWord + 1];
+    const uint8_t length = PeekWord(word);
+    if (length == 0) {
+      return Fail(RuleCompileError::SYNTAX);
+    }
+    m_cursor += length;
+    if (Equals(word, "if")) {
+      if (m_depth == s_maxNesting) {
+        return Fail(RuleCompileError::NESTING);
+      }
+      if (!Expression() || !Emit(RuleOp::JZ, 0)) {
+        return false;
+      }
+      m_patches[m_depth] = static_cast<uint8_t>(m_length - 1);
+      m_inElse[m_depth] = false;
+      ++m_depth;
+    } else if (Equals(word, "else")) {
+      if (m_depth == 0 || m_inElse[m_depth - 1]) {
+        return Fail(RuleCompileError::NESTING);
+      }
+      // The taken branch jumps over the else branch; the condition's jump lands after it
+      if (!Emit(RuleOp::JMP, 0)) {
+        return false;
+      }
+      Patch(m_patches[m_depth - 1]);
+      m_patches[m_depth - 1] = static_cast<uint8_t>(m_length - 1);
+      m_inElse[m_depth - 1] = true;
+    } else if (Equals(word, "end")) {
+      if (m_depth == 0) {
+        return Fail(RuleCompileError::NESTING);
+      }
+      --m_depth;
+      Patch(m_patches[m_depth]);
+    } else if (Equals(word, "pin")) {
+      if (!Assignment(RuleOp::DIGITAL)) {
+        return false;
+      }
+    } else if (Equals(word, "pwm")) {
+      if (!Assignment(RuleOp::PWM)) {
+        return false;
+      }
+    } else if (Equals(word, "servo")) {
+      if (!Assignment(RuleOp::SERVO)) {
+        return false;
+      }
+    } else if (RegisterIndex(word) < RuleVm::s_registerCount) {
+      if (!Accept("=")) {
+        return Fail(RuleCompileError::SYNTAX);
+      }
+      if (!Expression() || !Emit(RuleOp::STORE, RegisterIndex(word))) {
+        return false;
+      }
+    } else {
+      return Fail(RuleCompileError::UNKNOWN_NAME);
+    }
+    return AtLineEnd() || Fail(RuleCompileError::SYNTAX);
+  }
+
+  bool RuleCompiler::Assignment(RuleOp op) {
+    uint8_t pin = 0;
+    if (!ReadPin(pin) || !Accept("=")) {
+      return Fail(RuleCompileError::SYNTAX);
+    }
+    return Expression() && Emit(op, pin);
+  }
+
+  // ---------- expressions, lowest precedence first ----------
+  bool RuleCompiler::Expression() {
+    if (!Conjunction()) {
+      return false;
+    }
+    while (AcceptWord("or") || Accept("||")) {
+      if (!Conjunction() || !Emit(RuleOp::OR)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool RuleCompiler::Conjunction() {
+    if (!Comparison()) {
+      return false;
+    }
+    while (AcceptWord("and") || Accept("&&")) {
+      if (!Comparison() || !Emit(RuleOp::AND)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool RuleCompiler::Comparison() {
+    if (!Sum()) {
+      return false;
+    }
+    // Two-character operators first so "<=" is not read as "<"
+    const RuleOp op = Accept("<=") ? RuleOp::LE
+                    : Accept(">=") ? RuleOp::GE
+                    : Accept("==") ? RuleOp::EQ
+                    : Accept("!=") ? RuleOp::NE
+                    : Accept("<") ? RuleOp::LT
+                    : Accept(">") ? RuleOp::GT
+                    : RuleOp::COUNT;
+    if (op == RuleOp::COUNT) {
+      return true;
+    }
+    return Sum() && Emit(op);
+  }
+
+  bool RuleCompiler::Sum() {
+    if (!Term()) {
+      return false;
+    }
+    while (true) {
+      if (Accept("+")) {
+        if (!Term() || !Emit(RuleOp::ADD)) {
+          return false;
+        }
+      } else if (Accept("-")) {
+        if (!Term() || !Emit(RuleOp::SUB)) {
+          return false;
+        }
+      } else {
+        return true;
+      }
+    }
+  }
+
+  bool RuleCompiler::Term() {
+    if (!Unary()) {
+      return false;
+    }
+    while (true) {
+      if (Accept("*")) {
+        if (!Unary() || !Emit(RuleOp::MUL)) {
+          return false;
+        }
+      } else if (Accept(">>")) {
+        int32_t bits = 0;
+        if (!ReadNumber(bits)) {
+          return false;
+        }
+        if (bits > 15) {
+          return Fail(RuleCompileError::NUMBER_RANGE);
+        }
+        if (!Emit(RuleOp::SHR, static_cast<uint8_t>(bits))) {
+          return false;
+        }
+      } else {
+        return true;
+      }
+    }
+  }
+
+  bool RuleCompiler::Unary() {
+    if (Accept("-")) {
+      SkipSpaces();
+      if (IsDigit(*m_cursor)) {
+        int32_t value = 0;
+        return ReadNumber(value) && EmitConstant(-value);
+      }
+      return Unary() && Emit(RuleOp::NEG);
+    }
+    if (AcceptWord("not") || Accept("!")) {
+      return Unary() && Emit(RuleOp::NOT);
+    }
+    return Primary();
+  }
+
+  bool RuleCompiler::Primary() {
+    SkipSpaces();
+    if (IsDigit(*m_cursor)) {
+      int32_t value = 0;
+      return ReadNumber(value) && EmitConstant(value);
+    }
+    if (Accept("(")) {
+      if (!Expression()) {
+        return false;
+      }
+      return Accept(")") || Fail(RuleCompileError::SYNTAX);
+    }
+    char word[s_maxWord + 1];
+    const uint8_t length = PeekWord(word);
+    if (length == 0) {
+      return Fail(RuleCompileError::SYNTAX);
+    }
+    m_cursor += length;
+    if (Equals(word, "elapsed")) {
+      return Emit(RuleOp::ELAPSED);
+    }
+    if (Equals(word, "min")) {
+      return Call(RuleOp::MIN);
+    }
+    if (Equals(word, "max")) {
+      return Call(RuleOp::MAX);
+    }
+    if (RegisterIndex(word) < RuleVm::s_registerCount) {
+      return Emit(RuleOp::LOAD, RegisterIndex(word));
+    }
+    return Input(word);
+  }
+
+  bool RuleCompiler::Call(RuleOp op) {
+    if (!Accept("(")) {
+      return Fail(RuleCompileError::SYNTAX);
+    }
+    if (!Expression()) {
+      return false;
+    }
+    if (!Accept(",")) {
+      return Fail(RuleCompileError::SYNTAX);
+    }
+    if (!Expression()) {
+      return false;
+    }
+    return (Accept(")") || Fail(RuleCompileError::SYNTAX)) && Emit(op);
+  }
+
+  bool RuleCompiler::Input(const char* word) {
+    for (const InputName& name : inputNames) {
+      const char* rest = nullptr;
+      if (!StartsWith(word, name.prefix, rest)) {
+        continue;
+      }
+      uint8_t number = 0;
+      while (IsDigit(*rest) && number < 100) {
+        number = static_cast<uint8_t>(number * 10 + (*rest++ - '0'));
+      }
+      if (number == 0 || number > name.count) {
+        return Fail(RuleCompileError::UNKNOWN_NAME);
+      }
+      const uint8_t input = static_cast<uint8_t>(number - 1);
+      if (name.axes == 0) {
+        if (*rest != '\0') {
+          return Fail(RuleCompileError::UNKNOWN_NAME);
+        }
+        if (name.group == InputGroup::BUTTONS) {
+          return Emit(RuleOp::BUTTON, static_cast<uint8_t>(name.first + input));
+        }
+        return Emit(RuleOp::VALUE, static_cast<uint8_t>(name.group)) && EmitByte(input) && EmitByte(0);
+      }
+      const uint8_t axis = (rest[0] == '.' && rest[1] != '\0' && rest[2] == '\0') ? static_cast<uint8_t>(Upper(rest[1]) - 'X') : name.axes;
+      if (axis >= name.axes) {
+        return Fail(RuleCompileError::UNKNOWN_NAME);
+      }
+      return Emit(RuleOp::VALUE, static_cast<uint8_t>(name.group)) && EmitByte(input) && EmitByte(axis);
+    }
+    return Fail(RuleCompileError::UNKNOWN_NAME);
+  }
+
+  // ---------- lexing ----------
+  void RuleCompiler::SkipSpaces() {
+    while (*m_cursor == ' ' || *m_cursor == '\t' || *m_cursor == '\r') {
+      ++m_cursor;
+    }
+  }
+
+  // Skips a trailing comment; true at the end of the line or source
+  bool RuleCompiler::AtLineEnd() {
+    SkipSpaces();
+    if (*m_cursor == '#') {
+      while (*m_cursor != '\n' && *m_cursor != '\0') {
+        ++m_cursor;
+      }
+    }
+    return *m_cursor == '\n' || *m_cursor == '\0';
+  }
+
+  bool RuleCompiler::Accept(const char* symbol) {
+    SkipSpaces();
+    const char* rest = nullptr;
+    if (!StartsWith(m_cursor, symbol, rest)) {
+      return false;
+    }
+    m_cursor = rest;
+    return true;
+  }
+
+  bool RuleCompiler::AcceptWord(const char* keyword) {
+    SkipSpaces();
+    char word[s_maxWord + 1];
+    const uint8_t length = PeekWord(word);
+    if (length == 0 || !Equals(word, keyword)) {
+      return false;
+    }
+    m_cursor += length;
+    return true;
+  }
+
+  // Copies the word at the cursor (truncated to s_maxWord) and returns its full length
+  uint8_t RuleCompiler::PeekWord(char* word) {
+    SkipSpaces();
+    uint8_t length = 0;
+    if (IsDigit(*m_cursor)) {
+      word[0] = '\0';
+      return 0;
+    }
+    while (IsWordChar(m_cursor[length]) && length < UINT8_MAX) {
+      if (length < s_maxWord) {
+        word[length] = m_cursor[length];
+      }
+      ++length;
+    }
+    word[(length < s_maxWord) ? length : s_maxWord] = '\0';
+    return length;
+  }
+
+  bool RuleCompiler::ReadNumber(int32_t& value) {
+    SkipSpaces();
+    if (!IsDigit(*m_cursor)) {
+      return Fail(RuleCompileError::SYNTAX);
+    }
+    value = 0;
+    while (IsDigit(*m_cursor)) {
+      value = value * 10 + (*m_cursor++ - '0');
+      if (value > 32768) {
+        return Fail(RuleCompileError::NUMBER_RANGE);
+      }
+    }
+    return true;
+  }
+
+  bool RuleCompiler::ReadPin(uint8_t& pin) {
+    int32_t value = 0;
+    if (!ReadNumber(value)) {
+      return false;
+    }
+    if (value > UINT8_MAX) {
+      return Fail(RuleCompileError::NUMBER_RANGE);
+    }
+    pin = static_cast<uint8_t>(value);
+    return true;
+  }
+
+  // ---------- output ----------
+  bool RuleCompiler::EmitConstant(int32_t value) {
+    if (value < -32768 || value > 32767) {
+      return Fail(RuleCompileError::NUMBER_RANGE);
+    }
+    if (value >= -128 && value <= 127) {
+      return Emit(RuleOp::PUSH8, static_cast<uint8_t>(static_cast<int8_t>(value)));
+    }
+    const uint16_t bits = static_cast<uint16_t>(value);
+    return Emit(RuleOp::PUSH16, static_cast<uint8_t>(bits & 0xFF)) && EmitByte(static_cast<uint8_t>(bits >> 8));
+  }
+
+  bool RuleCompiler::Emit(RuleOp op) {
+    return EmitByte(static_cast<uint8_t>(op));
+  }
+
+  bool RuleCompiler::Emit(RuleOp op, uint8_t operand) {
+    return EmitByte(static_cast<uint8_t>(op)) && EmitByte(operand);
+  }
+
+  bool RuleCompiler::EmitByte(uint8_t byte) {
+    if (m_length >= m_capacity) {
+      return Fail(RuleCompileError::PROGRAM_TOO_LONG);
+    }
+    m_out[m_length++] = byte;
+    return true;
+  }
+
+  // Points the jump whose offset byte is at position to the current end of the program
+  void RuleCompiler::Patch(uint8_t position) {
+    m_out[position] = static_cast<uint8_t>(m_length - position - 1);
+  }
+
+  bool RuleCompiler::Fail(RuleCompileError error) {
+    if (m_error == RuleCompileError::NONE) {
+      m_error = error;
+    }
+    return false;
+  }
+} // namespace GSB
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Gamepad/RuleVm.h"
+
+namespace GSB {
+  enum class RuleCompileError : uint8_t {
+    NONE,
+    SYNTAX,
+    UNKNOWN_NAME,
+    NUMBER_RANGE,
+    PROGRAM_TOO_LONG,
+    NESTING,       // if/else/end out of place or nested too deep
+    COUNT
+  };
+
+  // Translates rule text into RuleVm bytecode. Meant for the side that edits rules (the
+  // sender, or a host build against this library); receivers only load the bytecode.
+  // One statement per line, '#' starts a comment:
+  //   r0 = r0 + elapsed                 registers r0..r7 keep their value across frames
+  //   if TRIGGER_1 > 600 and MAIN_1     if / else / end blocks, up to 4 deep
+  //     r1 = min(r1 + 4, 255)
+  //   else
+  //     r1 = max(r1 - 8, 0)
+  //   end
+  //   pwm 5 = r1                        also: pin P = expr, servo P = expr
+  //   servo 9 = 1500 + JOYSTICK_1.x
+  // Inputs use the generic IDs: DPAD_n, MAIN_n and MISC_n (1 while held), TRIGGER_n,
+  // BATTERY_n, JOYSTICK_n.x/.y and SENSOR_n.x/.y/.z. Expressions take integers, + - *,
+  // >> n (binding like *), comparisons, and/or/not, min(a, b), max(a, b), parentheses and
+  // elapsed (milliseconds since the previous frame). Names and keywords ignore case.
+  class RuleCompiler {
+    public:
+      // Returns the bytecode length written to out, or 0 with GetError/GetLine set
+      uint8_t Compile(const char* source, uint8_t* out, uint8_t capacity);
+      RuleCompileError GetError() const;
+      // 1-based source line of the error
+      uint16_t GetLine() const;
+
+    private:
+      static constexpr uint8_t s_maxNesting = 4;
+      static constexpr uint8_t s_maxWord = 16;
+
+      bool Statement();
+      bool Assignment(RuleOp op);
+      bool Expression();
+      bool Conjunction();
+      bool Comparison();
+      bool Sum();
+      bool Term();
+      bool Unary();
+      bool Primary();
+      bool Call(RuleOp op);
+      bool Input(const char* word);
+
+      void SkipSpaces();
+      bool AtLineEnd();
+      bool Accept(const char* symbol);
+      bool AcceptWord(const char* keyword);
+      uint8_t PeekWord(char* word);
+      bool ReadNumber(int32_t& value);
+      bool ReadPin(uint8_t& pin);
+      bool EmitConstant(int32_t value);
+      bool Emit(RuleOp op);
+      bool Emit(RuleOp op, uint8_t operand);
+      bool EmitByte(uint8_t byte);
+      void Patch(uint8_t position);
+      bool Fail(RuleCompileError error);
+
+      const char* m_cursor{nullptr};
+      uint8_t* m_out{nullptr};
+      uint8_t m_capacity{0};
+      uint8_t m_length{0};
+      uint16_t m_line{0};
+      RuleCompileError m_error{RuleCompileError::NONE};
+      // Operand positions of the pending forward jumps of open blocks
+      uint8_t m_patches[s_maxNesting]{};
+      bool m_inElse[s_maxNesting]{};
+      uint8_t m_depth{0};
+  };
+} // namespace GSB
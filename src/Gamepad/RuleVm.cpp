@@ -0,0 +1,361 @@
+#include "Gamepad/RuleVm.h"
+#include "internal/Utilities.h"
+
+namespace GSB {
+  namespace {
+    int16_t Clamp16(int32_t value) {
+      return static_cast<int16_t>((value > 32767) ? 32767 : (value < -32768) ? -32768 : value);
+    }
+
+    // Stack slots an instruction consumes, and its net growth (pushes minus pops)
+    uint8_t Pops(RuleOp op) {
+      switch (op) {
+        case RuleOp::STORE:
+        case RuleOp::DUP:
+        case RuleOp::DROP:
+        case RuleOp::SHR:
+        case RuleOp::NEG:
+        case RuleOp::NOT:
+        case RuleOp::JZ:
+        case RuleOp::DIGITAL:
+        case RuleOp::PWM:
+        case RuleOp::SERVO:
+          return 1;
+        case RuleOp::ADD:
+        case RuleOp::SUB:
+        case RuleOp::MUL:
+        case RuleOp::MIN:
+        case RuleOp::MAX:
+        case RuleOp::LT:
+        case RuleOp::LE:
+        case RuleOp::GT:
+        case RuleOp::GE:
+        case RuleOp::EQ:
+        case RuleOp::NE:
+        case RuleOp::AND:
+        case RuleOp::OR:
+          return 2;
+        default:
+          return 0;
+      }
+    }
+
+    int8_t Growth(RuleOp op) {
+      switch (op) {
+        case RuleOp::PUSH8:
+        case RuleOp::PUSH16:
+        case RuleOp::BUTTON:
+        case RuleOp::VALUE:
+        case RuleOp::ELAPSED:
+        case RuleOp::LOAD:
+        case RuleOp::DUP:
+          return 1;
+        case RuleOp::SHR:
+        case RuleOp::NEG:
+        case RuleOp::NOT:
+        case RuleOp::END:
+        case RuleOp::JMP:
+          return 0;
+        default:
+          return -1;
+      }
+    }
+
+    bool IsValidValue(uint8_t group, uint8_t input, uint8_t axis) {
+      switch (static_cast<InputGroup>(group)) {
+        case InputGroup::JOYSTICKS:
+          return input < JoystickCount() && axis < 2;
+        case InputGroup::TRIGGERS:
+          return input < TriggerCount() && axis == 0;
+        case InputGroup::BATTERY:
+          return input < BatteryCount() && axis == 0;
+        case InputGroup::SENSORS:
+          return input < SensorCount() && axis < 3;
+        default:
+          return false;
+      }
+    }
+  } // namespace
+
+  RuleVm::RuleVm(uint8_t* code, uint8_t capacity, PinWriter& writer)
+    : m_code(code),
+      m_capacity(capacity),
+      m_writer(writer) {
+
+  }
+
+  bool RuleVm::Load(const uint8_t* code, uint8_t length) {
+    Clear();
+    if (length > m_capacity || (length > 0 && !code)) {
+      return false;
+    }
+    internal::CopyBytes(m_code, code, length);
+    m_received = length;
+    m_expected = length;
+    return Commit();
+  }
+
+  bool RuleVm::LoadChunk(uint8_t offset, uint8_t total, const uint8_t* data, uint8_t length) {
+    if (offset == 0) {
+      Clear();
+      if (total > m_capacity) {
+        return false;
+      }
+      if (total == 0) {
+        return true;
+      }
+      m_expected = total;
+    }
+    if (m_loaded || offset != m_received || total != m_expected || length > total - offset || (length > 0 && !data)) {
+      Clear();
+      return false;
+    }
+    internal::CopyBytes(&m_code[offset], data, length);
+    m_received = static_cast<uint8_t>(m_received + length);
+    return (m_received == m_expected) ? Commit() : true;
+  }
+
+  void RuleVm::Clear() {
+    m_length = 0;
+    m_received = 0;
+    m_expected = 0;
+    m_steps = 0;
+    m_loaded = false;
+  }
+
+  bool RuleVm::IsLoaded() const {
+    return m_loaded;
+  }
+
+  const uint8_t* RuleVm::GetCode() const {
+    return m_code;
+  }
+
+  uint8_t RuleVm::GetLength() const {
+    return m_length;
+  }
+
+  uint8_t RuleVm::GetCapacity() const {
+    return m_capacity;
+  }
+
+  uint8_t RuleVm::GetMaxSteps() const {
+    return m_steps;
+  }
+
+  int16_t RuleVm::GetRegister(uint8_t index) const {
+    return (index < s_registerCount) ? m_registers[index] : 0;
+  }
+
+  void RuleVm::SetRegister(uint8_t index, int16_t value) {
+    if (index < s_registerCount) {
+      m_registers[index] = value;
+    }
+  }
+
+  uint16_t RuleVm::GetFaultCount() const {
+    return m_faultCount;
+  }
+
+  bool RuleVm::Commit() {
+    uint8_t steps = 0;
+    if (!Validate(m_code, m_received, steps)) {
+      Clear();
+      return false;
+    }
+    m_length = m_received;
+    m_steps = steps;
+    for (uint8_t i = 0; i < s_registerCount; ++i) {
+      m_registers[i] = 0;
+    }
+    for (uint8_t pc = 0; pc < m_length; pc = static_cast<uint8_t>(pc + 1 + RuleOpOperands(static_cast<RuleOp>(m_code[pc])))) {
+      const RuleOp op = static_cast<RuleOp>(m_code[pc]);
+      if (op == RuleOp::DIGITAL) {
+        m_writer.SetupPin(m_code[pc + 1], PinAction::SET);
+      } else if (op == RuleOp::PWM) {
+        m_writer.SetupPin(m_code[pc + 1], PinAction::PWM);
+      } else if (op == RuleOp::SERVO) {
+        m_writer.SetupPin(m_code[pc + 1], PinAction::SERVO);
+      }
+    }
+    m_ran = false;
+    m_loaded = true;
+    return true;
+  }
+
+  // Two passes: mark where each instruction starts, then check every jump lands on one
+  // (or on the end of the program)
+  bool RuleVm::Validate(const uint8_t* code, uint8_t length, uint8_t& steps) {
+    steps = 0;
+    if (length > 0 && !code) {
+      return false;
+    }
+    uint8_t starts[32]{};
+    uint16_t pc = 0;
+    while (pc < length) {
+      const RuleOp op = static_cast<RuleOp>(code[pc]);
+      if (!IsValid(op) || pc + 1 + RuleOpOperands(op) > length) {
+        return false;
+      }
+      const uint8_t* operand = &code[pc + 1];
+      bool valid = true;
+      switch (op) {
+        case RuleOp::BUTTON:
+          valid = operand[0] < ButtonCount() && !IsVirtual(static_cast<ButtonID>(operand[0]));
+          break;
+        case RuleOp::VALUE:
+          valid = IsValidValue(operand[0], operand[1], operand[2]);
+          break;
+        case RuleOp::LOAD:
+        case RuleOp::STORE:
+          valid = operand[0] < s_registerCount;
+          break;
+        case RuleOp::SHR:
+          valid = operand[0] < 16;
+          break;
+        default:
+          break;
+      }
+      if (!valid) {
+        return false;
+      }
+      starts[pc >> 3] = static_cast<uint8_t>(starts[pc >> 3] | (1u << (pc & 7)));
+      pc = static_cast<uint16_t>(pc + 1 + RuleOpOperands(op));
+      ++steps;
+    }
+    for (pc = 0; pc < length; pc = static_cast<uint16_t>(pc + 1 + RuleOpOperands(static_cast<RuleOp>(code[pc])))) {
+      const RuleOp op = static_cast<RuleOp>(code[pc]);
+      if (op != RuleOp::JZ && op != RuleOp::JMP) {
+        continue;
+      }
+      const uint16_t target = static_cast<uint16_t>(pc + 2 + code[pc + 1]);
+      if (target > length || (target < length && !(starts[target >> 3] & (1u << (target & 7))))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool RuleVm::Run(const internal::Status& status, unsigned long nowMillis) {
+    if (!m_loaded) {
+      return false;
+    }
+    const unsigned long elapsed = m_ran ? nowMillis - m_lastRunMillis : 0;
+    m_lastRunMillis = nowMillis;
+    m_ran = true;
+    int16_t stack[s_stackDepth];
+    uint8_t depth = 0;
+    uint8_t pc = 0;
+    while (pc < m_length) {
+      const RuleOp op = static_cast<RuleOp>(m_code[pc]);
+      const uint8_t* operand = &m_code[pc + 1];
+      pc = static_cast<uint8_t>(pc + 1 + RuleOpOperands(op));
+      const int8_t growth = Growth(op);
+      if (depth < Pops(op) || depth + growth > s_stackDepth) {
+        ++m_faultCount;
+        return false;
+      }
+      // top[-1] is the top of the stack and top[0] the next free slot
+      int16_t* top = stack + depth;
+      switch (op) {
+        case RuleOp::END:
+          return true;
+        case RuleOp::PUSH8:
+          top[0] = static_cast<int8_t>(operand[0]);
+          break;
+        case RuleOp::PUSH16:
+          top[0] = static_cast<int16_t>(internal::ReadLE16(operand));
+          break;
+        case RuleOp::BUTTON:
+          top[0] = status.IsPressed(static_cast<ButtonID>(operand[0])) ? 1 : 0;
+          break;
+        case RuleOp::VALUE:
+          top[0] = status.GetValue(static_cast<InputGroup>(operand[0]), operand[1], operand[2]);
+          break;
+        case RuleOp::ELAPSED:
+          top[0] = static_cast<int16_t>((elapsed > 32767UL) ? 32767UL : elapsed);
+          break;
+        case RuleOp::LOAD:
+          top[0] = m_registers[operand[0]];
+          break;
+        case RuleOp::STORE:
+          m_registers[operand[0]] = top[-1];
+          break;
+        case RuleOp::DUP:
+          top[0] = top[-1];
+          break;
+        case RuleOp::DROP:
+          break;
+        case RuleOp::ADD:
+          top[-2] = Clamp16(static_cast<int32_t>(top[-2]) + top[-1]);
+          break;
+        case RuleOp::SUB:
+          top[-2] = Clamp16(static_cast<int32_t>(top[-2]) - top[-1]);
+          break;
+        case RuleOp::MUL:
+          top[-2] = Clamp16(static_cast<int32_t>(top[-2]) * top[-1]);
+          break;
+        case RuleOp::SHR:
+          top[-1] = static_cast<int16_t>(top[-1] >> operand[0]);
+          break;
+        case RuleOp::NEG:
+          top[-1] = Clamp16(-static_cast<int32_t>(top[-1]));
+          break;
+        case RuleOp::NOT:
+          top[-1] = (top[-1] == 0) ? 1 : 0;
+          break;
+        case RuleOp::MIN:
+          top[-2] = (top[-1] < top[-2]) ? top[-1] : top[-2];
+          break;
+        case RuleOp::MAX:
+          top[-2] = (top[-1] > top[-2]) ? top[-1] : top[-2];
+          break;
+        case RuleOp::LT:
+          top[-2] = (top[-2] < top[-1]) ? 1 : 0;
+          break;
+        case RuleOp::LE:
+          top[-2] = (top[-2] <= top[-1]) ? 1 : 0;
+          break;
+        case RuleOp::GT:
+          top[-2] = (top[-2] > top[-1]) ? 1 : 0;
+          break;
+        case RuleOp::GE:
+          top[-2] = (top[-2] >= top[-1]) ? 1 : 0;
+          break;
+        case RuleOp::EQ:
+          top[-2] = (top[-2] == top[-1]) ? 1 : 0;
+          break;
+        case RuleOp::NE:
+          top[-2] = (top[-2] != top[-1]) ? 1 : 0;
+          break;
+        case RuleOp::AND:
+          top[-2] = (top[-2] != 0 && top[-1] != 0) ? 1 : 0;
+          break;
+        case RuleOp::OR:
+          top[-2] = (top[-2] != 0 || top[-1] != 0) ? 1 : 0;
+          break;
+        case RuleOp::JZ:
+          if (top[-1] == 0) {
+            pc = static_cast<uint8_t>(pc + operand[0]);
+          }
+          break;
+        case RuleOp::JMP:
+          pc = static_cast<uint8_t>(pc + operand[0]);
+          break;
+        case RuleOp::DIGITAL:
+          m_writer.WriteDigital(operand[0], top[-1] != 0);
+          break;
+        case RuleOp::PWM:
+          m_writer.WritePwm(operand[0], static_cast<uint8_t>((top[-1] < 0) ? 0 : (top[-1] > 255) ? 255 : top[-1]));
+          break;
+        case RuleOp::SERVO:
+          m_writer.WriteServo(operand[0], static_cast<uint16_t>((top[-1] < 0) ? 0 : top[-1]));
+          break;
+        default:
+          break;
+      }
+      depth = static_cast<uint8_t>(depth + growth);
+    }
+    return true;
+  }
+} // namespace GSB
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Gamepad/InputIDs.h"
+#include "Gamepad/PinMap.h"
+#include "internal/Status.h"
+
+namespace GSB {
+  // Rule bytecode: one opcode byte, then its operand bytes (see RuleOpOperands).
+  // Values are int16; arithmetic saturates and comparisons/logic push 0 or 1.
+  // Jumps only go forward, so every instruction runs at most once per Run.
+  enum class RuleOp : uint8_t {
+    END,     // stop
+    PUSH8,   // [int8] push a constant
+    PUSH16,  // [int16 LE] push a constant
+    BUTTON,  // [ButtonID] push 1 while the button is held
+    VALUE,   // [group][input][axis] push a trigger, joystick, battery or sensor value
+    ELAPSED, // push milliseconds since the previous Run (capped at 32767)
+    LOAD,    // [register] push a register
+    STORE,   // [register] pop into a register; registers persist across runs
+    DUP,
+    DROP,
+    ADD,
+    SUB,
+    MUL,
+    SHR,     // [bits] arithmetic shift right
+    NEG,
+    NOT,
+    MIN,
+    MAX,
+    LT,
+    LE,
+    GT,
+    GE,
+    EQ,
+    NE,
+    AND,
+    OR,
+    JZ,      // [offset] pop; skip offset bytes when zero
+    JMP,     // [offset] skip offset bytes
+    DIGITAL, // [pin] pop; drive the pin high when non-zero
+    PWM,     // [pin] pop; duty clamped to 0..255
+    SERVO,   // [pin] pop; pulse width in microseconds, clamped to 0..32767
+    COUNT
+  };
+
+  constexpr bool IsValid(RuleOp op) noexcept {
+    return op < RuleOp::COUNT;
+  }
+
+  constexpr uint8_t RuleOpOperands(RuleOp op) noexcept {
+    return (op == RuleOp::VALUE) ? 3
+         : (op == RuleOp::PUSH16) ? 2
+         : (op == RuleOp::PUSH8 || op == RuleOp::BUTTON || op == RuleOp::LOAD || op == RuleOp::STORE || op == RuleOp::SHR
+            || op == RuleOp::JZ || op == RuleOp::JMP || op == RuleOp::DIGITAL || op == RuleOp::PWM || op == RuleOp::SERVO) ? 1
+         : 0;
+  }
+
+  // Runs a small rule program over one gamepad's status after each applied frame, writing
+  // pins through a PinWriter. Programs come from RuleCompiler (text) or are uploaded over the
+  // link (GamepadLink::SendRules). They are validated on load; a program that under- or
+  // overflows the stack at run time is stopped for that run and counted as a fault.
+  // Storage is supplied by BasicRuleVm so Gamepad can hold a size-agnostic pointer.
+  class RuleVm {
+    public:
+      static constexpr uint8_t s_registerCount = 8;
+      static constexpr uint8_t s_stackDepth = 16;
+
+      // Copies and validates a program, then sets up its pins; false leaves none loaded
+      bool Load(const uint8_t* code, uint8_t length);
+      // Loads a program in order-preserving pieces: offset 0 starts a new program of total bytes
+      // (0 unloads), and the last piece validates it. False on a gap, overrun or invalid program.
+      bool LoadChunk(uint8_t offset, uint8_t total, const uint8_t* data, uint8_t length);
+      void Clear();
+      bool IsLoaded() const;
+      const uint8_t* GetCode() const;
+      uint8_t GetLength() const;
+      uint8_t GetCapacity() const;
+      // Upper bound on instructions executed by one Run
+      uint8_t GetMaxSteps() const;
+
+      // Evaluates the program once; false when nothing is loaded or the run faulted
+      bool Run(const internal::Status& status, unsigned long nowMillis);
+      int16_t GetRegister(uint8_t index) const;
+      void SetRegister(uint8_t index, int16_t value);
+      uint16_t GetFaultCount() const;
+
+      // Checks opcodes, operands and jump targets; steps receives the instruction count
+      static bool Validate(const uint8_t* code, uint8_t length, uint8_t& steps);
+
+    protected:
+      RuleVm(uint8_t* code, uint8_t capacity, PinWriter& writer);
+      RuleVm(const RuleVm&) = delete;
+      RuleVm& operator=(const RuleVm&) = delete;
+
+    private:
+      // Validates the received bytes and prepares them to run
+      bool Commit();
+
+      uint8_t* m_code;
+      uint8_t m_capacity;
+      PinWriter& m_writer;
+      uint8_t m_length{0};
+      uint8_t m_received{0};
+      uint8_t m_expected{0};
+      uint8_t m_steps{0};
+      bool m_loaded{false};
+      bool m_ran{false};
+      uint16_t m_faultCount{0};
+      unsigned long m_lastRunMillis{0};
+      int16_t m_registers[s_registerCount]{};
+  };
+
+  template<uint8_t CodeCapacity = 64>
+  class BasicRuleVm : public RuleVm {
+    public:
+      explicit BasicRuleVm(PinWriter& writer) : RuleVm(m_codeStorage, CodeCapacity, writer) {
+
+      }
+
+    private:
+      static_assert(CodeCapacity > 0, "Rule programs need at least one byte");
+      uint8_t m_codeStorage[CodeCapacity]{};
+  };
+} // namespace GSB
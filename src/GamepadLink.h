@@ -3,12 +3,17 @@
 #include <Arduino.h>
 #include "internal/LinkBase.h"
 #include "internal/Utilities.h"
+#include "internal/RuleUpload.h"
+#include "Gamepad/RuleCompiler.h"
 
 namespace GSB {
-  class GamepadLink : public internal::LinkBase {
+  // Sending side: serializes local gamepad status and applies received commands.
+  // Sized by Traits at compile time; GamepadLink is the default configuration.
+  template<typename Traits = DefaultLinkTraits>
+  class BasicGamepadLink : public internal::LinkBase<BasicGamepadLink<Traits>, Traits> {
     public:
-      GamepadLink(const LinkConfig& linkConfig);
-      ~GamepadLink() noexcept = default;
+      BasicGamepadLink(const LinkConfig& linkConfig) noexcept;
+      ~BasicGamepadLink() noexcept = default;
 
       // ──────────────────────────────
       // Callbacks (applied to all gamepads)
@@ -31,12 +36,111 @@ namespace GSB {
       void SetSensorX(uint8_t gamepadIndex, SensorID sensorID, int16_t value) noexcept;
       void SetSensorY(uint8_t gamepadIndex, SensorID sensorID, int16_t value) noexcept;
       void SetSensorZ(uint8_t gamepadIndex, SensorID sensorID, int16_t value) noexcept;
+      // Bulk update from a filled snapshot (its gamepadIndex is ignored); only inputs that
+      // cross their tolerance mark the gamepad changed
+      void SetStatus(uint8_t gamepadIndex, const internal::Status& status, uint8_t groups = AllInputGroupsMask()) noexcept;
+      // Shapes sticks before they are tolerance-checked and sent (see JoystickShaper.h)
+      void SetJoystickShape(uint8_t gamepadIndex, JoystickID joystickID, const JoystickShape& shape) noexcept;
+      // Per-axis smoothing before changes are tolerance-checked and sent (see Axis::SetFilter)
+      void SetTriggerFilter(uint8_t gamepadIndex, TriggerID triggerID, uint8_t emaShift, bool median) noexcept;
+      void SetJoystickFilter(uint8_t gamepadIndex, JoystickID joystickID, uint8_t emaShift, bool median) noexcept;
+      void SetSensorFilter(uint8_t gamepadIndex, SensorID sensorID, uint8_t emaShift, bool median) noexcept;
+      // Sends the groups that are due (see SetGroupInterval); groups not due are left out of the frame
       bool SendStatus(uint8_t gamepadIndex) noexcept;
+      // PACKED sends each field at its declared bit width (see StatusLayout)
+      void SetStatusFormat(StatusFormat format) noexcept;
+      StatusFormat GetStatusFormat() const noexcept;
+
+      // ──────────────────────────────
+      // GROUP RATES
+      // ──────────────────────────────
+      // Minimum milliseconds between sends of an input group (0 = every status, max ~65 s).
+      // A group is always included in its first status after Setup.
+      void SetGroupInterval(InputGroup group, uint16_t intervalMillis) noexcept;
+      uint16_t GetGroupInterval(InputGroup group) const noexcept;
+
+      // ──────────────────────────────
+      // SENSOR BATCHING
+      // ──────────────────────────────
+      // With samplesPerBatch > 0, sensors leave the status frame and travel in batch messages
+      // of up to samplesPerBatch samples (fewer when maxPayload fills first), so motion can be
+      // sampled far faster than status is sent. A partial batch goes out from Loop once its
+      // oldest sample is maxLatencyMillis old (0 = only when full or flushed). Needs
+      // Traits::sensorBatching and a profile with sensors.
+      void SetSensorBatching(uint8_t samplesPerBatch, uint16_t maxLatencyMillis = 0) noexcept;
+      uint8_t GetSensorBatchSize() const noexcept;
+      // Sets the gamepad's sensors and, while batching, queues the sample stamped with micros()
+      bool PushSensorSample(uint8_t gamepadIndex, const SensorSample& sample) noexcept;
+      // Sends the samples queued so far; if the send fails they stay queued for the next flush
+      bool FlushSensorSamples(uint8_t gamepadIndex) noexcept;
+
+      // ──────────────────────────────
+      // RULE UPLOAD
+      // ──────────────────────────────
+      // Sends rule bytecode (see RuleCompiler) to the receiver's RuleVm for gamepadIndex in
+      // maxPayload-sized pieces; length 0 unloads it. The receiver stops its old program at the
+      // first piece and runs the new one once the last piece validates.
+      bool SendRules(uint8_t gamepadIndex, const uint8_t* code, uint8_t length) noexcept;
+
+      // ──────────────────────────────
+      // SCHEDULER
+      // ──────────────────────────────
+      // When enabled, Loop sends status by itself: a gamepad whose inputs changed goes out
+      // once minIntervalMillis has passed since its last frame, an unchanged one is refreshed
+      // every refreshIntervalMillis (0 = never). One frame per Loop, round-robin across gamepads,
+      // never faster than the UART can carry (see GetRateCeiling). Group intervals still apply.
+      void EnableScheduler(bool enabled) noexcept;
+      bool IsSchedulerEnabled() const noexcept;
+      void SetMinSendInterval(uint16_t intervalMillis) noexcept;
+      void SetRefreshInterval(uint16_t intervalMillis) noexcept;
+      // Status frames per second sent for a gamepad, measured over the last full second
+      uint16_t GetAchievedRate(uint8_t gamepadIndex) const noexcept;
+      // Frames per second the UART can carry at the size of the last status frame
+      uint16_t GetRateCeiling() const noexcept;
+
+      // Adaptive rate (scheduler only): a gamepad whose inputs are changing is active and
+      // streams every min send interval; after quietMillis without a change it goes idle
+      // and falls back to the refresh interval. The first change after idle is sent at once,
+      // ahead of other gamepads and without waiting out the min send interval.
+      void EnableAdaptiveRate(bool enabled, uint16_t quietMillis = s_defaultQuietPeriod) noexcept;
+      bool IsGamepadActive(uint8_t gamepadIndex) const noexcept;
+      // Frames per second the scheduler is currently targeting for a gamepad
+      uint16_t GetTargetRate(uint8_t gamepadIndex) const noexcept;
+      // Idle -> active and active -> idle transitions since Setup
+      uint16_t GetActivationCount(uint8_t gamepadIndex) const noexcept;
+      uint16_t GetIdleCount(uint8_t gamepadIndex) const noexcept;
 
     private:
+      using Base = internal::LinkBase<BasicGamepadLink<Traits>, Traits>;
+      friend Base;
+      using Gamepad = typename Base::Gamepad;
+      using Profile = typename Base::Profile;
+      static_assert(internal::Status::Length(Profile::inputGroups) <= Traits::maxPayload, "Status frame for this profile exceeds maxPayload");
+      static_assert(!(Traits::sensorBatching && Profile::Has(InputGroup::SENSORS)) || internal::SensorBatch::MaxHeaderLength() + internal::SensorBatch::MaxSampleLength() <= Traits::maxPayload, "A one-sample sensor batch exceeds maxPayload");
+      static_assert(internal::RuleUpload::HeaderLength() < Traits::maxPayload, "Rule upload pieces need room for program bytes");
+      using Base::GetGamepadCount;
+      using Base::GetGamepad;
+      using Base::Log;
+      using Base::SendSerial;
+
       // Process command messages
-      void ParseSerial(const uint8_t* data, size_t length) noexcept override;
+      void ParseSerial(const uint8_t* data, size_t length) noexcept;
       void ApplyCommand(const internal::Command& command);
+      void ApplyInputFilter(uint8_t gamepadIndex, const internal::Command::Parameters::InputFilter& filter) noexcept;
+
+      uint8_t DueGroups(uint8_t gamepadIndex, uint16_t now) const noexcept;
+      bool SendStatusGroups(uint8_t gamepadIndex, uint8_t groups) noexcept;
+
+      // Sends partial sensor batches that reached their latency, then runs the status scheduler; called from Loop
+      void Service() noexcept;
+      // Claims UART time for a frame sent outside the scheduler so status frames do not pile up behind it
+      void ReserveLink(size_t payloadLength) noexcept;
+      uint8_t ScheduledGroups(uint8_t gamepadIndex, uint16_t now) const noexcept;
+      void UpdateActivity(uint8_t gamepadIndex, uint16_t now) noexcept;
+      uint16_t RefreshInterval(uint8_t gamepadIndex) const noexcept;
+      void UpdateRates(uint16_t now) noexcept;
+      // UART time to send a status payload of this many bytes
+      unsigned long FrameMicros(size_t payloadLength) const noexcept;
       
       // ──────────────────────────────
       // COMMANDS
@@ -83,5 +187,49 @@ namespace GSB {
       void SetColorLed(uint8_t gamepadIndex, ColorLedID colorLedID, bool illuminated) noexcept;
       void SetColorLed(uint8_t gamepadIndex, ColorLedID colorLedID, bool illuminated, uint8_t red, uint8_t green, uint8_t blue) noexcept;
       void ToggleColorLed(uint8_t gamepadIndex, ColorLedID colorLedID) noexcept;
+
+      StatusFormat m_statusFormat;
+
+      // Battery changes on the order of minutes; everything else goes every status
+      static constexpr uint16_t s_defaultBatteryInterval = 10000;
+      uint16_t m_groupIntervals[InputGroupCount()]{};
+      // Truncated millis() of each group's last send, per gamepad
+      uint16_t m_groupSentAt[Traits::maxGamepads][InputGroupCount()]{};
+      uint8_t m_groupsSent[Traits::maxGamepads]{};
+
+      // Body bytes of one batch message; 0 compiles batching out
+      static constexpr size_t s_sensorBatchCapacity = (Traits::sensorBatching && Profile::Has(InputGroup::SENSORS)) ? Traits::maxPayload - internal::SensorBatch::MaxHeaderLength() : 0;
+      uint8_t m_sensorBatchSize{0};
+      uint16_t m_sensorBatchLatency{0};
+      internal::SensorBatchWriter<s_sensorBatchCapacity> m_sensorBatches[Traits::maxGamepads];
+
+      static constexpr uint16_t s_defaultMinSendInterval = 10;
+      static constexpr uint16_t s_defaultRefreshInterval = 1000;
+      static constexpr uint16_t s_rateWindow = 1000;
+      bool m_schedulerEnabled{false};
+      uint16_t m_minSendInterval{s_defaultMinSendInterval};
+      uint16_t m_refreshInterval{s_defaultRefreshInterval};
+      uint8_t m_nextGamepad{0};
+      // UART time of the last status frame, and when the UART is done with it (micros)
+      unsigned long m_frameMicros{0};
+      unsigned long m_linkFreeAt{0};
+      uint16_t m_lastSentAt[Traits::maxGamepads]{};
+      uint16_t m_windowFrames[Traits::maxGamepads]{};
+      uint16_t m_achievedRates[Traits::maxGamepads]{};
+      uint16_t m_windowStart{0};
+
+      static constexpr uint16_t s_defaultQuietPeriod = 500;
+      bool m_adaptiveRate{false};
+      uint16_t m_quietPeriod{s_defaultQuietPeriod};
+      bool m_active[Traits::maxGamepads]{};
+      // Set on the idle -> active transition until that change has been sent
+      bool m_burst[Traits::maxGamepads]{};
+      uint16_t m_lastChangeAt[Traits::maxGamepads]{};
+      uint16_t m_activations[Traits::maxGamepads]{};
+      uint16_t m_idles[Traits::maxGamepads]{};
   };
-} // namespace GSB
\ No newline at end of file
+
+  using GamepadLink = BasicGamepadLink<>;
+} // namespace GSB
+
+#include "GamepadLink.tpp"
\ No newline at end of file
@@ -0,0 +1,1055 @@
+// Template definitions for BasicGamepadLink; included at the bottom of GamepadLink.h
+
+namespace GSB {
+  template<typename Traits>
+  BasicGamepadLink<Traits>::BasicGamepadLink(const LinkConfig& linkConfig) noexcept : Base(linkConfig), m_statusFormat(linkConfig.statusFormat) {
+    m_groupIntervals[static_cast<uint8_t>(InputGroup::BATTERY)] = s_defaultBatteryInterval;
+    // Estimate from a full frame until one has been measured
+    m_frameMicros = FrameMicros(internal::Status::Length(Profile::inputGroups, m_statusFormat));
+  }
+
+  // ──────────────────────────────
+  // Callbacks (applied to all gamepads)
+  // ──────────────────────────────
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetOnDisconnect(void (*fxPtr)(uint8_t gamepadIndex)) noexcept {
+    for (uint8_t i = 0; i < GetGamepadCount(); ++i) {
+      GetGamepad(i).SetOnDisconnect(fxPtr);
+    }
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetRumbleOnChange(void (*fxPtr)(uint8_t gamepadIndex, RumbleID rumbleID, uint8_t force, uint8_t duration)) noexcept {
+    for (uint8_t i = 0; i < GetGamepadCount(); ++i) {
+      GetGamepad(i).SetRumbleOnChange(fxPtr);
+    }
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetPlayerLedOnChange(void (*fxPtr)(uint8_t gamepadIndex, PlayerLedID playerLedID, bool illuminated)) noexcept {
+    for (uint8_t i = 0; i < GetGamepadCount(); ++i) {
+      GetGamepad(i).SetPlayerLedOnChange(fxPtr);
+    }
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetColorLedOnChange(void (*fxPtr)(uint8_t gamepadIndex, ColorLedID colorLedID, bool illuminated, uint8_t red, uint8_t green, uint8_t blue)) noexcept {
+    for (uint8_t i = 0; i < GetGamepadCount(); ++i) {
+      GetGamepad(i).SetColorLedOnChange(fxPtr);
+    }
+  }
+
+  // ──────────────────────────────
+  // STATUS
+  // ──────────────────────────────
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetButton(uint8_t gamepadIndex, ButtonID buttonID, bool pressed) noexcept {
+    GetGamepad(gamepadIndex).SetButton(buttonID, pressed);
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetTrigger(uint8_t gamepadIndex, TriggerID triggerID, int16_t value) noexcept {
+    GetGamepad(gamepadIndex).SetTrigger(triggerID, value);
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetJoystick(uint8_t gamepadIndex, JoystickID joystickID, int16_t valueX, int16_t valueY) noexcept {
+    GetGamepad(gamepadIndex).SetJoystick(joystickID, valueX, valueY);
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetJoystickX(uint8_t gamepadIndex, JoystickID joystickID, int16_t value) noexcept {
+    GetGamepad(gamepadIndex).SetJoystickX(joystickID, value);
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetJoystickY(uint8_t gamepadIndex, JoystickID joystickID, int16_t value) noexcept {
+    GetGamepad(gamepadIndex).SetJoystickY(joystickID, value);
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetBattery(uint8_t gamepadIndex, BatteryID batteryID, uint8_t value) noexcept {
+    GetGamepad(gamepadIndex).SetBattery(batteryID, value);
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetSensor(uint8_t gamepadIndex, SensorID sensorID, int16_t valueX, int16_t valueY, int16_t valueZ) noexcept {
+    GetGamepad(gamepadIndex).SetSensor(sensorID, valueX, valueY, valueZ);
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetSensorX(uint8_t gamepadIndex, SensorID sensorID, int16_t value) noexcept {
+    GetGamepad(gamepadIndex).SetSensorX(sensorID, value);
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetSensorY(uint8_t gamepadIndex, SensorID sensorID, int16_t value) noexcept {
+    GetGamepad(gamepadIndex).SetSensorY(sensorID, value);
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetSensorZ(uint8_t gamepadIndex, SensorID sensorID, int16_t value) noexcept {
+    GetGamepad(gamepadIndex).SetSensorZ(sensorID, value);
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetStatus(uint8_t gamepadIndex, const internal::Status& status, uint8_t groups) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      Log(F("SetStatus: bad gamepad index"));
+      return;
+    }
+    GetGamepad(gamepadIndex).SetStatus(status, groups);
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetJoystickShape(uint8_t gamepadIndex, JoystickID joystickID, const JoystickShape& shape) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return;
+    }
+    GetGamepad(gamepadIndex).SetJoystickShape(joystickID, shape);
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetTriggerFilter(uint8_t gamepadIndex, TriggerID triggerID, uint8_t emaShift, bool median) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return;
+    }
+    GetGamepad(gamepadIndex).SetTriggerFilter(triggerID, emaShift, median);
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetJoystickFilter(uint8_t gamepadIndex, JoystickID joystickID, uint8_t emaShift, bool median) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return;
+    }
+    GetGamepad(gamepadIndex).SetJoystickFilter(joystickID, emaShift, median);
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetSensorFilter(uint8_t gamepadIndex, SensorID sensorID, uint8_t emaShift, bool median) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return;
+    }
+    GetGamepad(gamepadIndex).SetSensorFilter(sensorID, emaShift, median);
+  }
+
+  template<typename Traits>
+  bool BasicGamepadLink<Traits>::SendStatus(uint8_t gamepadIndex) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      Log(F("SendStatus: bad gamepad index"));
+      return false;
+    }
+    const uint8_t due = DueGroups(gamepadIndex, static_cast<uint16_t>(millis()));
+    if (due == 0) {
+      // Every group is rate limited right now; nothing to send
+      return true;
+    }
+    return SendStatusGroups(gamepadIndex, due);
+  }
+
+  template<typename Traits>
+  uint8_t BasicGamepadLink<Traits>::DueGroups(uint8_t gamepadIndex, uint16_t now) const noexcept {
+    uint8_t due = 0;
+    for (uint8_t i = 0; i < InputGroupCount(); ++i) {
+      const uint8_t mask = InputGroupMask(static_cast<InputGroup>(i));
+      if (!(Profile::inputGroups & mask)) {
+        continue;
+      }
+      // Batched sensors never ride in the status frame
+      if (m_sensorBatchSize != 0 && static_cast<InputGroup>(i) == InputGroup::SENSORS) {
+        continue;
+      }
+      const uint16_t interval = m_groupIntervals[i];
+      if (interval == 0 || !(m_groupsSent[gamepadIndex] & mask) || static_cast<uint16_t>(now - m_groupSentAt[gamepadIndex][i]) >= interval) {
+        due = static_cast<uint8_t>(due | mask);
+      }
+    }
+    return due;
+  }
+
+  template<typename Traits>
+  bool BasicGamepadLink<Traits>::SendStatusGroups(uint8_t gamepadIndex, uint8_t groups) noexcept {
+    groups &= Profile::inputGroups;
+    const internal::Status& status = GetGamepad(gamepadIndex).GetStatus();
+    // FIXED is the larger format, so this fits either
+    uint8_t data[internal::Status::Length(Profile::inputGroups)];
+    const size_t length = status.Serialize(data, sizeof(data), groups, m_statusFormat);
+    if (length == 0) {
+      return false;
+    }
+    if (!SendSerial(data, length)) {
+      return false;
+    }
+    const uint16_t now = static_cast<uint16_t>(millis());
+    for (uint8_t i = 0; i < InputGroupCount(); ++i) {
+      if (groups & InputGroupMask(static_cast<InputGroup>(i))) {
+        m_groupSentAt[gamepadIndex][i] = now;
+      }
+    }
+    m_groupsSent[gamepadIndex] = static_cast<uint8_t>(m_groupsSent[gamepadIndex] | groups);
+    GetGamepad(gamepadIndex).ClearChangedGroups(groups);
+    m_lastSentAt[gamepadIndex] = now;
+    m_burst[gamepadIndex] = false;
+    if (m_windowFrames[gamepadIndex] < UINT16_MAX) {
+      ++m_windowFrames[gamepadIndex];
+    }
+    m_frameMicros = FrameMicros(length);
+    ReserveLink(length);
+    return true;
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::ReserveLink(size_t payloadLength) noexcept {
+    const unsigned long now = micros();
+    // Queue behind a frame still on the wire
+    const unsigned long start = (static_cast<long>(m_linkFreeAt - now) > 0) ? m_linkFreeAt : now;
+    m_linkFreeAt = start + FrameMicros(payloadLength);
+  }
+
+  // ──────────────────────────────
+  // SCHEDULER
+  // ──────────────────────────────
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::EnableScheduler(bool enabled) noexcept {
+    m_schedulerEnabled = enabled;
+  }
+
+  template<typename Traits>
+  bool BasicGamepadLink<Traits>::IsSchedulerEnabled() const noexcept {
+    return m_schedulerEnabled;
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetMinSendInterval(uint16_t intervalMillis) noexcept {
+    m_minSendInterval = intervalMillis;
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetRefreshInterval(uint16_t intervalMillis) noexcept {
+    m_refreshInterval = intervalMillis;
+  }
+
+  template<typename Traits>
+  uint16_t BasicGamepadLink<Traits>::GetAchievedRate(uint8_t gamepadIndex) const noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return 0;
+    }
+    return m_achievedRates[gamepadIndex];
+  }
+
+  template<typename Traits>
+  uint16_t BasicGamepadLink<Traits>::GetRateCeiling() const noexcept {
+    if (m_frameMicros == 0) {
+      return 0;
+    }
+    const unsigned long ceiling = 1000000UL / m_frameMicros;
+    return static_cast<uint16_t>(ceiling > UINT16_MAX ? UINT16_MAX : ceiling);
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::Service() noexcept {
+    const uint16_t now = static_cast<uint16_t>(millis());
+    UpdateRates(now);
+    if (m_sensorBatchSize != 0 && m_sensorBatchLatency != 0) {
+      const unsigned long nowMicros = micros();
+      for (uint8_t i = 0; i < GetGamepadCount(); ++i) {
+        const internal::SensorBatchWriter<s_sensorBatchCapacity>& batch = m_sensorBatches[i];
+        if (batch.GetCount() != 0 && nowMicros - batch.GetOldestMicros() >= m_sensorBatchLatency * 1000UL) {
+          FlushSensorSamples(i);
+        }
+      }
+    }
+    if (!m_schedulerEnabled) {
+      return;
+    }
+    // Rate ceiling: wait until the UART has had time to shift out the previous frame
+    if (static_cast<long>(micros() - m_linkFreeAt) < 0) {
+      return;
+    }
+    const uint8_t count = GetGamepadCount();
+    for (uint8_t i = 0; i < count; ++i) {
+      UpdateActivity(i, now);
+    }
+    // A gamepad waking from idle goes first
+    for (uint8_t i = 0; i < count; ++i) {
+      if (m_burst[i]) {
+        const uint8_t groups = ScheduledGroups(i, now);
+        if (groups != 0) {
+          SendStatusGroups(i, groups);
+          return;
+        }
+      }
+    }
+    for (uint8_t n = 0; n < count; ++n) {
+      const uint8_t index = static_cast<uint8_t>((m_nextGamepad + n) % count);
+      const uint8_t groups = ScheduledGroups(index, now);
+      if (groups == 0) {
+        continue;
+      }
+      // Start after this gamepad next time so a busy one cannot starve the rest
+      m_nextGamepad = static_cast<uint8_t>((index + 1) % count);
+      SendStatusGroups(index, groups);
+      return;
+    }
+  }
+
+  template<typename Traits>
+  uint8_t BasicGamepadLink<Traits>::ScheduledGroups(uint8_t gamepadIndex, uint16_t now) const noexcept {
+    const bool everSent = m_groupsSent[gamepadIndex] != 0;
+    const uint16_t elapsed = static_cast<uint16_t>(now - m_lastSentAt[gamepadIndex]);
+    if (everSent && elapsed < m_minSendInterval && !m_burst[gamepadIndex]) {
+      return 0;
+    }
+    const uint8_t due = DueGroups(gamepadIndex, now);
+    const uint8_t changed = static_cast<uint8_t>(GetGamepad(gamepadIndex).GetChangedGroups() & due);
+    if (changed != 0) {
+      return changed;
+    }
+    const uint16_t refresh = RefreshInterval(gamepadIndex);
+    if (refresh != 0 && (!everSent || elapsed >= refresh)) {
+      return due;
+    }
+    return 0;
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::UpdateActivity(uint8_t gamepadIndex, uint16_t now) noexcept {
+    if (!m_adaptiveRate) {
+      return;
+    }
+    if (GetGamepad(gamepadIndex).GetChangedGroups() != 0) {
+      m_lastChangeAt[gamepadIndex] = now;
+      if (!m_active[gamepadIndex]) {
+        m_active[gamepadIndex] = true;
+        m_burst[gamepadIndex] = true;
+        if (m_activations[gamepadIndex] < UINT16_MAX) {
+          ++m_activations[gamepadIndex];
+        }
+      }
+    } else if (m_active[gamepadIndex] && static_cast<uint16_t>(now - m_lastChangeAt[gamepadIndex]) >= m_quietPeriod) {
+      m_active[gamepadIndex] = false;
+      if (m_idles[gamepadIndex] < UINT16_MAX) {
+        ++m_idles[gamepadIndex];
+      }
+    }
+  }
+
+  template<typename Traits>
+  uint16_t BasicGamepadLink<Traits>::RefreshInterval(uint8_t gamepadIndex) const noexcept {
+    if (m_adaptiveRate && m_active[gamepadIndex]) {
+      // Keep streaming while active; 0 would mean "never"
+      return m_minSendInterval != 0 ? m_minSendInterval : 1;
+    }
+    return m_refreshInterval;
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::EnableAdaptiveRate(bool enabled, uint16_t quietMillis) noexcept {
+    m_adaptiveRate = enabled;
+    m_quietPeriod = quietMillis;
+    if (!enabled) {
+      for (uint8_t i = 0; i < GetGamepadCount(); ++i) {
+        m_active[i] = false;
+        m_burst[i] = false;
+      }
+    }
+  }
+
+  template<typename Traits>
+  bool BasicGamepadLink<Traits>::IsGamepadActive(uint8_t gamepadIndex) const noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return false;
+    }
+    return m_active[gamepadIndex];
+  }
+
+  template<typename Traits>
+  uint16_t BasicGamepadLink<Traits>::GetTargetRate(uint8_t gamepadIndex) const noexcept {
+    if (!m_schedulerEnabled || gamepadIndex >= GetGamepadCount()) {
+      return 0;
+    }
+    const uint16_t interval = RefreshInterval(gamepadIndex);
+    if (interval == 0) {
+      return 0;
+    }
+    const uint16_t rate = static_cast<uint16_t>(1000 / interval);
+    const uint16_t ceiling = GetRateCeiling();
+    return (ceiling != 0 && rate > ceiling) ? ceiling : rate;
+  }
+
+  template<typename Traits>
+  uint16_t BasicGamepadLink<Traits>::GetActivationCount(uint8_t gamepadIndex) const noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return 0;
+    }
+    return m_activations[gamepadIndex];
+  }
+
+  template<typename Traits>
+  uint16_t BasicGamepadLink<Traits>::GetIdleCount(uint8_t gamepadIndex) const noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return 0;
+    }
+    return m_idles[gamepadIndex];
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::UpdateRates(uint16_t now) noexcept {
+    const uint16_t elapsed = static_cast<uint16_t>(now - m_windowStart);
+    if (elapsed < s_rateWindow) {
+      return;
+    }
+    for (uint8_t i = 0; i < GetGamepadCount(); ++i) {
+      m_achievedRates[i] = static_cast<uint16_t>((static_cast<uint32_t>(m_windowFrames[i]) * 1000UL) / elapsed);
+      m_windowFrames[i] = 0;
+    }
+    m_windowStart = now;
+  }
+
+  template<typename Traits>
+  unsigned long BasicGamepadLink<Traits>::FrameMicros(size_t payloadLength) const noexcept {
+    const UartConfig& uart = Base::GetUartConfig();
+    const unsigned long baud = uart.GetBaudRate();
+    if (baud == 0) {
+      return 0;
+    }
+    const unsigned long bits = static_cast<unsigned long>(Base::WireLength(payloadLength)) * uart.GetCharacterBits();
+    return (bits * 1000000UL + baud - 1) / baud;
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetGroupInterval(InputGroup group, uint16_t intervalMillis) noexcept {
+    if (!IsValid(group)) {
+      return;
+    }
+    m_groupIntervals[static_cast<uint8_t>(group)] = intervalMillis;
+  }
+
+  template<typename Traits>
+  uint16_t BasicGamepadLink<Traits>::GetGroupInterval(InputGroup group) const noexcept {
+    if (!IsValid(group)) {
+      return 0;
+    }
+    return m_groupIntervals[static_cast<uint8_t>(group)];
+  }
+
+  // ──────────────────────────────
+  // SENSOR BATCHING
+  // ──────────────────────────────
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetSensorBatching(uint8_t samplesPerBatch, uint16_t maxLatencyMillis) noexcept {
+    if (s_sensorBatchCapacity == 0) {
+      if (samplesPerBatch != 0) {
+        Log(F("Sensor batching not available in this link configuration"));
+      }
+      return;
+    }
+    if (samplesPerBatch == 0) {
+      // Samples already queued still go out before sensors return to the status frame
+      for (uint8_t i = 0; i < GetGamepadCount(); ++i) {
+        FlushSensorSamples(i);
+      }
+    }
+    m_sensorBatchSize = samplesPerBatch;
+    m_sensorBatchLatency = maxLatencyMillis;
+  }
+
+  template<typename Traits>
+  uint8_t BasicGamepadLink<Traits>::GetSensorBatchSize() const noexcept {
+    return m_sensorBatchSize;
+  }
+
+  template<typename Traits>
+  bool BasicGamepadLink<Traits>::PushSensorSample(uint8_t gamepadIndex, const SensorSample& sample) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return false;
+    }
+    Gamepad& gamepad = GetGamepad(gamepadIndex);
+    for (uint8_t i = 0; i < SensorCount(); ++i) {
+      gamepad.SetSensor(static_cast<SensorID>(i), sample.values[i][0], sample.values[i][1], sample.values[i][2]);
+    }
+    if (m_sensorBatchSize == 0) {
+      return true;
+    }
+    // The batch carries the change, so it must not also wake the status scheduler
+    gamepad.ClearChangedGroups(InputGroupMask(InputGroup::SENSORS));
+    internal::SensorBatchWriter<s_sensorBatchCapacity>& batch = m_sensorBatches[gamepadIndex];
+    const unsigned long now = micros();
+    if (!batch.Add(sample, now)) {
+      if (!FlushSensorSamples(gamepadIndex) || !batch.Add(sample, now)) {
+        return false;
+      }
+    }
+    if (batch.GetCount() >= m_sensorBatchSize) {
+      return FlushSensorSamples(gamepadIndex);
+    }
+    return true;
+  }
+
+  template<typename Traits>
+  bool BasicGamepadLink<Traits>::FlushSensorSamples(uint8_t gamepadIndex) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return false;
+    }
+    internal::SensorBatchWriter<s_sensorBatchCapacity>& batch = m_sensorBatches[gamepadIndex];
+    if (batch.GetCount() == 0) {
+      return true;
+    }
+    uint8_t data[Traits::maxPayload];
+    const size_t length = batch.Finish(gamepadIndex, micros(), data, sizeof(data));
+    if (length == 0 || !SendSerial(data, length)) {
+      return false;
+    }
+    batch.Clear();
+    ReserveLink(length);
+    return true;
+  }
+
+  // ──────────────────────────────
+  // RULE UPLOAD
+  // ──────────────────────────────
+  template<typename Traits>
+  bool BasicGamepadLink<Traits>::SendRules(uint8_t gamepadIndex, const uint8_t* code, uint8_t length) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      return false;
+    }
+    if (length > 0 && !code) {
+      Log(F("Invalid rule program"));
+      return false;
+    }
+    // Every piece must carry at least one program byte or the loop below never advances
+    static_assert(Traits::maxPayload > internal::RuleUpload::HeaderLength(), "Rule upload pieces need room for program bytes");
+    constexpr size_t pieceCapacity = Traits::maxPayload - internal::RuleUpload::HeaderLength();
+    uint8_t data[Traits::maxPayload];
+    uint8_t offset = 0;
+    // An empty program still sends one piece, which unloads the receiver's
+    do {
+      const uint8_t remaining = static_cast<uint8_t>(length - offset);
+      const uint8_t pieceLength = static_cast<uint8_t>((remaining > pieceCapacity) ? pieceCapacity : remaining);
+      data[0] = internal::RuleUpload::HeaderCode();
+      data[1] = gamepadIndex;
+      data[2] = offset;
+      data[3] = length;
+      if (pieceLength > 0) {
+        internal::CopyBytes(&data[internal::RuleUpload::HeaderLength()], &code[offset], pieceLength);
+      }
+      const size_t payloadLength = internal::RuleUpload::HeaderLength() + pieceLength;
+      if (!SendSerial(data, payloadLength)) {
+        return false;
+      }
+      ReserveLink(payloadLength);
+      offset = static_cast<uint8_t>(offset + pieceLength);
+    } while (offset < length);
+    return true;
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetStatusFormat(StatusFormat format) noexcept {
+    m_statusFormat = format;
+  }
+
+  template<typename Traits>
+  StatusFormat BasicGamepadLink<Traits>::GetStatusFormat() const noexcept {
+    return m_statusFormat;
+  }
+
+  // ------------------- serial ingest -------------------
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::ParseSerial(const uint8_t* data, size_t length) noexcept {
+    internal::Command command{};
+    if(!command.Deserialize(data, length)) {
+      Log(F("Invalid Command Payload"));
+      return;
+    }
+    OutputGroup group;
+    if (internal::Command::FindOutputGroup(command.GetOpCode(), group) && !Profile::Has(group)) {
+      Log(F("Command output not in gamepad profile"));
+      return;
+    }
+    ApplyCommand(command);
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::ApplyCommand(const internal::Command& command) {
+    const internal::Command::Target target = command.GetTarget();
+    const bool targetAll = target.IsAll();
+    if(!targetAll && target.GetValue() >= GetGamepadCount()) {
+      Log(F("Invalid Command Target"));
+      return;
+    }
+    const internal::Command::OpCode& opCode = command.GetOpCode();
+    const internal::Command::Output& output = command.GetOutput();
+    const bool outputAll = output.IsAll();
+    const internal::Command::AppliedParameters& parameters = command.GetParameters();
+    
+    switch(opCode) {
+      case internal::Command::OpCode::Disconnect: {
+        if (targetAll) {
+          DisconnectAllGamepads();
+        } else {
+          Disconnect(target.GetValue());
+        }
+        break;
+      }
+
+      case internal::Command::OpCode::RumbleStart: {
+        const uint8_t force = parameters.rumble.force;
+        const uint8_t duration = parameters.rumble.duration;
+        if (outputAll) {
+          if (targetAll) {
+            StartRumbleForAllGamepads(force, duration);
+          } else {
+            StartRumble(target.GetValue(), force, duration);
+          }
+        } else {
+          const RumbleID rumbleID = static_cast<RumbleID>(output.GetValue());
+          if (targetAll) {
+            StartRumbleForAllGamepads(rumbleID, force, duration);
+          } else {
+            StartRumble(target.GetValue(), rumbleID, force, duration);
+          }
+        }
+        break;
+      }
+
+      case internal::Command::OpCode::RumbleStop: {
+        if (outputAll) {
+          if (targetAll) {
+            StopRumbleForAllGamepads();
+          } else {
+            StopRumble(target.GetValue());
+          }
+        } else {
+          const RumbleID rumbleID = static_cast<RumbleID>(output.GetValue());
+          if (targetAll) {
+            StopRumbleForAllGamepads(rumbleID);
+          } else {
+            StopRumble(target.GetValue(), rumbleID);
+          }
+        }
+        break;
+      }
+
+      case internal::Command::OpCode::PlayerLedSet: {
+        const bool illuminated = internal::Uint8ToBool(parameters.ledSet.illuminated);
+        if (outputAll) {
+          if (targetAll) {
+            SetPlayerLedsForAllGamepads(illuminated);
+          } else {
+            SetPlayerLeds(target.GetValue(), illuminated);
+          }
+        } else {
+          const PlayerLedID playerLedID = static_cast<PlayerLedID>(output.GetValue());
+          if (targetAll) {
+            SetPlayerLedForAllGamepads(playerLedID, illuminated);
+          } else {
+            SetPlayerLed(target.GetValue(), playerLedID, illuminated);
+          }
+        }
+        break;
+      }
+
+      case internal::Command::OpCode::PlayerLedToggle: {
+        if (outputAll) {
+          if (targetAll) {
+            TogglePlayerLedsForAllGamepads();
+          } else {
+            TogglePlayerLeds(target.GetValue());
+          }
+        } else {
+          const PlayerLedID playerLedID = static_cast<PlayerLedID>(output.GetValue());
+          if (targetAll) {
+            TogglePlayerLedForAllGamepads(playerLedID);
+          } else {
+            TogglePlayerLed(target.GetValue(), playerLedID);
+          }
+        }
+        break;
+      }
+
+      case internal::Command::OpCode::PlayerLedsSetMask: {
+        const uint8_t mask = parameters.ledsMask.mask;
+        if (targetAll) {
+          SetPlayerLedsForAllGamepads(mask);
+        } else {
+          SetPlayerLeds(target.GetValue(), mask);
+        }
+        break;
+      }
+
+      case internal::Command::OpCode::PlayerLedsToggleMask: {
+        const uint8_t mask = parameters.ledsMask.mask;
+        if (targetAll) {
+          TogglePlayerLedsForAllGamepads(mask);
+        } else {
+          TogglePlayerLeds(target.GetValue(), mask);
+        }
+        break;
+      }
+
+      case internal::Command::OpCode::ColorLedSet: {
+        const bool illuminated = internal::Uint8ToBool(parameters.ledSet.illuminated);
+        if (outputAll) {
+          if (targetAll) {
+            SetColorLedsForAllGamepads(illuminated);
+          } else {
+            SetColorLeds(target.GetValue(), illuminated);
+          }
+        } else {
+          const ColorLedID colorLedID = static_cast<ColorLedID>(output.GetValue());
+          if (targetAll) {
+            SetColorLedForAllGamepads(colorLedID, illuminated);
+          } else {
+            SetColorLed(target.GetValue(), colorLedID, illuminated);
+          }
+        }
+        break;
+      }
+
+      case internal::Command::OpCode::ColorLedSetColor: {
+        const bool illuminated = internal::Uint8ToBool(parameters.ledSetColor.illuminated);
+        const uint8_t red   = parameters.ledSetColor.red;
+        const uint8_t green = parameters.ledSetColor.green;
+        const uint8_t blue  = parameters.ledSetColor.blue;
+        if (outputAll) {
+          if (targetAll) {
+            SetColorLedsForAllGamepads(illuminated, red, green, blue);
+          } else {
+            SetColorLeds(target.GetValue(), illuminated, red, green, blue);
+          }
+        } else {
+          const ColorLedID colorLedID = static_cast<ColorLedID>(output.GetValue());
+          if (targetAll) {
+            SetColorLedForAllGamepads(colorLedID, illuminated, red, green, blue);
+          } else {
+            SetColorLed(target.GetValue(), colorLedID, illuminated, red, green, blue);
+          }
+        }
+        break;
+      }
+
+      case internal::Command::OpCode::ColorLedToggle: {
+        if (outputAll) {
+          if (targetAll) {
+            ToggleColorLedsForAllGamepads();
+          } else {
+            ToggleColorLeds(target.GetValue());
+          }
+        } else {
+          const ColorLedID colorLedID = static_cast<ColorLedID>(output.GetValue());
+          if (targetAll) {
+            ToggleColorLedForAllGamepads(colorLedID);
+          } else {
+            ToggleColorLed(target.GetValue(), colorLedID);
+          }
+        }
+        break;
+      }
+
+      case internal::Command::OpCode::InputFilter: {
+        if (targetAll) {
+          for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+            ApplyInputFilter(gamepadIndex, parameters.inputFilter);
+          }
+        } else {
+          ApplyInputFilter(target.GetValue(), parameters.inputFilter);
+        }
+        break;
+      }
+
+      default: {
+        Log(F("Invalid Command Op Code"));
+        break;
+      }
+    }
+  }
+
+  // Tolerances pushed by the ApplicationLink; changes below them never mark the gamepad changed
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::ApplyInputFilter(uint8_t gamepadIndex, const internal::Command::Parameters::InputFilter& filter) noexcept {
+    const InputGroup group = static_cast<InputGroup>(filter.group);
+    if (!IsValid(group) || !Profile::Has(group)) {
+      Log(F("Input filter group not in gamepad profile"));
+      return;
+    }
+    Gamepad& gamepad = GetGamepad(gamepadIndex);
+    for (uint8_t axis = 0; axis < 3; ++axis) {
+      const uint16_t tolerance = filter.GetTolerance(axis);
+      if (tolerance != 0) {
+        gamepad.SetFilter(group, filter.input, axis, tolerance, filter.GetDeadzone());
+      }
+    }
+  }
+
+  // ──────────────────────────────
+  // COMMANDS
+  // ──────────────────────────────
+  // All outputs on all gamepads
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::DisconnectAllGamepads() noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      Disconnect(gamepadIndex);
+    }
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::StartRumbleForAllGamepads(uint8_t force, uint8_t duration) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      StartRumble(gamepadIndex, force, duration);
+    }
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::StopRumbleForAllGamepads() noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      StopRumble(gamepadIndex);
+    }
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetPlayerLedsForAllGamepads(bool illuminated) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      SetPlayerLeds(gamepadIndex, illuminated);
+    }
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetPlayerLedsForAllGamepads(uint8_t mask) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      SetPlayerLeds(gamepadIndex, mask);
+    }
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::TogglePlayerLedsForAllGamepads() noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      TogglePlayerLeds(gamepadIndex);
+    }
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::TogglePlayerLedsForAllGamepads(uint8_t mask) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      TogglePlayerLeds(gamepadIndex, mask);
+    }
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetColorLedsForAllGamepads(bool illuminated) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      SetColorLeds(gamepadIndex, illuminated);
+    }
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetColorLedsForAllGamepads(bool illuminated, uint8_t red, uint8_t green, uint8_t blue) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      SetColorLeds(gamepadIndex, illuminated, red, green, blue);
+    }
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::ToggleColorLedsForAllGamepads() noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      ToggleColorLeds(gamepadIndex);
+    }
+  }
+
+  // One output on all gamepads
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::StartRumbleForAllGamepads(RumbleID rumbleID, uint8_t force, uint8_t duration) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      StartRumble(gamepadIndex, rumbleID, force, duration);
+    }
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::StopRumbleForAllGamepads(RumbleID rumbleID) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      StopRumble(gamepadIndex, rumbleID);
+    }
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetPlayerLedForAllGamepads(PlayerLedID playerLedID, bool illuminated) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      SetPlayerLed(gamepadIndex, playerLedID, illuminated);
+    }
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::TogglePlayerLedForAllGamepads(PlayerLedID playerLedID) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      TogglePlayerLed(gamepadIndex, playerLedID);
+    }
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetColorLedForAllGamepads(ColorLedID colorLedID, bool illuminated) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      SetColorLed(gamepadIndex, colorLedID, illuminated);
+    }
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetColorLedForAllGamepads(ColorLedID colorLedID, bool illuminated, uint8_t red, uint8_t green, uint8_t blue) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      SetColorLed(gamepadIndex, colorLedID, illuminated, red, green, blue);
+    }
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::ToggleColorLedForAllGamepads(ColorLedID colorLedID) noexcept {
+    for (uint8_t gamepadIndex = 0; gamepadIndex < GetGamepadCount(); ++gamepadIndex) {
+      ToggleColorLed(gamepadIndex, colorLedID);
+    }
+  }
+
+  // All outputs on one gamepad
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::Disconnect(uint8_t gamepadIndex) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      Log(F("Disconnect: bad gamepad index"));
+      return;
+    }
+    GetGamepad(gamepadIndex).SetDisconnect();
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::StartRumble(uint8_t gamepadIndex, uint8_t force, uint8_t duration) noexcept {
+    for (uint8_t i = 0; i < RumbleCount(); ++i) {
+      StartRumble(gamepadIndex, static_cast<RumbleID>(i), force, duration);
+    }
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::StopRumble(uint8_t gamepadIndex) noexcept {
+    for (uint8_t i = 0; i < RumbleCount(); ++i) {
+      StopRumble(gamepadIndex, static_cast<RumbleID>(i));
+    }
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetPlayerLeds(uint8_t gamepadIndex, bool illuminated) noexcept {
+    for (uint8_t i = 0; i < PlayerLedCount(); ++i) {
+      SetPlayerLed(gamepadIndex, static_cast<PlayerLedID>(i), illuminated);
+    }
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetPlayerLeds(uint8_t gamepadIndex, uint8_t mask) noexcept {
+    const uint8_t validLeds = (PlayerLedCount() < 8) ? PlayerLedCount() : 8;
+    for (uint8_t i = 0; i < validLeds; ++i) {
+      const bool illuminated = ((mask >> i) & 0x1u) != 0;
+      SetPlayerLed(gamepadIndex, static_cast<PlayerLedID>(i), illuminated);
+    }
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::TogglePlayerLeds(uint8_t gamepadIndex) noexcept {
+    for (uint8_t i = 0; i < PlayerLedCount(); ++i) {
+      TogglePlayerLed(gamepadIndex, static_cast<PlayerLedID>(i));
+    }
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::TogglePlayerLeds(uint8_t gamepadIndex, uint8_t mask) noexcept {
+    const uint8_t validLeds = (PlayerLedCount() < 8) ? PlayerLedCount() : 8;
+    for (uint8_t i = 0; i < validLeds; ++i) {
+      if ((mask >> i) & 0x1u) {
+        TogglePlayerLed(gamepadIndex, static_cast<PlayerLedID>(i));
+      }
+    }
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetColorLeds(uint8_t gamepadIndex, bool illuminated) noexcept {
+    for (uint8_t i = 0; i < ColorLedCount(); ++i) {
+      SetColorLed(gamepadIndex, static_cast<ColorLedID>(i), illuminated);
+    }
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetColorLeds(uint8_t gamepadIndex, bool illuminated, uint8_t red, uint8_t green, uint8_t blue) noexcept {
+    for (uint8_t i = 0; i < ColorLedCount(); ++i) {
+      SetColorLed(gamepadIndex, static_cast<ColorLedID>(i), illuminated, red, green, blue);
+    }
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::ToggleColorLeds(uint8_t gamepadIndex) noexcept {
+    for (uint8_t i = 0; i < ColorLedCount(); ++i) {
+      ToggleColorLed(gamepadIndex, static_cast<ColorLedID>(i));
+    }
+  }
+
+  // One output on one gamepad
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::StartRumble(uint8_t gamepadIndex, RumbleID rumbleID, uint8_t force, uint8_t duration) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      Log(F("StartRumble: bad gamepad index"));
+      return;
+    }
+    GetGamepad(gamepadIndex).SetRumble(rumbleID, force, duration);
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::StopRumble(uint8_t gamepadIndex, RumbleID rumbleID) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      Log(F("StopRumble: bad gamepad index"));
+      return;
+    }
+    GetGamepad(gamepadIndex).SetRumble(rumbleID, 0, 0);
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetPlayerLed(uint8_t gamepadIndex, PlayerLedID playerLedID, bool illuminated) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      Log(F("SetPlayerLed: bad gamepad index"));
+      return;
+    }
+    GetGamepad(gamepadIndex).SetPlayerLed(playerLedID, illuminated);
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::TogglePlayerLed(uint8_t gamepadIndex, PlayerLedID playerLedID) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      Log(F("TogglePlayerLed: bad gamepad index"));
+      return;
+    }
+    GetGamepad(gamepadIndex).TogglePlayerLed(playerLedID);
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetColorLed(uint8_t gamepadIndex, ColorLedID colorLedID, bool illuminated) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      Log(F("SetColorLed: bad gamepad index"));
+      return;
+    }
+    Gamepad& gamepad = GetGamepad(gamepadIndex);
+    Color color = gamepad.GetColorLedColor(colorLedID);
+    gamepad.SetColorLed(colorLedID, illuminated, color);
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::SetColorLed(uint8_t gamepadIndex, ColorLedID colorLedID, bool illuminated, uint8_t red, uint8_t green, uint8_t blue) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      Log(F("SetColorLed: bad gamepad index"));
+      return;
+    }
+    Color color;
+    color.red = red;
+    color.green = green;
+    color.blue = blue;
+    GetGamepad(gamepadIndex).SetColorLed(colorLedID, illuminated, color);
+  }
+
+  template<typename Traits>
+  void BasicGamepadLink<Traits>::ToggleColorLed(uint8_t gamepadIndex, ColorLedID colorLedID) noexcept {
+    if (gamepadIndex >= GetGamepadCount()) {
+      Log(F("ToggleColorLed: bad gamepad index"));
+      return;
+    }
+    GetGamepad(gamepadIndex).ToggleColorLed(colorLedID);
+  }
+} // namespace GSB
\ No newline at end of file
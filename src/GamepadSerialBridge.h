@@ -4,5 +4,7 @@
 #include "Mappings/Mappings.h"
 #include "UartConfig.h"
 #include "LinkConfig.h"
+#include "LinkTiming.h"
+#include "LinkTraits.h"
 #include "ApplicationLink.h"
 #include "GamepadLink.h"
\ No newline at end of file
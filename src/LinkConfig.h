@@ -7,10 +7,10 @@ namespace GSB {
   namespace internal {
     struct NullPrint final : Print {
       public:
-      size_t write(uint8_t byte) override noexcept {
+      size_t write(uint8_t byte) noexcept override {
         return 1;
       }
-      size_t write(const uint8_t* bytes, size_t byteCount) override noexcept {
+      size_t write(const uint8_t* bytes, size_t byteCount) noexcept override {
         return byteCount;
       }
       static NullPrint& GetInstance() noexcept {
@@ -24,10 +24,23 @@ namespace GSB {
     };
   } // namespace internal
 
+  enum class RxMode : uint8_t {
+    SERIAL_POLL, // Loop reads linkSerial directly
+    ISR_RING,    // bytes arrive through LinkBase::ReceiveByteFromISR
+  };
+
+  // Status frame encoding used by the sender; receivers accept both
+  enum class StatusFormat : uint8_t {
+    FIXED,  // byte-aligned little-endian fields (readable in raw dumps)
+    PACKED, // each field at its declared bit width
+  };
+
   struct LinkConfig {
     uint8_t gamepadCount{1};
     UartConfig uartConfig{};
     HardwareSerial& linkSerial;
     Print& logSerial = internal::NullPrint::GetInstance();
+    RxMode rxMode{RxMode::SERIAL_POLL};
+    StatusFormat statusFormat{StatusFormat::FIXED};
   };
 } // namespace GSB
\ No newline at end of file
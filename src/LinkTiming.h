@@ -0,0 +1,45 @@
+#pragma once
+
+#include <Arduino.h>
+
+namespace GSB {
+  enum class LinkPhase : uint8_t {
+    RX_INGEST,
+    FRAME_DISPATCH,
+    SERVICE, // link-specific periodic work (e.g. the GamepadLink status scheduler)
+    TX_PUMP,
+    COUNT
+  };
+
+  constexpr uint8_t LinkPhaseCount() noexcept {
+    return static_cast<uint8_t>(LinkPhase::COUNT);
+  }
+
+  constexpr uint8_t LinkPhaseIndex(LinkPhase phase) noexcept {
+    return (static_cast<uint8_t>(phase) < LinkPhaseCount()) ? static_cast<uint8_t>(phase) : LinkPhaseCount();
+  }
+
+  // Duration statistics for one Loop phase, in microseconds.
+  // averageMicros is an exponential moving average weighted 1/8 per sample.
+  struct PhaseTiming {
+    unsigned long lastMicros{0};
+    unsigned long maxMicros{0};
+    unsigned long averageMicros{0};
+    uint32_t samples{0};
+
+    void Record(unsigned long elapsedMicros) noexcept {
+      lastMicros = elapsedMicros;
+      if (elapsedMicros > maxMicros) {
+        maxMicros = elapsedMicros;
+      }
+      if (samples == 0) {
+        averageMicros = elapsedMicros;
+      } else if (elapsedMicros >= averageMicros) {
+        averageMicros += (elapsedMicros - averageMicros) >> 3;
+      } else {
+        averageMicros -= (averageMicros - elapsedMicros) >> 3;
+      }
+      ++samples;
+    }
+  };
+} // namespace GSB
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Gamepad/GamepadProfile.h"
+
+namespace GSB {
+  // Compile-time sizing for a link. Every buffer below is a member array, so these
+  // values directly set the RAM a link instance costs (see LinkBase::ReportFootprint).
+  template<
+    uint8_t MaxGamepads = 4,
+    size_t MaxPayload = 64,
+    uint8_t RxFrameDepth = 2,
+    uint8_t TxFrameDepth = 2,
+    uint8_t EventQueueDepth = 48,
+    uint16_t RxRingSize = 256,
+    typename Profile = FullProfile,
+    uint8_t ButtonTimers = 8,
+    bool SensorBatching = Profile::Has(InputGroup::SENSORS)
+  >
+  struct LinkTraits {
+    // Gamepad objects allocated per link
+    static constexpr uint8_t maxGamepads = MaxGamepads;
+    // Largest payload (status or command) a frame may carry
+    static constexpr size_t maxPayload = MaxPayload;
+    // Complete received frames buffered between ingest and dispatch
+    static constexpr uint8_t rxFrameDepth = RxFrameDepth;
+    // Encoded frames the TX ring can hold while the UART drains
+    static constexpr uint8_t txFrameDepth = TxFrameDepth;
+    // ApplicationLink event queue slots (0 removes the queue)
+    static constexpr uint8_t eventQueueDepth = EventQueueDepth;
+    // RxMode::ISR_RING buffer bytes, power of two up to 256 (0 removes the ring)
+    static constexpr uint16_t rxRingSize = RxRingSize;
+    // Input/output groups every gamepad on this link carries
+    using GamepadProfile = Profile;
+    // ApplicationLink (gamepad, button) pairs with gesture timing (0 removes it)
+    static constexpr uint8_t buttonTimers = ButtonTimers;
+    // GamepadLink sensor batch buffers, one message per gamepad, and the ApplicationLink
+    // samples held for queued batch callbacks, a quarter of eventQueueDepth (false removes them)
+    static constexpr bool sensorBatching = SensorBatching;
+
+    static_assert(MaxGamepads > 0, "At least one gamepad is required");
+    static_assert(MaxPayload > 0 && MaxPayload <= 250, "Payload must fit a single COBS block");
+    static_assert(RxFrameDepth > 0, "At least one RX frame slot is required");
+    static_assert(TxFrameDepth > 0, "At least one TX frame is required");
+  };
+
+  using DefaultLinkTraits = LinkTraits<>;
+} // namespace GSB
@@ -3,6 +3,7 @@
 
 #include "Gamepad/InputIDs.h"
 #include "Gamepad/OutputIDs.h"
+#include "Gamepad/GamepadProfile.h"
 
 namespace GSB {
   namespace Xbox {
@@ -66,5 +67,12 @@ namespace GSB {
     //   static constexpr SensorID ACCELEROMETER = SensorID::SENSOR_2;
     // }
 
+    // ---- Capability profile: no sensors, no color LED ----
+    // e.g. BasicGamepadLink<LinkTraits<4, 64, 2, 2, 32, 256, Xbox::Profile>>
+    using Profile = GamepadProfile<
+      InputGroupMask(InputGroup::BUTTONS) | InputGroupMask(InputGroup::JOYSTICKS) | InputGroupMask(InputGroup::TRIGGERS) | InputGroupMask(InputGroup::BATTERY),
+      OutputGroupMask(OutputGroup::RUMBLE) | OutputGroupMask(OutputGroup::PLAYER_LEDS)
+    >;
+
   } // namespace Xbox
 } // namespace GSB
\ No newline at end of file
@@ -51,6 +51,11 @@ namespace GSB {
       return static_cast<unsigned long>(baudRate);
     }
 
+    // Bits on the wire per character: start + data + parity + stop
+    uint8_t GetCharacterBits() const {
+      return static_cast<uint8_t>(1 + static_cast<uint8_t>(dataBits) + (parityBits == ParityBits::PARITY_NONE ? 0 : 1) + static_cast<uint8_t>(stopBits));
+    }
+
     // Lookup Arduino SERIAL_* config constant
     int GetSerialConfig() const {
       struct Entry {
@@ -0,0 +1,333 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Gamepad/ButtonGestures.h"
+#include "Gamepad/InputIDs.h"
+
+namespace GSB {
+  namespace internal {
+    struct ButtonTimerEvent {
+      uint8_t gamepadIndex;
+      ButtonID buttonID;
+      ButtonGesture gesture;
+    };
+
+    // Gesture timing for subscribed (gamepad, button) pairs. Each pair keeps one pending
+    // deadline on a hashed timer wheel: the deadline tick picks the slot, and Expire only
+    // walks the slots whose tick has passed, so the cost follows pending timers rather
+    // than every button on every gamepad. Deadlines further out than one revolution stay
+    // in their slot and are skipped until due.
+    // Storage is supplied by ButtonTimersStorage so Gamepad can hold a size-agnostic pointer.
+    class ButtonTimers {
+      public:
+        static constexpr uint8_t SlotCount() noexcept {
+          return s_slotCount;
+        }
+
+        // gestures is a ButtonGestureMask set; 0 stops tracking the button.
+        // False when every entry is already in use.
+        bool Subscribe(uint8_t gamepadIndex, ButtonID buttonID, uint8_t gestures) noexcept {
+          if (!IsValid(buttonID)) {
+            return false;
+          }
+          uint8_t index = Find(gamepadIndex, buttonID);
+          if (index == s_none) {
+            if (gestures == 0) {
+              return true;
+            }
+            index = Find(0, ButtonID::COUNT);
+            if (index == s_none) {
+              return false;
+            }
+            Entry& entry = m_entries[index];
+            entry = Entry{};
+            entry.gamepadIndex = gamepadIndex;
+            entry.buttonID = static_cast<uint8_t>(buttonID);
+            ++m_count;
+          }
+          Unschedule(index);
+          Entry& entry = m_entries[index];
+          if (gestures == 0) {
+            entry.buttonID = static_cast<uint8_t>(ButtonID::COUNT);
+            entry.gamepadIndex = 0;
+            --m_count;
+          }
+          entry.gestures = static_cast<uint8_t>(gestures & AllButtonGesturesMask());
+          entry.flags = 0;
+          return true;
+        }
+
+        uint8_t GetGestures(uint8_t gamepadIndex, ButtonID buttonID) const noexcept {
+          const uint8_t index = Find(gamepadIndex, buttonID);
+          return (index == s_none) ? 0 : m_entries[index].gestures;
+        }
+
+        void SetTiming(const ButtonTiming& timing) noexcept {
+          m_timing = timing;
+        }
+
+        const ButtonTiming& GetTiming() const noexcept {
+          return m_timing;
+        }
+
+        uint8_t GetCapacity() const noexcept {
+          return m_capacity;
+        }
+
+        uint8_t GetCount() const noexcept {
+          return m_count;
+        }
+
+        // Press/release edge of a button; returns DOUBLE_TAP when this press completes one,
+        // COUNT otherwise (including for buttons that are not subscribed)
+        ButtonGesture OnButton(uint8_t gamepadIndex, ButtonID buttonID, bool pressed, unsigned long nowMillis) noexcept {
+          const uint8_t index = Find(gamepadIndex, buttonID);
+          if (index == s_none) {
+            return ButtonGesture::COUNT;
+          }
+          const uint16_t now = Start(nowMillis);
+          Unschedule(index);
+          Entry& entry = m_entries[index];
+          ButtonGesture result = ButtonGesture::COUNT;
+          if (pressed) {
+            const bool tapped = (entry.flags & s_tapArmed) && Elapsed(entry.edgeTick, now) <= Ticks(m_timing.doubleTapMillis);
+            if (tapped && (entry.gestures & ButtonGestureMask(ButtonGesture::DOUBLE_TAP))) {
+              result = ButtonGesture::DOUBLE_TAP;
+            }
+            entry.flags = s_pressed;
+            // The second press of a double tap does not start another one
+            if (tapped) {
+              entry.flags = static_cast<uint8_t>(entry.flags | s_doubleTapped);
+            }
+            entry.edgeTick = now;
+            entry.repeatTick = static_cast<uint16_t>(now + Ticks(m_timing.repeatDelayMillis));
+          } else {
+            const bool shortPress = !(entry.flags & (s_holdSent | s_longSent | s_doubleTapped)) && Elapsed(entry.edgeTick, now) <= Ticks(m_timing.holdMillis);
+            entry.flags = 0;
+            if (shortPress && (entry.gestures & ButtonGestureMask(ButtonGesture::DOUBLE_TAP))) {
+              entry.flags = s_tapArmed;
+            }
+            entry.edgeTick = now;
+          }
+          Schedule(index);
+          return result;
+        }
+
+        // Pops the next gesture that is due at nowMillis; false when nothing is due
+        bool Expire(unsigned long nowMillis, ButtonTimerEvent& event) noexcept {
+          if (m_count == 0) {
+            return false;
+          }
+          const uint16_t now = Start(nowMillis);
+          // After a long stall one revolution still visits every slot
+          if (Elapsed(m_cursor, now) > SlotCount()) {
+            m_cursor = static_cast<uint16_t>(now - SlotCount());
+          }
+          while (true) {
+            uint8_t* link = &m_slots[m_cursor % SlotCount()];
+            while (*link != s_none) {
+              const uint8_t index = *link;
+              Entry& entry = m_entries[index];
+              if (static_cast<int16_t>(entry.deadline - now) > 0) {
+                link = &entry.next;
+                continue;
+              }
+              *link = entry.next;
+              entry.slot = s_none;
+              const ButtonGesture gesture = Fire(entry, now);
+              Schedule(index);
+              if (gesture != ButtonGesture::COUNT) {
+                event.gamepadIndex = entry.gamepadIndex;
+                event.buttonID = static_cast<ButtonID>(entry.buttonID);
+                event.gesture = gesture;
+                return true;
+              }
+            }
+            if (m_cursor == now) {
+              return false;
+            }
+            ++m_cursor;
+          }
+        }
+
+      protected:
+        struct Entry {
+          uint8_t gamepadIndex{0};
+          uint8_t buttonID{static_cast<uint8_t>(ButtonID::COUNT)}; // COUNT marks a free entry
+          uint8_t gestures{0};
+          uint8_t flags{0};
+          uint16_t edgeTick{0};   // last press, or last release while a tap is armed
+          uint16_t repeatTick{0}; // next REPEAT
+          uint16_t deadline{0};
+          uint8_t slot{0xFF};
+          uint8_t next{0xFF};
+        };
+
+        ButtonTimers(Entry* entries, uint8_t capacity) noexcept
+          : m_entries(entries),
+            m_capacity(capacity) {
+          for (uint8_t i = 0; i < SlotCount(); ++i) {
+            m_slots[i] = s_none;
+          }
+        }
+        ButtonTimers(const ButtonTimers&) = delete;
+        ButtonTimers& operator=(const ButtonTimers&) = delete;
+
+      private:
+        static constexpr uint8_t s_slotCount = 16;
+        static constexpr uint8_t s_none = 0xFF;
+        static constexpr uint8_t s_pressed = 0x01;
+        static constexpr uint8_t s_holdSent = 0x02;
+        static constexpr uint8_t s_longSent = 0x04;
+        static constexpr uint8_t s_tapArmed = 0x08;
+        static constexpr uint8_t s_doubleTapped = 0x10;
+
+        static uint16_t Ticks(uint16_t millis) noexcept {
+          const uint16_t ticks = static_cast<uint16_t>((static_cast<uint32_t>(millis) + ButtonTiming::TickMillis() - 1) >> ButtonTiming::TickShift());
+          return (ticks == 0) ? 1 : ticks;
+        }
+
+        static uint16_t Elapsed(uint16_t from, uint16_t to) noexcept {
+          return static_cast<uint16_t>(to - from);
+        }
+
+        // Current tick; the wheel cursor starts at the first tick it sees
+        uint16_t Start(unsigned long nowMillis) noexcept {
+          const uint16_t now = static_cast<uint16_t>(nowMillis >> ButtonTiming::TickShift());
+          if (!m_started) {
+            m_cursor = now;
+            m_started = true;
+          }
+          return now;
+        }
+
+        uint8_t Find(uint8_t gamepadIndex, ButtonID buttonID) const noexcept {
+          for (uint8_t i = 0; i < m_capacity; ++i) {
+            if (m_entries[i].buttonID == static_cast<uint8_t>(buttonID) && m_entries[i].gamepadIndex == gamepadIndex) {
+              return i;
+            }
+          }
+          return s_none;
+        }
+
+        // Earliest pending deadline of an entry; gesture is COUNT for the end of a tap window
+        bool NextDeadline(const Entry& entry, ButtonGesture& gesture, uint16_t& deadline) const noexcept {
+          if (!(entry.flags & s_pressed)) {
+            if (!(entry.flags & s_tapArmed)) {
+              return false;
+            }
+            gesture = ButtonGesture::COUNT;
+            deadline = static_cast<uint16_t>(entry.edgeTick + Ticks(m_timing.doubleTapMillis) + 1);
+            return true;
+          }
+          bool found = false;
+          if ((entry.gestures & ButtonGestureMask(ButtonGesture::HOLD)) && !(entry.flags & s_holdSent)) {
+            KeepEarliest(entry.edgeTick, ButtonGesture::HOLD, static_cast<uint16_t>(entry.edgeTick + Ticks(m_timing.holdMillis)), found, gesture, deadline);
+          }
+          if ((entry.gestures & ButtonGestureMask(ButtonGesture::LONG_PRESS)) && !(entry.flags & s_longSent)) {
+            KeepEarliest(entry.edgeTick, ButtonGesture::LONG_PRESS, static_cast<uint16_t>(entry.edgeTick + Ticks(m_timing.longPressMillis)), found, gesture, deadline);
+          }
+          if (entry.gestures & ButtonGestureMask(ButtonGesture::REPEAT)) {
+            KeepEarliest(entry.edgeTick, ButtonGesture::REPEAT, entry.repeatTick, found, gesture, deadline);
+          }
+          return found;
+        }
+
+        static void KeepEarliest(uint16_t origin, ButtonGesture candidate, uint16_t tick, bool& found, ButtonGesture& gesture, uint16_t& deadline) noexcept {
+          if (!found || Elapsed(origin, tick) < Elapsed(origin, deadline)) {
+            found = true;
+            gesture = candidate;
+            deadline = tick;
+          }
+        }
+
+        // Marks the due gesture as delivered and returns it
+        ButtonGesture Fire(Entry& entry, uint16_t now) noexcept {
+          ButtonGesture gesture = ButtonGesture::COUNT;
+          uint16_t deadline = 0;
+          if (!NextDeadline(entry, gesture, deadline)) {
+            return ButtonGesture::COUNT;
+          }
+          switch (gesture) {
+            case ButtonGesture::HOLD: {
+              entry.flags = static_cast<uint8_t>(entry.flags | s_holdSent);
+              break;
+            }
+            case ButtonGesture::LONG_PRESS: {
+              entry.flags = static_cast<uint8_t>(entry.flags | s_longSent);
+              break;
+            }
+            case ButtonGesture::REPEAT: {
+              // Repeats missed during a stall are dropped rather than delivered in a burst
+              do {
+                entry.repeatTick = static_cast<uint16_t>(entry.repeatTick + Ticks(m_timing.repeatIntervalMillis));
+              } while (static_cast<int16_t>(entry.repeatTick - now) <= 0);
+              break;
+            }
+            default: {
+              entry.flags = static_cast<uint8_t>(entry.flags & ~s_tapArmed);
+              break;
+            }
+          }
+          return gesture;
+        }
+
+        void Schedule(uint8_t index) noexcept {
+          Entry& entry = m_entries[index];
+          ButtonGesture gesture = ButtonGesture::COUNT;
+          if (!NextDeadline(entry, gesture, entry.deadline)) {
+            return;
+          }
+          // Overdue deadlines go in the cursor's slot so the next Expire sees them
+          const uint16_t tick = (static_cast<int16_t>(entry.deadline - m_cursor) <= 0) ? m_cursor : entry.deadline;
+          entry.slot = static_cast<uint8_t>(tick % SlotCount());
+          entry.next = m_slots[entry.slot];
+          m_slots[entry.slot] = index;
+        }
+
+        void Unschedule(uint8_t index) noexcept {
+          Entry& entry = m_entries[index];
+          if (entry.slot == s_none) {
+            return;
+          }
+          uint8_t* link = &m_slots[entry.slot];
+          while (*link != s_none && *link != index) {
+            link = &m_entries[*link].next;
+          }
+          if (*link == index) {
+            *link = entry.next;
+          }
+          entry.slot = s_none;
+        }
+
+        Entry* m_entries;
+        uint8_t m_capacity;
+        uint8_t m_count{0};
+        uint8_t m_slots[s_slotCount];
+        uint16_t m_cursor{0};
+        bool m_started{false};
+        ButtonTiming m_timing{};
+    };
+
+    template<uint8_t Capacity>
+    class ButtonTimersStorage : public ButtonTimers {
+      public:
+        ButtonTimersStorage() noexcept : ButtonTimers(m_storage, Capacity) {
+
+        }
+
+      private:
+        static_assert(Capacity < 0xFF, "Button timer capacity must leave room for the empty marker");
+        Entry m_storage[Capacity]{};
+    };
+
+    // Timing compiled out (Traits::buttonTimers == 0); never attached to a gamepad
+    template<>
+    class ButtonTimersStorage<0> : public ButtonTimers {
+      public:
+        ButtonTimersStorage() noexcept : ButtonTimers(nullptr, 0) {
+
+        }
+    };
+  } // namespace internal
+} // namespace GSB
@@ -2,6 +2,7 @@
 
 #include <Arduino.h>
 #include "internal/Utilities.h"
+#include "Gamepad/OutputIDs.h"
 
 namespace GSB {
   namespace internal {
@@ -23,7 +24,10 @@ namespace GSB {
         // Color LEDs
         ColorLedSet = 0x61, // params: illuminated(u8: 0/1)
         ColorLedSetColor = 0x62, // params: illuminated(u8: 0/1), r(u8), g(u8), b(u8)
-        ColorLedToggle = 0x63  // params: none
+        ColorLedToggle = 0x63, // params: none
+
+        // Input filters (sender side); output is None
+        InputFilter = 0x81 // params: group(u8), input(u8), toleranceX/Y/Z(u16 LE each), deadzone(u16 LE)
       };
 
       struct Target {
@@ -136,6 +140,39 @@ namespace GSB {
           uint8_t green;
           uint8_t blue;
         };
+
+        // Multi-byte values are stored little-endian so the layout is fixed on both MCUs
+        struct InputFilter {
+          uint8_t group;
+          uint8_t input;
+          uint8_t tolerances[3][2];
+          uint8_t deadzone[2];
+
+          void SetTolerance(uint8_t axis, uint16_t tolerance) noexcept {
+            WriteLE16(tolerances[axis], tolerance);
+          }
+
+          uint16_t GetTolerance(uint8_t axis) const noexcept {
+            return ReadLE16(tolerances[axis]);
+          }
+
+          void SetDeadzone(uint16_t value) noexcept {
+            WriteLE16(deadzone, value);
+          }
+
+          uint16_t GetDeadzone() const noexcept {
+            return ReadLE16(deadzone);
+          }
+        };
+      };
+
+      // Storage for whichever Parameters the op code carries
+      union AppliedParameters {
+        Parameters::Rumble rumble;
+        Parameters::LedSet ledSet;
+        Parameters::LedsMask ledsMask;
+        Parameters::LedSetColor ledSetColor;
+        Parameters::InputFilter inputFilter;
       };
 
       struct Build {
@@ -226,6 +263,15 @@ namespace GSB {
           command.m_output = output;
           return command;
         }
+
+        static Command InputFilter(Target target, Parameters::InputFilter parameters) noexcept {
+          Command command;
+          command.m_opCode = OpCode::InputFilter;
+          command.m_target = target;
+          command.m_output = Output::None();
+          command.m_parameters.inputFilter = parameters;
+          return command;
+        }
       };
 
       static constexpr size_t MaximumLength() noexcept {
@@ -248,6 +294,33 @@ namespace GSB {
         return m_parameters;
       }
 
+      // Output group an opcode drives; false for system opcodes that need none
+      static bool FindOutputGroup(OpCode opCode, OutputGroup& group) noexcept {
+        switch (opCode) {
+          case OpCode::RumbleStart:
+          case OpCode::RumbleStop: {
+            group = OutputGroup::RUMBLE;
+            return true;
+          }
+          case OpCode::PlayerLedSet:
+          case OpCode::PlayerLedToggle:
+          case OpCode::PlayerLedsSetMask:
+          case OpCode::PlayerLedsToggleMask: {
+            group = OutputGroup::PLAYER_LEDS;
+            return true;
+          }
+          case OpCode::ColorLedSet:
+          case OpCode::ColorLedSetColor:
+          case OpCode::ColorLedToggle: {
+            group = OutputGroup::COLOR_LEDS;
+            return true;
+          }
+          default: {
+            return false;
+          }
+        }
+      }
+
       size_t Serialize(uint8_t* data, size_t maxLength) const noexcept {
         if (!data) {
           return 0;
@@ -311,12 +384,7 @@ namespace GSB {
       OpCode m_opCode{OpCode::Disconnect};
       Target m_target{Target::All()};
       Output m_output{Output::None()};
-      union AppliedParameters {
-        Parameters::Rumble rumble;
-        Parameters::LedSet ledSet;
-        Parameters::LedsMask ledsMask;
-        Parameters::LedSetColor ledSetColor;
-      } m_parameters{};
+      AppliedParameters m_parameters{};
       
       static constexpr size_t ParameterLength(OpCode opCode) noexcept {
         switch (opCode) {
@@ -350,6 +418,9 @@ namespace GSB {
           case OpCode::ColorLedToggle: {
             return 0;
           }
+          case OpCode::InputFilter: {
+            return sizeof(Parameters::InputFilter);
+          }
         }
         return 0;
       }
@@ -378,6 +449,9 @@ namespace GSB {
           case OpCode::ColorLedSetColor: {
             return reinterpret_cast<uint8_t*>(&m_parameters.ledSetColor);
           }
+          case OpCode::InputFilter: {
+            return reinterpret_cast<uint8_t*>(&m_parameters.inputFilter);
+          }
           default: {
             return nullptr;
           }
@@ -389,5 +463,6 @@ namespace GSB {
     static_assert(sizeof(Command::Parameters::LedSet) == 1, "Parameters::LedSet must be 1 byte");
     static_assert(sizeof(Command::Parameters::LedsMask) == 1, "Parameters::LedsMask must be 1 byte");
     static_assert(sizeof(Command::Parameters::LedSetColor) == 4, "Parameters::LedSetColor must be 4 bytes");
+    static_assert(sizeof(Command::Parameters::InputFilter) == 10, "Parameters::InputFilter must be 10 bytes");
   } // namespace internal
 } // namespace GSB
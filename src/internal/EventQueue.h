@@ -0,0 +1,225 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Gamepad/InputIDs.h"
+
+namespace GSB {
+  namespace internal {
+    enum class EventType : uint8_t {
+      BUTTON_PRESS,
+      BUTTON_RELEASE,
+      TRIGGER,
+      JOYSTICK,
+      BATTERY,
+      SENSOR,
+      BUTTON_GESTURE, // values[0] is the ButtonGesture
+      COMBO,          // id is the combo's index in the recognizer's table
+      ORIENTATION,    // values are roll, pitch and yaw
+      SENSOR_BATCH    // the sample waits in the link's SensorSampleQueue
+    };
+
+    struct Event {
+      EventType type;
+      uint8_t gamepadIndex;
+      uint8_t id;
+      int16_t values[3];
+    };
+
+    // Fixed-capacity FIFO of input events.
+    // Value events (trigger/joystick/battery/sensor/orientation) coalesce by (gamepad, type, id):
+    // a newer value overwrites the queued one in place. Button edges, gestures and combos always append.
+    // Storage is supplied by EventQueueStorage so Gamepad can hold a size-agnostic pointer.
+    class EventQueue {
+      public:
+        // Worst case number of slots a single status frame can consume, counting the virtual
+        // button edges its stick and trigger values may raise. Links hold frames back until
+        // this many slots are free, so a frame's events always fit.
+        static constexpr uint8_t MaxEventsPerStatus() noexcept {
+          return ButtonCount() + s_valueKeysPerGamepad;
+        }
+
+        bool Push(const Event& event) noexcept {
+          // Derived events give way first, so the slots a status frame's own events are
+          // promised stay free for them
+          if (IsDerivedEvent(event.type) && GetFree() <= MaxEventsPerStatus()) {
+            ++m_overflowCount;
+            return false;
+          }
+          const bool coalesce = IsValueEvent(event.type);
+          uint8_t* pending = nullptr;
+          if (coalesce) {
+            pending = PendingSlot(event);
+            if (!pending) {
+              return false;
+            }
+            if (*pending != 0) {
+              m_slots[*pending - 1] = event;
+              ++m_coalescedCount;
+              return true;
+            }
+          }
+          if (m_count >= m_capacity) {
+            ++m_overflowCount;
+            return false;
+          }
+          uint8_t slot = static_cast<uint8_t>(m_head + m_count);
+          if (slot >= m_capacity) {
+            slot = static_cast<uint8_t>(slot - m_capacity);
+          }
+          m_slots[slot] = event;
+          ++m_count;
+          if (pending) {
+            *pending = static_cast<uint8_t>(slot + 1);
+          }
+          return true;
+        }
+
+        bool Pop(Event& event) noexcept {
+          if (m_count == 0) {
+            return false;
+          }
+          event = m_slots[m_head];
+          if (IsValueEvent(event.type)) {
+            uint8_t* pending = PendingSlot(event);
+            if (pending && *pending == m_head + 1) {
+              *pending = 0;
+            }
+          }
+          ++m_head;
+          if (m_head >= m_capacity) {
+            m_head = 0;
+          }
+          --m_count;
+          return true;
+        }
+
+        uint8_t GetCount() const noexcept {
+          return m_count;
+        }
+
+        uint8_t GetCapacity() const noexcept {
+          return m_capacity;
+        }
+
+        uint8_t GetFree() const noexcept {
+          return static_cast<uint8_t>(m_capacity - m_count);
+        }
+
+        uint16_t GetCoalescedCount() const noexcept {
+          return m_coalescedCount;
+        }
+
+        // Events dropped for lack of room. Backpressure keeps status events from ever counting
+        // here; only derived events (gestures, combos) can.
+        uint16_t GetOverflowCount() const noexcept {
+          return m_overflowCount;
+        }
+
+      protected:
+        EventQueue(Event* slots, uint8_t capacity, uint8_t* pendingSlots, uint8_t maxGamepads) noexcept
+          : m_slots(slots),
+            m_pendingSlots(pendingSlots),
+            m_capacity(capacity),
+            m_maxGamepads(maxGamepads) {
+
+        }
+        EventQueue(const EventQueue&) = delete;
+        EventQueue& operator=(const EventQueue&) = delete;
+
+        // Coalescing keys per gamepad: one per joystick, trigger, battery and sensor, plus orientation
+        static constexpr uint8_t s_valueKeysPerGamepad = JoystickCount() + TriggerCount() + BatteryCount() + SensorCount() + 1;
+
+      private:
+        static constexpr bool IsValueEvent(EventType type) noexcept {
+          return type == EventType::TRIGGER || type == EventType::JOYSTICK || type == EventType::BATTERY || type == EventType::SENSOR || type == EventType::ORIENTATION;
+        }
+
+        // Raised from other inputs or from timers rather than carried by a status frame. Sensor
+        // batch events are not: a batch message carries only sensor values, so they compete
+        // with nothing a reserve would protect.
+        static constexpr bool IsDerivedEvent(EventType type) noexcept {
+          return type == EventType::BUTTON_GESTURE || type == EventType::COMBO;
+        }
+
+        uint8_t* PendingSlot(const Event& event) noexcept {
+          if (event.gamepadIndex >= m_maxGamepads) {
+            return nullptr;
+          }
+          uint8_t key = 0;
+          switch (event.type) {
+            case EventType::JOYSTICK: {
+              if (event.id >= JoystickCount()) {
+                return nullptr;
+              }
+              key = event.id;
+              break;
+            }
+            case EventType::TRIGGER: {
+              if (event.id >= TriggerCount()) {
+                return nullptr;
+              }
+              key = static_cast<uint8_t>(JoystickCount() + event.id);
+              break;
+            }
+            case EventType::BATTERY: {
+              if (event.id >= BatteryCount()) {
+                return nullptr;
+              }
+              key = static_cast<uint8_t>(JoystickCount() + TriggerCount() + event.id);
+              break;
+            }
+            case EventType::SENSOR: {
+              if (event.id >= SensorCount()) {
+                return nullptr;
+              }
+              key = static_cast<uint8_t>(JoystickCount() + TriggerCount() + BatteryCount() + event.id);
+              break;
+            }
+            case EventType::ORIENTATION: {
+              if (event.id != 0) {
+                return nullptr;
+              }
+              key = static_cast<uint8_t>(JoystickCount() + TriggerCount() + BatteryCount() + SensorCount());
+              break;
+            }
+            default: {
+              return nullptr;
+            }
+          }
+          return &m_pendingSlots[event.gamepadIndex * s_valueKeysPerGamepad + key];
+        }
+
+        Event* m_slots;
+        uint8_t* m_pendingSlots; // slot + 1 of the queued value event per key, 0 when none
+        uint8_t m_capacity;
+        uint8_t m_maxGamepads;
+        uint8_t m_head{0};
+        uint8_t m_count{0};
+        uint16_t m_coalescedCount{0};
+        uint16_t m_overflowCount{0};
+    };
+
+    template<uint8_t Capacity, uint8_t MaxGamepads>
+    class EventQueueStorage : public EventQueue {
+      public:
+        EventQueueStorage() noexcept : EventQueue(m_storage, Capacity, m_pending, MaxGamepads) {
+
+        }
+
+      private:
+        static_assert(Capacity >= EventQueue::MaxEventsPerStatus(), "Event queue must hold at least one full status frame");
+        static_assert(Capacity < 0xFF, "Event queue capacity must fit pending slot encoding");
+        Event m_storage[Capacity]{};
+        uint8_t m_pending[MaxGamepads * EventQueue::s_valueKeysPerGamepad]{};
+    };
+
+    // Queue compiled out (Traits::eventQueueDepth == 0); never attached to a gamepad
+    template<uint8_t MaxGamepads>
+    class EventQueueStorage<0, MaxGamepads> : public EventQueue {
+      public:
+        EventQueueStorage() noexcept : EventQueue(nullptr, 0, nullptr, MaxGamepads) {
+
+        }
+    };
+  } // namespace internal
+} // namespace GSB
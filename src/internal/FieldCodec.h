@@ -0,0 +1,271 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Gamepad/InputIDs.h"
+#include "internal/Utilities.h"
+
+namespace GSB {
+  namespace internal {
+    // Fixed-width little-endian field I/O, selected by member type
+    inline void WriteField(uint8_t* out, uint8_t value) noexcept {
+      out[0] = value;
+    }
+
+    inline void WriteField(uint8_t* out, uint16_t value) noexcept {
+      WriteLE16(out, value);
+    }
+
+    inline void WriteField(uint8_t* out, int16_t value) noexcept {
+      WriteLE16(out, static_cast<uint16_t>(value));
+    }
+
+    inline void ReadField(const uint8_t* in, uint8_t& value) noexcept {
+      value = in[0];
+    }
+
+    inline void ReadField(const uint8_t* in, uint16_t& value) noexcept {
+      value = ReadLE16(in);
+    }
+
+    inline void ReadField(const uint8_t* in, int16_t& value) noexcept {
+      value = static_cast<int16_t>(ReadLE16(in));
+    }
+
+    // Describes one wire field of Owner.
+    // Group: input group the field belongs to (and is sent with)
+    // Key: input index within the group; for button masks, the ButtonID index of bit 0
+    // Component: axis within the input (X = 0, Y = 1, Z = 2)
+    // Bits: significant bits (button count for masks, value width otherwise); the packed
+    // format sends exactly this many bits, saturating values that do not fit
+    template<typename Owner, typename T, T Owner::*Member, InputGroup Group, uint8_t Key, uint8_t Component = 0, uint8_t Bits = sizeof(T) * 8>
+    struct Field {
+      using Type = T;
+      static constexpr InputGroup group = Group;
+      static constexpr uint8_t groupMask = InputGroupMask(Group);
+      static constexpr uint8_t key = Key;
+      static constexpr uint8_t component = Component;
+      static constexpr uint8_t bits = Bits;
+      static constexpr size_t bytes = sizeof(T);
+      static constexpr bool isSigned = static_cast<T>(-1) < static_cast<T>(0);
+      static constexpr int32_t minimum = isSigned ? -(static_cast<int32_t>(1) << (Bits - 1)) : 0;
+      static constexpr int32_t maximum = isSigned ? (static_cast<int32_t>(1) << (Bits - 1)) - 1 : (static_cast<int32_t>(1) << Bits) - 1;
+
+      static_assert(IsValid(Group), "Field group must be a valid InputGroup");
+      static_assert(Bits > 0 && Bits <= sizeof(T) * 8, "Field bits must fit the member type");
+
+      static void Write(const Owner& owner, uint8_t* out) noexcept {
+        WriteField(out, owner.*Member);
+      }
+
+      static void Read(Owner& owner, const uint8_t* in) noexcept {
+        ReadField(in, owner.*Member);
+      }
+
+      static void WritePacked(const Owner& owner, BitWriter& writer) noexcept {
+        int32_t value = owner.*Member;
+        if (value < minimum) {
+          value = minimum;
+        } else if (value > maximum) {
+          value = maximum;
+        }
+        writer.Write(static_cast<uint32_t>(value), Bits);
+      }
+
+      static bool ReadPacked(Owner& owner, BitReader& reader) noexcept {
+        if (isSigned) {
+          int32_t value = 0;
+          if (!reader.ReadSigned(Bits, value)) {
+            return false;
+          }
+          owner.*Member = static_cast<T>(value);
+        } else {
+          uint32_t value = 0;
+          if (!reader.Read(Bits, value)) {
+            return false;
+          }
+          owner.*Member = static_cast<T>(value);
+        }
+        return true;
+      }
+
+      static bool Differs(const Owner& a, const Owner& b) noexcept {
+        return a.*Member != b.*Member;
+      }
+
+      static void SetValue(Owner& owner, int16_t value) noexcept {
+        owner.*Member = static_cast<T>(value);
+      }
+
+      static int16_t GetValue(const Owner& owner) noexcept {
+        return static_cast<int16_t>(owner.*Member);
+      }
+
+      static bool GetBit(const Owner& owner, uint8_t bit) noexcept {
+        return ((owner.*Member >> bit) & 1u) != 0;
+      }
+
+      static void SetBit(Owner& owner, uint8_t bit, bool on) noexcept {
+        const T modifier = static_cast<T>(1u << bit);
+        owner.*Member = on ? static_cast<T>(owner.*Member | modifier) : static_cast<T>(owner.*Member & static_cast<T>(~modifier));
+      }
+    };
+
+    // Ordered field table; every codec operation is generated by recursion over the list.
+    // Fields must be listed grouped by InputGroup order, which is the wire order.
+    template<typename... Fields>
+    struct FieldList;
+
+    template<>
+    struct FieldList<> {
+      static constexpr size_t Length(uint8_t) noexcept {
+        return 0;
+      }
+
+      static constexpr uint16_t Bits(uint8_t) noexcept {
+        return 0;
+      }
+
+      static constexpr bool GroupOrdered(uint8_t) noexcept {
+        return true;
+      }
+
+      template<typename Owner>
+      static void Write(const Owner&, uint8_t*, uint8_t) noexcept {}
+
+      template<typename Owner>
+      static void Read(Owner&, const uint8_t*, uint8_t) noexcept {}
+
+      template<typename Owner>
+      static void WritePacked(const Owner&, BitWriter&, uint8_t) noexcept {}
+
+      template<typename Owner>
+      static bool ReadPacked(Owner&, BitReader&, uint8_t) noexcept {
+        return true;
+      }
+
+      template<typename Owner>
+      static uint8_t ChangedGroups(const Owner&, const Owner&) noexcept {
+        return 0;
+      }
+
+      template<typename Owner>
+      static void SetValue(Owner&, InputGroup, uint8_t, uint8_t, int16_t) noexcept {}
+
+      template<typename Owner>
+      static void SetButton(Owner&, uint8_t, bool) noexcept {}
+
+      template<typename Owner>
+      static int16_t GetValue(const Owner&, InputGroup, uint8_t, uint8_t) noexcept {
+        return 0;
+      }
+
+      template<typename Owner>
+      static bool GetButton(const Owner&, uint8_t) noexcept {
+        return false;
+      }
+    };
+
+    template<typename First, typename... Rest>
+    struct FieldList<First, Rest...> {
+      using Next = FieldList<Rest...>;
+
+      // Wire bytes for the fields whose group is in groups
+      static constexpr size_t Length(uint8_t groups) noexcept {
+        return ((groups & First::groupMask) ? First::bytes : 0) + Next::Length(groups);
+      }
+
+      // Significant bits for the fields whose group is in groups
+      static constexpr uint16_t Bits(uint8_t groups) noexcept {
+        return static_cast<uint16_t>(((groups & First::groupMask) ? First::bits : 0) + Next::Bits(groups));
+      }
+
+      // Bytes for the same fields in the bit-packed format
+      static constexpr size_t PackedLength(uint8_t groups) noexcept {
+        return (Bits(groups) + 7u) / 8u;
+      }
+
+      static constexpr bool GroupOrdered(uint8_t minimum = 0) noexcept {
+        return static_cast<uint8_t>(First::group) >= minimum && Next::GroupOrdered(static_cast<uint8_t>(First::group));
+      }
+
+      template<typename Owner>
+      static void Write(const Owner& owner, uint8_t* out, uint8_t groups) noexcept {
+        if (groups & First::groupMask) {
+          First::Write(owner, out);
+          out += First::bytes;
+        }
+        Next::Write(owner, out, groups);
+      }
+
+      template<typename Owner>
+      static void Read(Owner& owner, const uint8_t* in, uint8_t groups) noexcept {
+        if (groups & First::groupMask) {
+          First::Read(owner, in);
+          in += First::bytes;
+        }
+        Next::Read(owner, in, groups);
+      }
+
+      template<typename Owner>
+      static void WritePacked(const Owner& owner, BitWriter& writer, uint8_t groups) noexcept {
+        if (groups & First::groupMask) {
+          First::WritePacked(owner, writer);
+        }
+        Next::WritePacked(owner, writer, groups);
+      }
+
+      template<typename Owner>
+      static bool ReadPacked(Owner& owner, BitReader& reader, uint8_t groups) noexcept {
+        if ((groups & First::groupMask) && !First::ReadPacked(owner, reader)) {
+          return false;
+        }
+        return Next::ReadPacked(owner, reader, groups);
+      }
+
+      // Mask of groups with at least one differing field
+      template<typename Owner>
+      static uint8_t ChangedGroups(const Owner& a, const Owner& b) noexcept {
+        const uint8_t changed = First::Differs(a, b) ? First::groupMask : 0;
+        return static_cast<uint8_t>(changed | Next::ChangedGroups(a, b));
+      }
+
+      // Routes a value update to the field matching (group, key, component)
+      template<typename Owner>
+      static void SetValue(Owner& owner, InputGroup group, uint8_t key, uint8_t component, int16_t value) noexcept {
+        if (First::group != InputGroup::BUTTONS && First::group == group && First::key == key && First::component == component) {
+          First::SetValue(owner, value);
+          return;
+        }
+        Next::SetValue(owner, group, key, component, value);
+      }
+
+      // Routes a button update to the mask field covering buttonIndex
+      template<typename Owner>
+      static void SetButton(Owner& owner, uint8_t buttonIndex, bool pressed) noexcept {
+        if (First::group == InputGroup::BUTTONS && buttonIndex >= First::key && buttonIndex < First::key + First::bits) {
+          First::SetBit(owner, static_cast<uint8_t>(buttonIndex - First::key), pressed);
+          return;
+        }
+        Next::SetButton(owner, buttonIndex, pressed);
+      }
+
+      // Reads the field matching (group, key, component); 0 when there is none
+      template<typename Owner>
+      static int16_t GetValue(const Owner& owner, InputGroup group, uint8_t key, uint8_t component) noexcept {
+        if (First::group != InputGroup::BUTTONS && First::group == group && First::key == key && First::component == component) {
+          return First::GetValue(owner);
+        }
+        return Next::GetValue(owner, group, key, component);
+      }
+
+      // Reads buttonIndex from the mask field covering it
+      template<typename Owner>
+      static bool GetButton(const Owner& owner, uint8_t buttonIndex) noexcept {
+        if (First::group == InputGroup::BUTTONS && buttonIndex >= First::key && buttonIndex < First::key + First::bits) {
+          return First::GetBit(owner, static_cast<uint8_t>(buttonIndex - First::key));
+        }
+        return Next::GetButton(owner, buttonIndex);
+      }
+    };
+  } // namespace internal
+} // namespace GSB
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Gamepad/JoystickPolar.h"
+#include "Gamepad/JoystickShaper.h"
+
+namespace GSB {
+  namespace internal {
+    // Per-stick state layered over the Joystick inputs
+    struct JoystickState {
+      JoystickShaper shaper{};
+      JoystickSectors sectors{};
+      // Last raw (X, Y); shaping is two-dimensional, so single-axis updates need the other
+      int16_t inputs[2]{};
+    };
+
+    // One state per stick plus the sentinel slot invalid IDs map to
+    template<uint8_t Count>
+    class JoystickStates {
+      public:
+        JoystickState& At(uint8_t index) noexcept {
+          return m_states[index];
+        }
+
+        const JoystickState& At(uint8_t index) const noexcept {
+          return m_states[index];
+        }
+
+      private:
+        JoystickState m_states[Count + 1];
+    };
+
+    // Joysticks stripped from the profile: no per-gamepad storage, every index maps to one
+    // shared sentinel. Empty, so BasicGamepad inherits it at no cost.
+    template<>
+    class JoystickStates<0> {
+      public:
+        JoystickState& At(uint8_t) noexcept {
+          return Sentinel();
+        }
+
+        const JoystickState& At(uint8_t) const noexcept {
+          return Sentinel();
+        }
+
+      private:
+        static JoystickState& Sentinel() noexcept {
+          static JoystickState sentinel{};
+          return sentinel;
+        }
+    };
+  } // namespace internal
+} // namespace GSB
@@ -2,36 +2,68 @@
 
 #include <Arduino.h>
 #include "LinkConfig.h"
+#include "LinkTiming.h"
+#include "LinkTraits.h"
 #include "UartConfig.h"
 #include "Gamepad/InputIDs.h"
 #include "Gamepad/Gamepad.h"
 #include "internal/Status.h"
 #include "internal/Command.h"
 #include "internal/Utilities.h"
+#include "internal/RxRing.h"
 
 namespace GSB {
   namespace internal {
+    // Shared framing, buffering and gamepad storage for both link directions.
+    // Derived is the concrete link (CRTP): frames are handed to Derived::ParseSerial
+    // without a virtual call. Traits fixes every buffer size at compile time.
+    template<typename Derived, typename Traits>
     class LinkBase {
       public:
         explicit LinkBase(const LinkConfig& linkConfig) noexcept;
-        virtual ~LinkBase() noexcept = default;
         LinkBase(const LinkBase&) = delete;
         LinkBase& operator=(const LinkBase&) = delete;
         bool Setup() noexcept;
-        void Loop() noexcept;
-        static uint8_t MaxControllers() noexcept;
+        // Runs RX ingest, frame dispatch and TX pump, stopping once budgetMicros
+        // is spent (0 = no budget). Unfinished work resumes on the next call.
+        void Loop(unsigned long budgetMicros = 0) noexcept;
+        static constexpr uint8_t MaxControllers() noexcept {
+          return Traits::maxGamepads;
+        }
+
+        // RAM cost of one Derived instance for this Traits configuration
+        static constexpr size_t Footprint() noexcept {
+          return sizeof(Derived);
+        }
+        // Prints the per-buffer breakdown of Footprint()
+        void ReportFootprint(Print& out) const noexcept;
+
+        const PhaseTiming& GetPhaseTiming(LinkPhase phase) const noexcept;
+        void ResetPhaseTimings() noexcept;
+
+        // RxMode::ISR_RING producer: call from the UART receive interrupt with each byte
+        bool ReceiveByteFromISR(uint8_t byte) noexcept;
+        uint16_t GetRxRingOverflowCount() const noexcept;
 
       protected:
+        using Profile = typename Traits::GamepadProfile;
+        using Gamepad = BasicGamepad<Profile>;
+
+        // Not deleted through a base pointer; no virtual destructor needed
+        ~LinkBase() noexcept = default;
+
         // Protected access helpers for subclasses
         uint8_t GetGamepadCount() const noexcept;
         Gamepad& GetGamepad(uint8_t index) noexcept;
         const Gamepad& GetGamepad(uint8_t index) const noexcept;
         HardwareSerial& GetLinkSerial() noexcept;
+        const UartConfig& GetUartConfig() const noexcept;
         Print& GetLogSerial() noexcept;
 
-        // Derived classes override these to handle parsed frames.
-        // Default no-ops keep base usable without subclassing.
-        virtual void ParseSerial(const uint8_t* data, size_t length) noexcept {}
+        // Derived hides this to hold further frames in the RX slots until it returns true
+        bool CanAcceptFrame() const noexcept {
+          return true;
+        }
         template<typename T>
         inline void Log(const T& value) noexcept {
           m_logSerial.println(value);
@@ -43,39 +75,78 @@ namespace GSB {
         // Outbound helpers
         // Derived classes pass raw payloads; we frame + CRC + COBS for you
         bool SendSerial(const uint8_t* data, size_t length) noexcept;
+        // UART bytes SendSerial emits for a payload: version, CRC, COBS overhead and delimiter
+        static constexpr size_t WireLength(size_t payloadLength) noexcept {
+          return s_headerSize + payloadLength + s_crcSize + ((s_headerSize + payloadLength + s_crcSize) / 254) + 1 + 1;
+        }
+
+        // Called once per Loop between dispatch and TX pump; Derived hides this to add periodic work
+        void Service() noexcept {}
 
         // Parsing helpers usable by subclasses
         static uint8_t UInt8AtOffset(const uint8_t* data, size_t offset) noexcept;
         static uint16_t UInt16AtOffset(const uint8_t* data, size_t offset) noexcept;
         static int16_t Int16AtOffset(const uint8_t* data, size_t offset) noexcept;
 
+        static constexpr uint8_t s_maxControllers = Traits::maxGamepads;
+
       private:
-        void ReadSerial() noexcept;
-        void WriteSerial(const uint8_t* data, size_t length) noexcept;
+        void ReadSerial(unsigned long loopStart, unsigned long budgetMicros) noexcept;
+        bool NextRxByte(uint8_t& byte) noexcept;
+        void DispatchFrames(unsigned long loopStart, unsigned long budgetMicros) noexcept;
+        void DispatchFrame(const uint8_t* encoded, size_t length) noexcept;
+        void PumpSerial() noexcept;
+        void FlushSerial() noexcept;
+        bool WriteSerial(const uint8_t* data, size_t length) noexcept;
+        static bool BudgetSpent(unsigned long loopStart, unsigned long budgetMicros) noexcept;
         static uint16_t CRC16_CCITT(const uint8_t* data, size_t length) noexcept;
         static size_t EncodeCOBS(const uint8_t* in, size_t len, uint8_t* out, size_t maxOut) noexcept;
         static size_t DecodeCOBS(const uint8_t* in, size_t len, uint8_t* out, size_t maxOut) noexcept;
 
         // ============= Framing constants =============
         // Packet before COBS: [ver(1)][payload...][crc16(2)]
-        static constexpr uint8_t s_protoVersion = 1;
+        // v2: status frames carry a group header (GamepadProfile)
+        static constexpr uint8_t s_protoVersion = 2;
         static constexpr size_t s_headerSize = 1;
         static constexpr size_t s_crcSize = 2;
-        static constexpr size_t s_binaryMaxPayloadLength = 64;
+        static constexpr size_t s_binaryMaxPayloadLength = Traits::maxPayload;
         static constexpr size_t s_maxPacketSize = s_headerSize + s_binaryMaxPayloadLength + s_crcSize;
         // COBS worst-case growth ~= n/254 + 1; add a couple bytes for safety
         static constexpr size_t s_maxEncodedSize = s_maxPacketSize + (s_maxPacketSize/254) + 2;
-        static constexpr uint8_t s_maxControllers = 4;
+        // Complete encoded frames held between ingest and dispatch
+        static constexpr uint8_t s_rxFrameDepth = Traits::rxFrameDepth;
+        // Encoded frames plus delimiters waiting on the UART
+        static constexpr size_t s_txBufferSize = Traits::txFrameDepth * (s_maxEncodedSize + 1);
+        // Bytes read between budget checks during ingest
+        static constexpr uint8_t s_rxBudgetStride = 8;
+        // ISR-fed ring; the default 256 bytes is ~22 ms of slack at 115200 baud
+        static constexpr uint16_t s_rxRingSize = Traits::rxRingSize;
 
         uint8_t m_gamepadCount;
         Gamepad m_gamepads[s_maxControllers];
         UartConfig m_uartConfig;
         HardwareSerial& m_linkSerial;
         Print& m_logSerial;
+        RxMode m_rxMode;
+        RxRing<s_rxRingSize> m_rxRing;
         
-        // RX accumulator for encoded bytes until 0x00 delimiter
-        uint8_t m_rxEncoded[s_maxEncodedSize]{};
+        // RX frame slots: ingest accumulates into slot (head + count) until the 0x00 delimiter,
+        // dispatch consumes from head. Ingest pauses while every slot holds a complete frame,
+        // so frames held back by CanAcceptFrame leave the rest in the UART.
+        uint8_t m_rxFrames[s_rxFrameDepth][s_maxEncodedSize]{};
+        size_t  m_rxFrameLengths[s_rxFrameDepth]{};
+        uint8_t m_rxFrameHead{0};
+        uint8_t m_rxFrameCount{0};
         size_t  m_rxLength{0};
+
+        // TX ring of encoded bytes drained as the UART has room
+        uint8_t m_txBuffer[s_txBufferSize]{};
+        size_t  m_txHead{0};
+        size_t  m_txCount{0};
+
+        PhaseTiming m_phaseTimings[LinkPhaseCount()]{};
     };
   } // namespace internal
-} // namespace GSB
\ No newline at end of file
+} // namespace GSB
+
+#include "internal/LinkBase.tpp"
\ No newline at end of file
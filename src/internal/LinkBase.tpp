@@ -0,0 +1,434 @@
+// Template definitions for LinkBase; included at the bottom of LinkBase.h
+
+namespace GSB {
+  namespace internal {
+    template<typename Derived, typename Traits>
+    LinkBase<Derived, Traits>::LinkBase(const LinkConfig& linkConfig) noexcept
+      : m_gamepadCount(linkConfig.gamepadCount),
+        m_uartConfig(linkConfig.uartConfig),
+        m_linkSerial(linkConfig.linkSerial),
+        m_logSerial(linkConfig.logSerial),
+        m_rxMode(linkConfig.rxMode) {
+      if (m_gamepadCount > s_maxControllers) {
+        m_gamepadCount = s_maxControllers;
+      }
+      for (uint8_t i = 0; i < m_gamepadCount; ++i) {
+        m_gamepads[i].Init(i);
+      }
+    }
+
+    template<typename Derived, typename Traits>
+    bool LinkBase<Derived, Traits>::Setup() noexcept {
+      const int uartConfig = m_uartConfig.GetSerialConfig();
+      if (uartConfig < 0) {
+        Log(F("Invalid UART configuration"));
+        return false;
+      }
+      m_linkSerial.begin(m_uartConfig.GetBaudRate(), uartConfig);
+      return true;
+    }
+
+    template<typename Derived, typename Traits>
+    void LinkBase<Derived, Traits>::Loop(unsigned long budgetMicros) noexcept {
+      const unsigned long loopStart = micros();
+      ReadSerial(loopStart, budgetMicros);
+      const unsigned long ingestEnd = micros();
+      m_phaseTimings[LinkPhaseIndex(LinkPhase::RX_INGEST)].Record(ingestEnd - loopStart);
+
+      DispatchFrames(loopStart, budgetMicros);
+      const unsigned long dispatchEnd = micros();
+      m_phaseTimings[LinkPhaseIndex(LinkPhase::FRAME_DISPATCH)].Record(dispatchEnd - ingestEnd);
+
+      static_cast<Derived*>(this)->Service();
+      const unsigned long serviceEnd = micros();
+      m_phaseTimings[LinkPhaseIndex(LinkPhase::SERVICE)].Record(serviceEnd - dispatchEnd);
+
+      // Never blocks: only writes what the UART can take right now
+      PumpSerial();
+      m_phaseTimings[LinkPhaseIndex(LinkPhase::TX_PUMP)].Record(micros() - serviceEnd);
+    }
+
+    template<typename Derived, typename Traits>
+    const PhaseTiming& LinkBase<Derived, Traits>::GetPhaseTiming(LinkPhase phase) const noexcept {
+      // Invalid phases (including COUNT) map to LinkPhaseCount(), one past the table
+      static const PhaseTiming empty{};
+      const uint8_t index = LinkPhaseIndex(phase);
+      return (index < LinkPhaseCount()) ? m_phaseTimings[index] : empty;
+    }
+
+    template<typename Derived, typename Traits>
+    void LinkBase<Derived, Traits>::ResetPhaseTimings() noexcept {
+      for (uint8_t i = 0; i < LinkPhaseCount(); ++i) {
+        m_phaseTimings[i] = PhaseTiming{};
+      }
+    }
+
+    template<typename Derived, typename Traits>
+    bool LinkBase<Derived, Traits>::ReceiveByteFromISR(uint8_t byte) noexcept {
+      return m_rxRing.Push(byte);
+    }
+
+    template<typename Derived, typename Traits>
+    uint16_t LinkBase<Derived, Traits>::GetRxRingOverflowCount() const noexcept {
+      return m_rxRing.GetOverflowCount();
+    }
+
+    template<typename Derived, typename Traits>
+    void LinkBase<Derived, Traits>::ReportFootprint(Print& out) const noexcept {
+      const size_t gamepads = sizeof(m_gamepads);
+      const size_t rxFrames = sizeof(m_rxFrames) + sizeof(m_rxFrameLengths);
+      const size_t txBuffer = sizeof(m_txBuffer);
+      const size_t rxRing = sizeof(m_rxRing);
+      const size_t total = Footprint();
+      out.print(F("Gamepads ("));
+      out.print(s_maxControllers);
+      out.print(F("): "));
+      out.println(gamepads);
+      out.print(F("RX frames: "));
+      out.println(rxFrames);
+      out.print(F("TX buffer: "));
+      out.println(txBuffer);
+      out.print(F("RX ring: "));
+      out.println(rxRing);
+      out.print(F("Other: "));
+      out.println(total - gamepads - rxFrames - txBuffer - rxRing);
+      out.print(F("Total bytes: "));
+      out.println(total);
+    }
+
+    template<typename Derived, typename Traits>
+    uint8_t LinkBase<Derived, Traits>::GetGamepadCount() const noexcept {
+      return m_gamepadCount;
+    }
+
+    template<typename Derived, typename Traits>
+    typename LinkBase<Derived, Traits>::Gamepad& LinkBase<Derived, Traits>::GetGamepad(uint8_t index) noexcept {
+      return m_gamepads[index];
+    }
+
+    template<typename Derived, typename Traits>
+    const typename LinkBase<Derived, Traits>::Gamepad& LinkBase<Derived, Traits>::GetGamepad(uint8_t index) const noexcept {
+      return m_gamepads[index];
+    }
+
+    template<typename Derived, typename Traits>
+    HardwareSerial& LinkBase<Derived, Traits>::GetLinkSerial() noexcept {
+      return m_linkSerial;
+    }
+
+    template<typename Derived, typename Traits>
+    const UartConfig& LinkBase<Derived, Traits>::GetUartConfig() const noexcept {
+      return m_uartConfig;
+    }
+
+    template<typename Derived, typename Traits>
+    Print& LinkBase<Derived, Traits>::GetLogSerial() noexcept {
+      return m_logSerial;
+    }
+
+    template<typename Derived, typename Traits>
+    bool LinkBase<Derived, Traits>::SendSerial(const uint8_t* data, size_t length) noexcept {
+      if ((length != 0 && !data) || length > s_binaryMaxPayloadLength) {
+        Log(F("Binary payload error: invalid length"));
+        return false;
+      }
+      uint8_t raw[s_maxPacketSize];
+      size_t pos = 0;
+      raw[pos++] = s_protoVersion;
+      if (length && data) {
+        CopyBytes(raw + pos, data, length);
+        pos += length;
+      }
+      const uint16_t crc = CRC16_CCITT(raw, pos);
+      WriteLE16(raw + pos, crc);
+      pos += 2;
+
+      uint8_t encoded[s_maxEncodedSize];
+      const size_t encodedLength = EncodeCOBS(raw, pos, encoded, s_maxEncodedSize);
+      if (encodedLength == 0 || encodedLength > s_maxEncodedSize) {
+        Log(F("COBS encode failed"));
+        return false;
+      }
+      if (m_txCount + encodedLength + 1 > s_txBufferSize) {
+        // TX ring is backed up; fall back to a blocking drain rather than drop the frame
+        FlushSerial();
+      }
+      WriteSerial(encoded, encodedLength);
+      const uint8_t delimiter = 0x00;
+      WriteSerial(&delimiter, 1);
+      PumpSerial();
+      return true;
+    }
+
+    template<typename Derived, typename Traits>
+    uint8_t LinkBase<Derived, Traits>::UInt8AtOffset(const uint8_t* data, size_t offset) noexcept {
+      return data[offset];
+    }
+
+    template<typename Derived, typename Traits>
+    uint16_t LinkBase<Derived, Traits>::UInt16AtOffset(const uint8_t* data, size_t offset) noexcept {
+      return ReadLE16(data + offset);
+    }
+
+    template<typename Derived, typename Traits>
+    int16_t LinkBase<Derived, Traits>::Int16AtOffset(const uint8_t* data, size_t offset) noexcept {
+      return static_cast<int16_t>(ReadLE16(data + offset));
+    }
+
+    // ------------------- serial ingest -------------------
+    template<typename Derived, typename Traits>
+    void LinkBase<Derived, Traits>::ReadSerial(unsigned long loopStart, unsigned long budgetMicros) noexcept {
+      uint8_t stride = 0;
+      uint8_t byte = 0;
+      while (m_rxFrameCount < s_rxFrameDepth) {
+        if (++stride == s_rxBudgetStride) {
+          stride = 0;
+          if (BudgetSpent(loopStart, budgetMicros)) {
+            break;
+          }
+        }
+        if (!NextRxByte(byte)) {
+          break;
+        }
+        uint8_t slot = static_cast<uint8_t>(m_rxFrameHead + m_rxFrameCount);
+        if (slot >= s_rxFrameDepth) {
+          slot = static_cast<uint8_t>(slot - s_rxFrameDepth);
+        }
+        if (byte == 0x00) { // end-of-frame delimiter for COBS
+          if (m_rxLength > 0) {
+            m_rxFrameLengths[slot] = m_rxLength;
+            ++m_rxFrameCount;
+            m_rxLength = 0;
+          }
+        } else if (m_rxLength < s_maxEncodedSize) {
+          m_rxFrames[slot][m_rxLength++] = byte;
+        } else {
+          // overflow: drop partial frame until next delimiter
+          m_rxLength = 0;
+          Log(F("RX overflow, dropping frame"));
+        }
+      }
+    }
+
+    template<typename Derived, typename Traits>
+    bool LinkBase<Derived, Traits>::NextRxByte(uint8_t& byte) noexcept {
+      if (m_rxMode == RxMode::ISR_RING) {
+        return m_rxRing.Pop(byte);
+      }
+      if (!m_linkSerial.available()) {
+        return false;
+      }
+      const int readByte = m_linkSerial.read();
+      if (readByte < 0) {
+        return false;
+      }
+      byte = static_cast<uint8_t>(readByte);
+      return true;
+    }
+
+    template<typename Derived, typename Traits>
+    void LinkBase<Derived, Traits>::DispatchFrames(unsigned long loopStart, unsigned long budgetMicros) noexcept {
+      // Always dispatch at least one frame so a tight budget cannot starve parsing.
+      // Frames the derived link cannot accept yet stay in their slots.
+      while (m_rxFrameCount > 0 && static_cast<const Derived*>(this)->CanAcceptFrame()) {
+        DispatchFrame(m_rxFrames[m_rxFrameHead], m_rxFrameLengths[m_rxFrameHead]);
+        if (++m_rxFrameHead >= s_rxFrameDepth) {
+          m_rxFrameHead = 0;
+        }
+        --m_rxFrameCount;
+        if (BudgetSpent(loopStart, budgetMicros)) {
+          break;
+        }
+      }
+    }
+
+    template<typename Derived, typename Traits>
+    void LinkBase<Derived, Traits>::DispatchFrame(const uint8_t* encoded, size_t length) noexcept {
+      uint8_t raw[s_maxPacketSize];
+      const size_t rawLen = DecodeCOBS(encoded, length, raw, s_maxPacketSize);
+      if (rawLen < s_headerSize + s_crcSize) {
+        // too short after decode; drop
+        return;
+      }
+      const size_t dataLen = rawLen - s_crcSize;
+      const uint16_t receivedCRC = ReadLE16(raw + dataLen);
+      const uint16_t calculatedCRC  = CRC16_CCITT(raw, dataLen);
+      if (receivedCRC != calculatedCRC) {
+        Log(F("CRC mismatch"));
+        return;
+      }
+      const uint8_t version = raw[0];
+      if (version != s_protoVersion) {
+        Log(F("Bad protocol version"));
+        return;
+      }
+      const uint8_t* payload = raw + s_headerSize;
+      const size_t payloadLength = dataLen - s_headerSize;
+      static_cast<Derived*>(this)->ParseSerial(payload, payloadLength);
+    }
+
+    // ------------------- serial output -------------------
+    template<typename Derived, typename Traits>
+    bool LinkBase<Derived, Traits>::WriteSerial(const uint8_t* data, size_t length) noexcept {
+      if (!data || !length) {
+        return false;
+      }
+      if (m_txCount + length > s_txBufferSize) {
+        return false;
+      }
+      size_t tail = m_txHead + m_txCount;
+      for (size_t i = 0; i < length; ++i) {
+        if (tail >= s_txBufferSize) {
+          tail -= s_txBufferSize;
+        }
+        m_txBuffer[tail++] = data[i];
+      }
+      m_txCount += length;
+      return true;
+    }
+
+    template<typename Derived, typename Traits>
+    void LinkBase<Derived, Traits>::PumpSerial() noexcept {
+      while (m_txCount > 0) {
+        const int room = m_linkSerial.availableForWrite();
+        if (room <= 0) {
+          return;
+        }
+        size_t chunk = s_txBufferSize - m_txHead; // contiguous run up to the wrap point
+        if (chunk > m_txCount) {
+          chunk = m_txCount;
+        }
+        if (chunk > static_cast<size_t>(room)) {
+          chunk = static_cast<size_t>(room);
+        }
+        const size_t written = m_linkSerial.write(m_txBuffer + m_txHead, chunk);
+        if (written == 0) {
+          return;
+        }
+        m_txHead += written;
+        if (m_txHead >= s_txBufferSize) {
+          m_txHead -= s_txBufferSize;
+        }
+        m_txCount -= written;
+      }
+    }
+
+    template<typename Derived, typename Traits>
+    void LinkBase<Derived, Traits>::FlushSerial() noexcept {
+      while (m_txCount > 0) {
+        size_t chunk = s_txBufferSize - m_txHead;
+        if (chunk > m_txCount) {
+          chunk = m_txCount;
+        }
+        m_linkSerial.write(m_txBuffer + m_txHead, chunk); // blocks until the UART accepts it
+        m_txHead += chunk;
+        if (m_txHead >= s_txBufferSize) {
+          m_txHead -= s_txBufferSize;
+        }
+        m_txCount -= chunk;
+      }
+    }
+
+    template<typename Derived, typename Traits>
+    bool LinkBase<Derived, Traits>::BudgetSpent(unsigned long loopStart, unsigned long budgetMicros) noexcept {
+      return budgetMicros != 0 && (micros() - loopStart) >= budgetMicros;
+    }
+    
+    template<typename Derived, typename Traits>
+    uint16_t LinkBase<Derived, Traits>::CRC16_CCITT(const uint8_t* data, size_t length) noexcept {
+      uint16_t crc = 0xFFFF;
+      for (size_t i = 0; i < length; ++i) {
+        crc ^= static_cast<uint16_t>(data[i]) << 8;
+        for (uint8_t bit = 0; bit < 8; ++bit) {
+          if (crc & 0x8000) {
+            crc = static_cast<uint16_t>((crc << 1) ^ 0x1021);
+          } else {
+            crc = static_cast<uint16_t>(crc << 1);
+          }
+        }
+      }
+      return crc;
+    }
+
+    // ================= COBS =================
+    template<typename Derived, typename Traits>
+    size_t LinkBase<Derived, Traits>::EncodeCOBS(const uint8_t* in, size_t length, uint8_t* out, size_t maxOut) noexcept {
+      if (!in || !out || maxOut == 0) {
+        return 0;
+      }
+      // Worst-case expansion: +1 code byte per 254 data bytes, +1 for the first code byte.
+      const size_t worst = length + (length / 254) + 1;
+      if (worst > maxOut) {
+        return 0;
+      }
+      uint8_t* const outStart = out;
+      // Reserve space for the first code byte
+      if (maxOut < 1) {
+        return 0;
+      }
+      uint8_t* codePtr = out++;
+      size_t remaining = maxOut - 1;
+      uint8_t code = 1;
+      for (size_t i = 0; i < length; ++i) {
+        const uint8_t byte = in[i];
+        if (byte == 0) {
+          // Close current block
+          *codePtr = code;
+          if (remaining == 0) {
+            return 0;
+          }
+          codePtr = out++;
+          --remaining;
+          code = 1;
+        } else {
+          if (remaining == 0) {
+            return 0;
+          }
+          *out++ = byte;
+          --remaining;
+          if (++code == 0xFF) {
+            // Block full: emit code and start a new block
+            *codePtr = code;
+            if (remaining == 0) {
+              return 0;
+            }
+            codePtr = out++;
+            --remaining;
+            code = 1;
+          }
+        }
+      }
+      // Finalize the last block
+      *codePtr = code;
+      return static_cast<size_t>(out - outStart);
+    }
+
+    template<typename Derived, typename Traits>
+    size_t LinkBase<Derived, Traits>::DecodeCOBS(const uint8_t* in, size_t length, uint8_t* out, size_t maxOut) noexcept {
+      if (!in || !out) {
+        return 0;
+      }
+      const uint8_t* end = in + length;
+      size_t outLength = 0;
+      while (in < end) {
+        const uint8_t code = *in++;
+        if (code == 0 || in + code - 1 > end) {
+          return 0;
+        }
+        for (uint8_t i = 1; i < code; ++i) {
+          if (outLength >= maxOut) {
+            return 0;
+          }
+          out[outLength++] = *in++;
+        }
+        if (code != 0xFF && in < end) {
+          if (outLength >= maxOut) {
+            return 0;
+          }
+          out[outLength++] = 0;
+        }
+      }
+      return outLength;
+    }
+  } // namespace internal
+} // namespace GSB
\ No newline at end of file
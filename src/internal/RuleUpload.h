@@ -0,0 +1,25 @@
+#pragma once
+
+#include <Arduino.h>
+
+namespace GSB {
+  namespace internal {
+    // One piece of a rule program sent to the receiver (see RuleVm::LoadChunk). Wire layout:
+    //   [header(1)][gamepadIndex(1)][offset(1)][total(1)][program bytes...]
+    // The header is StatusFormat code 2 with no group bits, which neither Status nor
+    // SensorBatch sends. Pieces go out in order; total 0 unloads the gamepad's program.
+    struct RuleUpload {
+      static constexpr uint8_t HeaderCode() noexcept {
+        return static_cast<uint8_t>(2u << 6);
+      }
+
+      static constexpr size_t HeaderLength() noexcept {
+        return 4;
+      }
+
+      static bool IsChunk(const uint8_t* in, size_t length) noexcept {
+        return in != nullptr && length >= HeaderLength() && in[0] == HeaderCode();
+      }
+    };
+  } // namespace internal
+} // namespace GSB
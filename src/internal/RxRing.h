@@ -0,0 +1,103 @@
+#pragma once
+
+#include <Arduino.h>
+
+namespace GSB {
+  namespace internal {
+    // Lock-free single-producer/single-consumer byte ring.
+    // The producer (UART receive ISR or a stand-in thread) only writes m_head,
+    // the consumer (Loop) only writes m_tail. Indices are single bytes so loads
+    // and stores are atomic on AVR; acquire/release ordering covers SMP hosts.
+    // One slot stays empty to tell full from empty, so Capacity - 1 bytes are usable.
+    template<uint16_t Capacity>
+    class RxRing {
+      public:
+        static_assert(Capacity >= 2 && Capacity <= 256, "RxRing capacity must be 2..256");
+        static_assert((Capacity & (Capacity - 1)) == 0, "RxRing capacity must be a power of two");
+
+        RxRing() = default;
+        RxRing(const RxRing&) = delete;
+        RxRing& operator=(const RxRing&) = delete;
+
+        // Producer side; safe to call from an ISR
+        bool Push(uint8_t byte) noexcept {
+          const uint8_t head = __atomic_load_n(&m_head, __ATOMIC_RELAXED);
+          const uint8_t next = static_cast<uint8_t>((head + 1u) & s_mask);
+          if (next == __atomic_load_n(&m_tail, __ATOMIC_ACQUIRE)) {
+            ++m_overflowCount;
+            return false;
+          }
+          m_buffer[head] = byte;
+          __atomic_store_n(&m_head, next, __ATOMIC_RELEASE);
+          return true;
+        }
+
+        // Consumer side
+        bool Pop(uint8_t& byte) noexcept {
+          const uint8_t tail = __atomic_load_n(&m_tail, __ATOMIC_RELAXED);
+          if (tail == __atomic_load_n(&m_head, __ATOMIC_ACQUIRE)) {
+            return false;
+          }
+          byte = m_buffer[tail];
+          __atomic_store_n(&m_tail, static_cast<uint8_t>((tail + 1u) & s_mask), __ATOMIC_RELEASE);
+          return true;
+        }
+
+        uint16_t Available() const noexcept {
+          const uint8_t head = __atomic_load_n(&m_head, __ATOMIC_ACQUIRE);
+          const uint8_t tail = __atomic_load_n(&m_tail, __ATOMIC_ACQUIRE);
+          return static_cast<uint16_t>((head - tail) & s_mask);
+        }
+
+        static constexpr uint16_t Size() noexcept {
+          return Capacity - 1u;
+        }
+
+        // Written by the producer only; a torn read on AVR just yields a stale count
+        uint16_t GetOverflowCount() const noexcept {
+          return m_overflowCount;
+        }
+
+      private:
+        static constexpr uint8_t s_mask = static_cast<uint8_t>(Capacity - 1u);
+
+        volatile uint8_t m_buffer[Capacity]{};
+        volatile uint8_t m_head{0};
+        volatile uint8_t m_tail{0};
+        volatile uint16_t m_overflowCount{0};
+    };
+
+    // Zero-capacity ring for links built without ISR ingest; every push overflows
+    template<>
+    class RxRing<0> {
+      public:
+        RxRing() = default;
+        RxRing(const RxRing&) = delete;
+        RxRing& operator=(const RxRing&) = delete;
+
+        bool Push(uint8_t) noexcept {
+          ++m_overflowCount;
+          return false;
+        }
+
+        bool Pop(uint8_t&) noexcept {
+          return false;
+        }
+
+        uint16_t Available() const noexcept {
+          return 0;
+        }
+
+        static constexpr uint16_t Size() noexcept {
+          return 0;
+        }
+
+        uint16_t GetOverflowCount() const noexcept {
+          return m_overflowCount;
+        }
+
+      private:
+        volatile uint16_t m_overflowCount{0};
+    };
+  } // namespace internal
+} // namespace GSB
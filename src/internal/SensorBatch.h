@@ -0,0 +1,343 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Gamepad/InputIDs.h"
+#include "internal/Utilities.h"
+
+namespace GSB {
+  // One reading of every sensor, indexed [SensorIndex][X, Y, Z]
+  struct SensorSample {
+    int16_t values[SensorCount()][3];
+  };
+
+  namespace internal {
+    // Several consecutive sensor samples in one message, so motion can run far above the
+    // status rate. Wire layout:
+    //   [header(1)][gamepadIndex(1)][sampleCount(1)][age varint]
+    //   then per sample [micros since previous sample varint][zigzag varint delta per axis]
+    // The header is the SENSORS group bit with code 2 in bits 6-7, a StatusFormat value
+    // Status never sends, so receivers tell the two messages apart by the first byte.
+    // Deltas are taken against the previous sample (zero for the first), wrapping at 16 bits.
+    // Age is the time from the newest sample to the send; times saturate at MaxMicros().
+    struct SensorBatch {
+      static constexpr uint8_t HeaderCode() noexcept {
+        return static_cast<uint8_t>(InputGroupMask(InputGroup::SENSORS) | (2u << 6));
+      }
+
+      static constexpr size_t HeaderLength() noexcept {
+        return 3;
+      }
+
+      static constexpr size_t MaxHeaderLength() noexcept {
+        return HeaderLength() + s_maxTimeBytes;
+      }
+
+      static constexpr size_t MaxSampleLength() noexcept {
+        return s_maxTimeBytes + 3 * s_maxValueBytes * SensorCount();
+      }
+
+      static bool IsBatch(const uint8_t* in, size_t length) noexcept {
+        return in != nullptr && length >= HeaderLength() && in[0] == HeaderCode();
+      }
+
+      static constexpr uint8_t s_maxTimeBytes = 3;
+      static constexpr uint8_t s_maxValueBytes = 3;
+
+      static constexpr unsigned long MaxMicros() noexcept {
+        return (1UL << (7 * s_maxTimeBytes)) - 1;
+      }
+
+      static size_t WriteVarint(uint8_t* out, uint32_t value) noexcept {
+        size_t length = 0;
+        do {
+          const uint8_t low = static_cast<uint8_t>(value & 0x7F);
+          value >>= 7;
+          out[length++] = (value != 0) ? static_cast<uint8_t>(low | 0x80) : low;
+        } while (value != 0);
+        return length;
+      }
+
+      // False on a truncated value or one longer than maxBytes
+      static bool ReadVarint(const uint8_t* in, size_t length, size_t& position, uint8_t maxBytes, uint32_t& value) noexcept {
+        value = 0;
+        for (uint8_t i = 0; i < maxBytes && position < length; ++i) {
+          const uint8_t byte = in[position++];
+          value |= static_cast<uint32_t>(byte & 0x7F) << (7 * i);
+          if (!(byte & 0x80)) {
+            return true;
+          }
+        }
+        return false;
+      }
+
+      static uint16_t ZigZag(int16_t value) noexcept {
+        return static_cast<uint16_t>((static_cast<uint16_t>(value) << 1) ^ static_cast<uint16_t>(value >> 15));
+      }
+
+      static int16_t UnZigZag(uint16_t value) noexcept {
+        return static_cast<int16_t>((value >> 1) ^ static_cast<uint16_t>(-static_cast<int16_t>(value & 1u)));
+      }
+    };
+
+    // Sender side: encodes samples as they arrive into Capacity body bytes
+    template<size_t Capacity>
+    class SensorBatchWriter {
+      public:
+        static_assert(Capacity >= SensorBatch::MaxSampleLength(), "Sensor batch must hold at least one sample");
+
+        // False when the sample does not fit; the caller sends the batch and adds it again
+        bool Add(const SensorSample& sample, unsigned long nowMicros) noexcept {
+          uint8_t encoded[SensorBatch::MaxSampleLength()];
+          const unsigned long elapsed = (m_count == 0) ? 0 : nowMicros - m_newestMicros;
+          size_t length = SensorBatch::WriteVarint(encoded, (elapsed > SensorBatch::MaxMicros()) ? SensorBatch::MaxMicros() : elapsed);
+          for (uint8_t sensor = 0; sensor < SensorCount(); ++sensor) {
+            for (uint8_t axis = 0; axis < 3; ++axis) {
+              const int16_t delta = static_cast<int16_t>(static_cast<uint16_t>(sample.values[sensor][axis]) - static_cast<uint16_t>(m_previous.values[sensor][axis]));
+              length += SensorBatch::WriteVarint(&encoded[length], SensorBatch::ZigZag(delta));
+            }
+          }
+          if (m_count == UINT8_MAX || m_length + length > Capacity) {
+            return false;
+          }
+          CopyBytes(&m_body[m_length], encoded, length);
+          m_length += length;
+          if (m_count == 0) {
+            m_oldestMicros = nowMicros;
+          }
+          ++m_count;
+          m_newestMicros = nowMicros;
+          m_previous = sample;
+          return true;
+        }
+
+        uint8_t GetCount() const noexcept {
+          return m_count;
+        }
+
+        unsigned long GetOldestMicros() const noexcept {
+          return m_oldestMicros;
+        }
+
+        // Writes the message into out; 0 if empty or out is too small. The samples stay
+        // queued until Clear, so a batch whose send fails can be sent again.
+        size_t Finish(uint8_t gamepadIndex, unsigned long nowMicros, uint8_t* out, size_t outCapacity) noexcept {
+          if (m_count == 0 || outCapacity < SensorBatch::MaxHeaderLength() + m_length) {
+            return 0;
+          }
+          out[0] = SensorBatch::HeaderCode();
+          out[1] = gamepadIndex;
+          out[2] = m_count;
+          const unsigned long age = nowMicros - m_newestMicros;
+          size_t length = SensorBatch::HeaderLength();
+          length += SensorBatch::WriteVarint(&out[length], (age > SensorBatch::MaxMicros()) ? SensorBatch::MaxMicros() : age);
+          CopyBytes(&out[length], m_body, m_length);
+          length += m_length;
+          return length;
+        }
+
+        void Clear() noexcept {
+          m_length = 0;
+          m_count = 0;
+          m_previous = SensorSample{};
+        }
+
+      private:
+        uint8_t m_body[Capacity]{};
+        size_t m_length{0};
+        uint8_t m_count{0};
+        SensorSample m_previous{};
+        unsigned long m_oldestMicros{0};
+        unsigned long m_newestMicros{0};
+    };
+
+    // Batching compiled out (Traits::sensorBatching false or no sensors in the profile)
+    template<>
+    class SensorBatchWriter<0> {
+      public:
+        bool Add(const SensorSample&, unsigned long) noexcept {
+          return false;
+        }
+
+        uint8_t GetCount() const noexcept {
+          return 0;
+        }
+
+        unsigned long GetOldestMicros() const noexcept {
+          return 0;
+        }
+
+        size_t Finish(uint8_t, unsigned long, uint8_t*, size_t) noexcept {
+          return 0;
+        }
+
+        void Clear() noexcept {
+
+        }
+    };
+
+    // Receiver side: Validate walks the whole message once (so the span is known before
+    // the first sample is replayed), then Next yields the samples in order
+    class SensorBatchReader {
+      public:
+        SensorBatchReader(const uint8_t* in, size_t length) noexcept
+          : m_in(in),
+            m_length(length) {
+
+        }
+
+        bool Validate() noexcept {
+          if (!SensorBatch::IsBatch(m_in, m_length)) {
+            return false;
+          }
+          m_position = SensorBatch::HeaderLength();
+          uint32_t age = 0;
+          if (m_in[2] == 0 || !SensorBatch::ReadVarint(m_in, m_length, m_position, SensorBatch::s_maxTimeBytes, age)) {
+            return false;
+          }
+          m_bodyStart = m_position;
+          m_ageMicros = age;
+          m_remaining = m_in[2];
+          SensorSample sample;
+          unsigned long offset = 0;
+          while (m_remaining > 0) {
+            if (!Next(sample, offset)) {
+              return false;
+            }
+          }
+          // Trailing bytes mean the count and the body disagree
+          if (m_position != m_length) {
+            return false;
+          }
+          m_spanMicros = offset;
+          Rewind();
+          return true;
+        }
+
+        uint8_t GetGamepadIndex() const noexcept {
+          return m_in[1];
+        }
+
+        uint8_t GetCount() const noexcept {
+          return m_in[2];
+        }
+
+        // Newest sample to send, and oldest to newest sample
+        unsigned long GetAgeMicros() const noexcept {
+          return m_ageMicros;
+        }
+
+        unsigned long GetSpanMicros() const noexcept {
+          return m_spanMicros;
+        }
+
+        // offsetMicros is the time since the first sample of the batch
+        bool Next(SensorSample& sample, unsigned long& offsetMicros) noexcept {
+          if (m_remaining == 0) {
+            return false;
+          }
+          uint32_t value = 0;
+          if (!SensorBatch::ReadVarint(m_in, m_length, m_position, SensorBatch::s_maxTimeBytes, value)) {
+            m_remaining = 0;
+            return false;
+          }
+          m_offsetMicros += value;
+          for (uint8_t sensor = 0; sensor < SensorCount(); ++sensor) {
+            for (uint8_t axis = 0; axis < 3; ++axis) {
+              if (!SensorBatch::ReadVarint(m_in, m_length, m_position, SensorBatch::s_maxValueBytes, value) || value > UINT16_MAX) {
+                m_remaining = 0;
+                return false;
+              }
+              const uint16_t delta = static_cast<uint16_t>(SensorBatch::UnZigZag(static_cast<uint16_t>(value)));
+              m_current.values[sensor][axis] = static_cast<int16_t>(static_cast<uint16_t>(m_current.values[sensor][axis]) + delta);
+            }
+          }
+          --m_remaining;
+          sample = m_current;
+          offsetMicros = m_offsetMicros;
+          return true;
+        }
+
+      private:
+        void Rewind() noexcept {
+          m_position = m_bodyStart;
+          m_remaining = m_in[2];
+          m_offsetMicros = 0;
+          m_current = SensorSample{};
+        }
+
+        const uint8_t* m_in;
+        size_t m_length;
+        size_t m_position{0};
+        size_t m_bodyStart{0};
+        uint8_t m_remaining{0};
+        unsigned long m_ageMicros{0};
+        unsigned long m_spanMicros{0};
+        unsigned long m_offsetMicros{0};
+        SensorSample m_current{};
+    };
+    // Receiver side: batch samples waiting for the event queue to dispatch their callback.
+    // Each entry is paired with one EventType::SENSOR_BATCH event, so both drain in order.
+    template<uint8_t Capacity>
+    class SensorSampleQueue {
+      public:
+        struct Entry {
+          SensorSample sample;
+          unsigned long sampleMicros;
+          uint8_t gamepadIndex;
+        };
+
+        bool IsFull() const noexcept {
+          return m_count >= Capacity;
+        }
+
+        void Push(uint8_t gamepadIndex, const SensorSample& sample, unsigned long sampleMicros) noexcept {
+          if (IsFull()) {
+            return;
+          }
+          Entry& entry = m_entries[(m_head + m_count) % Capacity];
+          entry.sample = sample;
+          entry.sampleMicros = sampleMicros;
+          entry.gamepadIndex = gamepadIndex;
+          ++m_count;
+        }
+
+        bool Pop(Entry& entry) noexcept {
+          if (m_count == 0) {
+            return false;
+          }
+          entry = m_entries[m_head];
+          m_head = static_cast<uint8_t>((m_head + 1) % Capacity);
+          --m_count;
+          return true;
+        }
+
+      private:
+        Entry m_entries[Capacity]{};
+        uint8_t m_head{0};
+        uint8_t m_count{0};
+    };
+
+    // Batch callbacks compiled out of the queue (no event queue, sensors or batching)
+    template<>
+    class SensorSampleQueue<0> {
+      public:
+        struct Entry {
+          SensorSample sample;
+          unsigned long sampleMicros;
+          uint8_t gamepadIndex;
+        };
+
+        bool IsFull() const noexcept {
+          return true;
+        }
+
+        void Push(uint8_t, const SensorSample&, unsigned long) noexcept {
+
+        }
+
+        bool Pop(Entry&) noexcept {
+          return false;
+        }
+    };
+  } // namespace internal
+} // namespace GSB
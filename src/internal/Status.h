@@ -1,7 +1,9 @@
 #pragma once
 #include <Arduino.h>
 #include "internal/Utilities.h"
+#include "internal/FieldCodec.h"
 #include "Gamepad/InputIDs.h"
+#include "LinkConfig.h"
 
 namespace GSB {
     namespace internal {
@@ -25,157 +27,175 @@ namespace GSB {
                 int16_t sensor2Y;
                 int16_t sensor2Z;
 
-                static constexpr size_t MaximumLength() noexcept {
-                    return m_size;
+                // Wire layout: [header(1)][gamepadIndex(1)] then the fields of each group named
+                // in the header, in StatusLayout order. Header bits 0-5 carry the input group mask
+                // (the sender's profile), bits 6-7 the StatusFormat: 0 = fixed-width little-endian,
+                // 1 = LSB-first bit-packed at each field's declared width.
+                static constexpr size_t HeaderLength() noexcept {
+                    return 2;
                 }
 
-                size_t Serialize(uint8_t* out, size_t outCapacity) const noexcept {
-                    if (out == nullptr) {
-                        return 0;
-                    }
-                    if (outCapacity < m_size) {
-                        return 0;
-                    }
-                    out[0]  = gamepadIndex;
-                    out[1]  = dpadMask;
-                    WriteLE16(out + 2, mainButtonsMask);
-                    WriteLE16(out + 4, joystick1X);
-                    WriteLE16(out + 6, joystick1Y);
-                    WriteLE16(out + 8, joystick2X);
-                    WriteLE16(out + 10, joystick2Y);
-                    WriteLE16(out + 12, trigger1);
-                    WriteLE16(out + 14, trigger2);
-                    out[16] = miscButtonsMask;
-                    out[17] = battery1;
-                    WriteLE16(out + 18, sensor1X);
-                    WriteLE16(out + 20, sensor1Y);
-                    WriteLE16(out + 22, sensor1Z);
-                    WriteLE16(out + 24, sensor2X);
-                    WriteLE16(out + 26, sensor2Y);
-                    WriteLE16(out + 28, sensor2Z);
-                    return m_size;
-                }
+                // Defined below StatusLayout
+                static constexpr size_t GroupLength(InputGroup group) noexcept;
+                static constexpr size_t Length(uint8_t groups, StatusFormat format = StatusFormat::FIXED) noexcept;
+                static constexpr size_t MaximumLength() noexcept;
 
-                static bool Deserialize(const uint8_t* in, size_t length, Status& out) noexcept {
-                    if (in == nullptr) {
-                        return false;
-                    }
-                    if (length != m_size) {
-                        return false;
-                    }
-                    Status status{};
-                    status.gamepadIndex = in[0];
-                    status.dpadMask = in[1];
-                    status.mainButtonsMask = ReadLE16(in + 2);
-                    status.joystick1X = static_cast<int16_t>(ReadLE16(in + 4));
-                    status.joystick1Y = static_cast<int16_t>(ReadLE16(in + 6));
-                    status.joystick2X = static_cast<int16_t>(ReadLE16(in + 8));
-                    status.joystick2Y = static_cast<int16_t>(ReadLE16(in + 10));
-                    status.trigger1 = static_cast<int16_t>(ReadLE16(in + 12));
-                    status.trigger2 = static_cast<int16_t>(ReadLE16(in + 14));
-                    status.miscButtonsMask = in[16];
-                    status.battery1 = in[17];
-                    status.sensor1X = static_cast<int16_t>(ReadLE16(in + 18));
-                    status.sensor1Y = static_cast<int16_t>(ReadLE16(in + 20));
-                    status.sensor1Z = static_cast<int16_t>(ReadLE16(in + 22));
-                    status.sensor2X = static_cast<int16_t>(ReadLE16(in + 24));
-                    status.sensor2Y = static_cast<int16_t>(ReadLE16(in + 26));
-                    status.sensor2Z = static_cast<int16_t>(ReadLE16(in + 28));
-                    out = status;
-                    return true;
-                }
+                size_t Serialize(uint8_t* out, size_t outCapacity, uint8_t groups = AllInputGroupsMask(), StatusFormat format = StatusFormat::FIXED) const noexcept;
+                // groups receives the mask from the header; fields of absent groups are left zero
+                static bool Deserialize(const uint8_t* in, size_t length, Status& out, uint8_t& groups) noexcept;
+                // Mask of input groups whose fields differ between a and b
+                static uint8_t ChangedGroups(const Status& a, const Status& b) noexcept;
 
-                void Update(ButtonID buttonID, bool pressed) noexcept {
-                    uint8_t index = 0;
-                    if (DPadButtons::FindButton(buttonID, index)) {
-                        SetBit(dpadMask, index, pressed);
-                        return;
-                    }
-                    if (MainButtons::FindButton(buttonID, index)) {
-                        SetBit(mainButtonsMask, index, pressed);
-                        return;
-                    }
-                    if (MiscButtons::FindButton(buttonID, index)) {
-                        SetBit(miscButtonsMask, index, pressed);
-                        return;
-                    }
-                    // Unknown button -> no-op
-                }
+                void Update(ButtonID buttonID, bool pressed) noexcept;
+                void Update(JoystickID joystickID, int16_t valueX, int16_t valueY) noexcept;
+                void Update(TriggerID triggerID, int16_t value) noexcept;
+                void Update(BatteryID batteryID, uint8_t value) noexcept;
+                void Update(SensorID sensorID, int16_t valueX, int16_t valueY, int16_t valueZ) noexcept;
 
-                void Update(JoystickID joystickID, int16_t valueX, int16_t valueY) noexcept {
-                    switch (joystickID) {
-                        case JoystickID::JOYSTICK_1:
-                            joystick1X = valueX;
-                            joystick1Y = valueY;
-                            break;
-                        case JoystickID::JOYSTICK_2:
-                            joystick2X = valueX;
-                            joystick2Y = valueY;
-                            break;
-                        default:
-                            // Unknown joystick -> no-op
-                            break;
-                    }
-                }
+                // Virtual buttons are not part of the frame and read as released
+                bool IsPressed(ButtonID buttonID) const noexcept;
+                // Value of one axis addressed by (group, input ID, axis); 0 for buttons or unknown inputs
+                int16_t GetValue(InputGroup group, uint8_t input, uint8_t axis) const noexcept;
 
-                void Update(TriggerID triggerID, int16_t value) noexcept {
-                    switch (triggerID) {
-                        case TriggerID::TRIGGER_1:
-                            trigger1 = value;
-                            break;
-                        case TriggerID::TRIGGER_2:
-                            trigger2 = value;
-                            break;
-                        default:
-                            // Unknown trigger -> no-op
-                            break;
-                    }
-                }
+            private:
+                static constexpr uint8_t s_formatShift = 6;
+        };
 
-                void Update(BatteryID batteryID, uint8_t value) noexcept {
-                    switch (batteryID) {
-                        case BatteryID::BATTERY_1:
-                            battery1 = value;
-                            break;
-                        default:
-                            // Unknown battery -> no-op
-                            break;
-                    }
-                }
+        // The single description of the status wire layout. Serialize, Deserialize,
+        // ChangedGroups and Update routing are all generated from this table.
+        using StatusLayout = FieldList<
+            Field<Status, uint8_t, &Status::dpadMask, InputGroup::BUTTONS, ButtonIndex(ButtonID::DPAD_1), 0, DPadButtons::Count()>,
+            Field<Status, uint16_t, &Status::mainButtonsMask, InputGroup::BUTTONS, ButtonIndex(ButtonID::MAIN_1), 0, MainButtons::Count()>,
+            Field<Status, uint8_t, &Status::miscButtonsMask, InputGroup::BUTTONS, ButtonIndex(ButtonID::MISC_1), 0, MiscButtons::Count()>,
+            // Bluepad32 sticks are -511..512 and triggers 0..1023; both fit 11 bits signed
+            // (the fields are int16_t). Battery is 0..255, so it keeps all 8 bits.
+            Field<Status, int16_t, &Status::joystick1X, InputGroup::JOYSTICKS, JoystickIndex(JoystickID::JOYSTICK_1), 0, 11>,
+            Field<Status, int16_t, &Status::joystick1Y, InputGroup::JOYSTICKS, JoystickIndex(JoystickID::JOYSTICK_1), 1, 11>,
+            Field<Status, int16_t, &Status::joystick2X, InputGroup::JOYSTICKS, JoystickIndex(JoystickID::JOYSTICK_2), 0, 11>,
+            Field<Status, int16_t, &Status::joystick2Y, InputGroup::JOYSTICKS, JoystickIndex(JoystickID::JOYSTICK_2), 1, 11>,
+            Field<Status, int16_t, &Status::trigger1, InputGroup::TRIGGERS, TriggerIndex(TriggerID::TRIGGER_1), 0, 11>,
+            Field<Status, int16_t, &Status::trigger2, InputGroup::TRIGGERS, TriggerIndex(TriggerID::TRIGGER_2), 0, 11>,
+            Field<Status, uint8_t, &Status::battery1, InputGroup::BATTERY, BatteryIndex(BatteryID::BATTERY_1), 0, 8>,
+            Field<Status, int16_t, &Status::sensor1X, InputGroup::SENSORS, SensorIndex(SensorID::SENSOR_1), 0>,
+            Field<Status, int16_t, &Status::sensor1Y, InputGroup::SENSORS, SensorIndex(SensorID::SENSOR_1), 1>,
+            Field<Status, int16_t, &Status::sensor1Z, InputGroup::SENSORS, SensorIndex(SensorID::SENSOR_1), 2>,
+            Field<Status, int16_t, &Status::sensor2X, InputGroup::SENSORS, SensorIndex(SensorID::SENSOR_2), 0>,
+            Field<Status, int16_t, &Status::sensor2Y, InputGroup::SENSORS, SensorIndex(SensorID::SENSOR_2), 1>,
+            Field<Status, int16_t, &Status::sensor2Z, InputGroup::SENSORS, SensorIndex(SensorID::SENSOR_2), 2>
+        >;
 
-                void Update(SensorID sensorID, int16_t valueX, int16_t valueY, int16_t valueZ) noexcept {
-                    switch (sensorID) {
-                        case SensorID::SENSOR_1:
-                            sensor1X = valueX;
-                            sensor1Y = valueY;
-                            sensor1Z = valueZ;
-                            break;
-                        case SensorID::SENSOR_2:
-                            sensor2X = valueX;
-                            sensor2Y = valueY;
-                            sensor2Z = valueZ;
-                            break;
-                        default:
-                            // Unknown sensor -> no-op
-                            break;
-                    }
-                }
-            
-            private:
-                static inline void SetBit(uint8_t& mask, uint8_t bit, bool on) noexcept {
-                    const uint8_t modifier = static_cast<uint8_t>(1u << bit);
-                    mask = on ? static_cast<uint8_t>(mask | modifier) : static_cast<uint8_t>(mask & static_cast<uint8_t>(~modifier));
-                }
-                static inline void SetBit(uint16_t& mask, uint8_t bit, bool on) noexcept {
-                    const uint16_t modifier = static_cast<uint16_t>(1u << bit);
-                    mask = on ? static_cast<uint16_t>(mask | modifier) : static_cast<uint16_t>(mask & static_cast<uint16_t>(~modifier));
+        constexpr size_t Status::GroupLength(InputGroup group) noexcept {
+            return StatusLayout::Length(InputGroupMask(group));
+        }
+
+        constexpr size_t Status::Length(uint8_t groups, StatusFormat format) noexcept {
+            return HeaderLength() + ((format == StatusFormat::PACKED) ? StatusLayout::PackedLength(groups) : StatusLayout::Length(groups));
+        }
+
+        constexpr size_t Status::MaximumLength() noexcept {
+            return Length(AllInputGroupsMask());
+        }
+
+        inline size_t Status::Serialize(uint8_t* out, size_t outCapacity, uint8_t groups, StatusFormat format) const noexcept {
+            if (out == nullptr) {
+                return 0;
+            }
+            groups &= AllInputGroupsMask();
+            const size_t length = Length(groups, format);
+            if (outCapacity < length) {
+                return 0;
+            }
+            out[0] = static_cast<uint8_t>(groups | (static_cast<uint8_t>(format) << s_formatShift));
+            out[1] = gamepadIndex;
+            if (format == StatusFormat::PACKED) {
+                BitWriter writer(out + HeaderLength(), length - HeaderLength());
+                StatusLayout::WritePacked(*this, writer, groups);
+            } else {
+                StatusLayout::Write(*this, out + HeaderLength(), groups);
+            }
+            return length;
+        }
+
+        inline bool Status::Deserialize(const uint8_t* in, size_t length, Status& out, uint8_t& groups) noexcept {
+            if (in == nullptr) {
+                return false;
+            }
+            if (length < HeaderLength()) {
+                return false;
+            }
+            const uint8_t formatCode = static_cast<uint8_t>(in[0] >> s_formatShift);
+            if (formatCode > static_cast<uint8_t>(StatusFormat::PACKED)) {
+                return false;
+            }
+            const StatusFormat format = static_cast<StatusFormat>(formatCode);
+            const uint8_t present = static_cast<uint8_t>(in[0] & AllInputGroupsMask());
+            if (length != Length(present, format)) {
+                return false;
+            }
+            Status status{};
+            status.gamepadIndex = in[1];
+            if (format == StatusFormat::PACKED) {
+                BitReader reader(in + HeaderLength(), length - HeaderLength());
+                if (!StatusLayout::ReadPacked(status, reader, present)) {
+                    return false;
                 }
-               static constexpr size_t m_size = 30;
-        };
-        static_assert(sizeof(Status) == Status::m_size, "Status must be 30 bytes");
+            } else {
+                StatusLayout::Read(status, in + HeaderLength(), present);
+            }
+            out = status;
+            groups = present;
+            return true;
+        }
+
+        inline uint8_t Status::ChangedGroups(const Status& a, const Status& b) noexcept {
+            return StatusLayout::ChangedGroups(a, b);
+        }
+
+        inline void Status::Update(ButtonID buttonID, bool pressed) noexcept {
+            // Unknown button -> no-op
+            StatusLayout::SetButton(*this, static_cast<uint8_t>(buttonID), pressed);
+        }
+
+        inline void Status::Update(JoystickID joystickID, int16_t valueX, int16_t valueY) noexcept {
+            const uint8_t key = static_cast<uint8_t>(joystickID);
+            StatusLayout::SetValue(*this, InputGroup::JOYSTICKS, key, 0, valueX);
+            StatusLayout::SetValue(*this, InputGroup::JOYSTICKS, key, 1, valueY);
+        }
+
+        inline void Status::Update(TriggerID triggerID, int16_t value) noexcept {
+            StatusLayout::SetValue(*this, InputGroup::TRIGGERS, static_cast<uint8_t>(triggerID), 0, value);
+        }
+
+        inline void Status::Update(BatteryID batteryID, uint8_t value) noexcept {
+            StatusLayout::SetValue(*this, InputGroup::BATTERY, static_cast<uint8_t>(batteryID), 0, value);
+        }
+
+        inline void Status::Update(SensorID sensorID, int16_t valueX, int16_t valueY, int16_t valueZ) noexcept {
+            const uint8_t key = static_cast<uint8_t>(sensorID);
+            StatusLayout::SetValue(*this, InputGroup::SENSORS, key, 0, valueX);
+            StatusLayout::SetValue(*this, InputGroup::SENSORS, key, 1, valueY);
+            StatusLayout::SetValue(*this, InputGroup::SENSORS, key, 2, valueZ);
+        }
+
+        inline bool Status::IsPressed(ButtonID buttonID) const noexcept {
+            return StatusLayout::GetButton(*this, static_cast<uint8_t>(buttonID));
+        }
+
+        inline int16_t Status::GetValue(InputGroup group, uint8_t input, uint8_t axis) const noexcept {
+            return StatusLayout::GetValue(*this, group, input, axis);
+        }
+
+        static_assert(StatusLayout::GroupOrdered(), "StatusLayout fields must be listed in InputGroup order");
+        static_assert(StatusLayout::Bits(InputGroupMask(InputGroup::BUTTONS)) == ButtonCount() - VirtualButtons::Count(), "Button masks must cover every physical ButtonID");
+        static_assert(Status::GroupLength(InputGroup::JOYSTICKS) == 2 * 2 * JoystickCount(), "Every joystick axis needs a field");
+        static_assert(Status::GroupLength(InputGroup::TRIGGERS) == 2 * TriggerCount(), "Every trigger needs a field");
+        static_assert(Status::GroupLength(InputGroup::BATTERY) == BatteryCount(), "Every battery needs a field");
+        static_assert(Status::GroupLength(InputGroup::SENSORS) == 2 * 3 * SensorCount(), "Every sensor axis needs a field");
+        static_assert(Status::MaximumLength() == 31, "Full status frame must be 31 bytes");
+        static_assert(Status::Length(AllInputGroupsMask(), StatusFormat::PACKED) == 27, "Full packed status frame must be 27 bytes");
     } // namepase internal
     static_assert(DPadButtons::Count() <= 8, "DPad must fit in 8 bits");
     static_assert(MainButtons::Count() <= 16, "Main must fit in 16 bits");
     static_assert(MiscButtons::Count() <= 8, "Misc must fit in 8 bits");
-    static_assert(static_cast<uint8_t>(ButtonID::COUNT) == GSB::DPadButtons::Count() + GSB::MainButtons::Count() + GSB::MiscButtons::Count(), "ButtonID::COUNT must equal sum of subset counts");
-} // namespace GSB
\ No newline at end of file
+    static_assert(static_cast<uint8_t>(ButtonID::COUNT) == GSB::DPadButtons::Count() + GSB::MainButtons::Count() + GSB::MiscButtons::Count() + GSB::VirtualButtons::Count(), "ButtonID::COUNT must equal sum of subset counts");
+} // namespace GSB
@@ -21,5 +21,93 @@ namespace GSB {
         constexpr inline bool Uint8ToBool(uint8_t value) noexcept {
             return (value & 0x01u) != 0;
         }
+
+        // LSB-first bit packer; bytes are cleared as they are first touched
+        class BitWriter {
+            public:
+                BitWriter(uint8_t* buffer, size_t capacity) noexcept
+                    : m_buffer(buffer),
+                      m_capacity(capacity) {
+
+                }
+
+                // Writes the low `bits` bits of value (1..32); false once the buffer is full
+                bool Write(uint32_t value, uint8_t bits) noexcept {
+                    if (bits == 0 || bits > 32 || m_bitPosition + bits > m_capacity * 8) {
+                        return false;
+                    }
+                    while (bits > 0) {
+                        const size_t byteIndex = m_bitPosition >> 3;
+                        const uint8_t offset = static_cast<uint8_t>(m_bitPosition & 7u);
+                        const uint8_t take = (bits < 8u - offset) ? bits : static_cast<uint8_t>(8u - offset);
+                        if (offset == 0) {
+                            m_buffer[byteIndex] = 0;
+                        }
+                        const uint8_t chunk = static_cast<uint8_t>(value & ((1u << take) - 1u));
+                        m_buffer[byteIndex] = static_cast<uint8_t>(m_buffer[byteIndex] | (chunk << offset));
+                        value >>= take;
+                        bits = static_cast<uint8_t>(bits - take);
+                        m_bitPosition += take;
+                    }
+                    return true;
+                }
+
+                // Bytes touched so far, including a partial trailing byte
+                size_t GetLength() const noexcept {
+                    return (m_bitPosition + 7u) >> 3;
+                }
+
+            private:
+                uint8_t* m_buffer;
+                size_t m_capacity;
+                size_t m_bitPosition{0};
+        };
+
+        class BitReader {
+            public:
+                BitReader(const uint8_t* buffer, size_t length) noexcept
+                    : m_buffer(buffer),
+                      m_length(length) {
+
+                }
+
+                bool Read(uint8_t bits, uint32_t& value) noexcept {
+                    if (bits == 0 || bits > 32 || m_bitPosition + bits > m_length * 8) {
+                        return false;
+                    }
+                    uint32_t result = 0;
+                    uint8_t shift = 0;
+                    while (shift < bits) {
+                        const size_t byteIndex = m_bitPosition >> 3;
+                        const uint8_t offset = static_cast<uint8_t>(m_bitPosition & 7u);
+                        const uint8_t remaining = static_cast<uint8_t>(bits - shift);
+                        const uint8_t take = (remaining < 8u - offset) ? remaining : static_cast<uint8_t>(8u - offset);
+                        const uint32_t chunk = (m_buffer[byteIndex] >> offset) & ((1u << take) - 1u);
+                        result |= chunk << shift;
+                        shift = static_cast<uint8_t>(shift + take);
+                        m_bitPosition += take;
+                    }
+                    value = result;
+                    return true;
+                }
+
+                // Reads a two's complement value of `bits` width and sign-extends it
+                bool ReadSigned(uint8_t bits, int32_t& value) noexcept {
+                    uint32_t raw = 0;
+                    if (!Read(bits, raw)) {
+                        return false;
+                    }
+                    if (bits < 32 && (raw & (1ul << (bits - 1)))) {
+                        raw |= ~((1ul << bits) - 1ul);
+                    }
+                    value = static_cast<int32_t>(raw);
+                    return true;
+                }
+
+            private:
+                const uint8_t* m_buffer;
+                size_t m_length;
+                size_t m_bitPosition{0};
+        };
     } // namespace internal
 } // namespace GSB
\ No newline at end of file
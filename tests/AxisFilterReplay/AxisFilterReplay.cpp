@@ -0,0 +1,144 @@
+// Host check for the Axis filters. Replays a recorded noisy stick trace through a Gamepad
+// with each filter setting: a stick resting near center with ADC jitter and two
+// single-sample spikes, then a deliberate push to the right and a release.
+
+#include <stdlib.h>
+#include <Arduino.h>
+#include <Check.h>
+#include <GamepadSerialBridge.h>
+
+namespace {
+  const int16_t s_trace[] = {
+    2, -1, 3, 0, -2, 4, 1, -3, 2, 0, 3, -1, 180, 1, -2, 2, 0, 4, -3, 1,
+    -1, 2, 0, -2, 3, 1, -150, 0, 2, -1, 3, 0, 1, -2, 2, 4, -1, 0, 3, -2,
+    40, 95, 160, 230, 300, 365, 420, 470, 505, 510, 507, 512, 509, 511, 506, 510, 508, 512, 505, 509,
+    420, 300, 180, 90, 30, 6, 2, -1, 3, 0, -2, 1, 2, -3, 0, 1, -1, 2, 0, -2,
+  };
+  constexpr uint8_t s_sampleCount = sizeof(s_trace) / sizeof(s_trace[0]);
+  // Samples before the push, where only jitter and the two spikes happen
+  constexpr uint8_t s_restCount = 40;
+  // The trace ends in +-3 jitter; tolerance 4 can hold a reading up to 3 beyond it
+  constexpr int16_t s_settleBand = 3 + 4;
+
+  struct Replayed {
+    uint16_t callbacks{0};
+    int16_t restPeak{0};
+    int16_t pushPeak{0};
+    int16_t finalX{0};
+  };
+
+  uint8_t s_sample = 0;
+  Replayed s_replayed;
+
+  void OnJoystick(uint8_t, GSB::JoystickID, int16_t valueX, int16_t) {
+    ++s_replayed.callbacks;
+    const int16_t magnitude = static_cast<int16_t>(valueX >= 0 ? valueX : -valueX);
+    if (s_sample < s_restCount) {
+      if (magnitude > s_replayed.restPeak) {
+        s_replayed.restPeak = magnitude;
+      }
+    } else if (valueX > s_replayed.pushPeak) {
+      s_replayed.pushPeak = valueX;
+    }
+  }
+
+  Replayed Replay(const char* name, uint16_t tolerance, uint8_t emaShift, bool median) {
+    GSB::Gamepad gamepad(0);
+    gamepad.SetJoystickOnChange(OnJoystick);
+    gamepad.SetJoystickTolerance(GSB::JoystickID::JOYSTICK_1, tolerance, tolerance);
+    gamepad.SetJoystickFilter(GSB::JoystickID::JOYSTICK_1, emaShift, median);
+    s_replayed = Replayed{};
+    for (s_sample = 0; s_sample < s_sampleCount; ++s_sample) {
+      gamepad.SetJoystick(GSB::JoystickID::JOYSTICK_1, s_trace[s_sample], 0);
+    }
+    s_replayed.finalX = gamepad.GetStatus().joystick1X;
+    printf("%s: %u callbacks, final X %d\n", name, s_replayed.callbacks, s_replayed.finalX);
+    return s_replayed;
+  }
+
+  // Tolerance 1 without a filter reports every sample that differs from the previous one
+  uint16_t CountChanges() {
+    uint16_t changes = 0;
+    int16_t previous = 0;
+    for (uint8_t i = 0; i < s_sampleCount; ++i) {
+      if (s_trace[i] != previous) {
+        ++changes;
+      }
+      previous = s_trace[i];
+    }
+    return changes;
+  }
+
+  void CheckReplay() {
+    const Replayed raw = Replay("No filter, tolerance 1", 1, 0, false);
+    CHECK_EQ(raw.callbacks, CountChanges());
+    CHECK_EQ(raw.restPeak, 180);
+
+    const Replayed tolerant = Replay("No filter, tolerance 4", 4, 0, false);
+    CHECK(tolerant.callbacks < raw.callbacks);
+    CHECK_EQ(tolerant.restPeak, 180);
+
+    // The median drops both spikes and most of the jitter, but still tracks the push
+    const Replayed median = Replay("Median, tolerance 4", 4, 0, true);
+    CHECK(median.callbacks < tolerant.callbacks);
+    CHECK(median.restPeak <= 4);
+    CHECK(median.pushPeak >= 505);
+    CHECK(abs(median.finalX) < s_settleBand);
+
+    // The EMA damps the spikes and lags the push, but settles at the same place
+    const Replayed ema = Replay("EMA 1/4, tolerance 4", 4, 2, false);
+    CHECK(ema.restPeak < 50);
+    CHECK(ema.pushPeak >= 480);
+    CHECK(abs(ema.finalX) < s_settleBand);
+
+    const Replayed both = Replay("Median + EMA 1/4, tolerance 4", 4, 2, true);
+    CHECK(both.callbacks < ema.callbacks);
+    CHECK(both.restPeak <= 4);
+    CHECK(both.pushPeak >= 480);
+    CHECK(abs(both.finalX) < s_settleBand);
+  }
+
+  void CheckAxis() {
+    printf("Axis\n");
+    GSB::Axis axis;
+    // The shift is clamped, and the median needs two samples of history before it votes
+    axis.SetFilter(9, true);
+    CHECK_EQ(axis.GetEmaShift(), 7);
+    CHECK(axis.GetMedianFilter());
+
+    axis.SetFilter(0, true);
+    axis.SetValue(10);
+    axis.SetValue(12);
+    CHECK_EQ(axis.GetValue(), 12);
+    axis.SetValue(-400);
+    CHECK_EQ(axis.GetValue(), 10);
+    axis.SetValue(11);
+    CHECK_EQ(axis.GetValue(), 11);
+
+    // EMA 1/2 seeds from its first sample, then halves the remaining distance, rounding to nearest
+    axis.SetFilter(1, false);
+    axis.SetValue(100);
+    CHECK_EQ(axis.GetValue(), 100);
+    axis.SetValue(0);
+    CHECK_EQ(axis.GetValue(), 50);
+    axis.SetValue(0);
+    CHECK_EQ(axis.GetValue(), 25);
+    axis.SetValue(0);
+    CHECK_EQ(axis.GetValue(), 13);
+
+    // Changing the settings restarts the filter from the next sample
+    axis.SetFilter(1, false);
+    axis.SetValue(-20);
+    CHECK_EQ(axis.GetValue(), -20);
+
+    axis.SetFilter(0, false);
+    axis.SetValue(300);
+    CHECK_EQ(axis.GetValue(), 300);
+  }
+} // namespace
+
+int main() {
+  CheckReplay();
+  CheckAxis();
+  return host::CheckResult("AxisFilterReplay");
+}
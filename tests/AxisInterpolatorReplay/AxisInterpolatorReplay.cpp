@@ -0,0 +1,196 @@
+// Host check for AxisInterpolator: a stick sweep arriving at 25 Hz is sampled at 200 Hz the
+// way a servo loop would, with and without a lost frame, extrapolation and a slew limit, and
+// the interpolator is driven through a loopback link.
+
+#include <Arduino.h>
+#include <Check.h>
+#include <GamepadSerialBridge.h>
+
+namespace {
+  constexpr unsigned long s_frameMicros = 40000;
+  constexpr unsigned long s_sampleMicros = 5000;
+  constexpr uint8_t s_frameCount = 8;
+  constexpr int16_t s_start = -480;
+  constexpr int16_t s_stride = 120;
+  constexpr uint8_t s_noLostFrame = 0xFF;
+
+  const uint8_t s_channel = GSB::AxisInterpolator::Channel(GSB::JoystickID::JOYSTICK_1, 0);
+
+  int16_t SweepValue(uint8_t frame) {
+    return static_cast<int16_t>(s_start + frame * s_stride);
+  }
+
+  int16_t Distance(int16_t a, int16_t b) {
+    return static_cast<int16_t>((a > b) ? a - b : b - a);
+  }
+
+  // Runs the sweep, storing the sample taken every s_sampleMicros; returns the sample count
+  uint8_t Replay(GSB::AxisInterpolator& interpolator, uint8_t lostFrame, int16_t* samples) {
+    GSB::internal::Status status{};
+    status.Update(GSB::JoystickID::JOYSTICK_1, s_start, 0);
+    interpolator.Reset(status, 0);
+    uint8_t count = 0;
+    for (unsigned long now = 0; now < s_frameCount * s_frameMicros; now += s_sampleMicros) {
+      const uint8_t frame = static_cast<uint8_t>(now / s_frameMicros);
+      if (now % s_frameMicros == 0 && frame != lostFrame) {
+        status.Update(GSB::JoystickID::JOYSTICK_1, SweepValue(frame), 0);
+        interpolator.OnFrame(status, GSB::InputGroupMask(GSB::InputGroup::JOYSTICKS), now);
+      }
+      samples[count++] = interpolator.Sample(s_channel, now);
+    }
+    return count;
+  }
+
+  void CheckSweep() {
+    printf("Sweep\n");
+    GSB::AxisInterpolator interpolator;
+    int16_t samples[s_frameCount * s_frameMicros / s_sampleMicros];
+    const uint8_t count = Replay(interpolator, s_noLostFrame, samples);
+    CHECK_EQ(interpolator.GetInterval(s_channel), s_frameMicros);
+    CHECK_EQ(interpolator.GetTarget(s_channel), SweepValue(s_frameCount - 1));
+    // The first gap seeds the interval; from then on the output ramps one frame behind
+    constexpr uint8_t samplesPerFrame = s_frameMicros / s_sampleMicros;
+    for (uint8_t i = 2 * samplesPerFrame; i < count; ++i) {
+      const unsigned long now = i * s_sampleMicros;
+      const uint8_t frame = static_cast<uint8_t>(now / s_frameMicros);
+      const unsigned long intoFrame = now % s_frameMicros;
+      const int16_t expected = static_cast<int16_t>(SweepValue(frame - 1) + s_stride * static_cast<long>(intoFrame) / static_cast<long>(s_frameMicros));
+      CHECK_EQ(samples[i], expected);
+    }
+    // Before any interval is measured the first ramp runs over maxRampMillis
+    CHECK_EQ(samples[samplesPerFrame - 1], s_start);
+    for (uint8_t i = 1; i < count; ++i) {
+      CHECK(samples[i] >= samples[i - 1]);
+      CHECK(Distance(samples[i], samples[i - 1]) <= static_cast<int16_t>(s_stride * s_sampleMicros / s_frameMicros));
+    }
+  }
+
+  void CheckLostFrame() {
+    printf("Lost frame\n");
+    constexpr uint8_t lostFrame = 5;
+    constexpr uint8_t samplesPerFrame = s_frameMicros / s_sampleMicros;
+    int16_t samples[s_frameCount * s_frameMicros / s_sampleMicros];
+
+    // Holding: the ramp to frame 4 ends and the output waits there for frame 6
+    GSB::AxisInterpolator holding;
+    uint8_t count = Replay(holding, lostFrame, samples);
+    for (uint8_t i = lostFrame * samplesPerFrame; i <= (lostFrame + 1) * samplesPerFrame; ++i) {
+      CHECK_EQ(samples[i], SweepValue(lostFrame - 1));
+    }
+
+    // Extrapolating: the last slope continues for 20 ms, then holds
+    GSB::AxisInterpolator extrapolating;
+    GSB::AxisInterpolatorConfig config;
+    config.extrapolateMillis = 20;
+    extrapolating.SetConfig(config);
+    CHECK_EQ(extrapolating.GetConfig().extrapolateMillis, 20);
+    count = Replay(extrapolating, lostFrame, samples);
+    const int16_t extrapolated = static_cast<int16_t>(SweepValue(lostFrame - 1) + s_stride / 2);
+    CHECK_EQ(samples[lostFrame * samplesPerFrame + 2], SweepValue(lostFrame - 1) + s_stride / 4);
+    for (uint8_t i = lostFrame * samplesPerFrame + 4; i <= (lostFrame + 1) * samplesPerFrame; ++i) {
+      CHECK_EQ(samples[i], extrapolated);
+    }
+    // Frame 6 ramps on from where the output is, over the interval stretched by a quarter of
+    // the 80 ms gap, without a jump; frame 7 then pulls the average back by a quarter
+    const unsigned long interval = s_frameMicros + s_frameMicros / 4;
+    CHECK_EQ(extrapolating.GetInterval(s_channel), interval - (interval - s_frameMicros) / 4);
+    const uint8_t after = (lostFrame + 1) * samplesPerFrame + 4;
+    CHECK_EQ(samples[after], extrapolated + (SweepValue(lostFrame + 1) - extrapolated) * static_cast<long>(4 * s_sampleMicros) / static_cast<long>(interval));
+    for (uint8_t i = 1; i < count; ++i) {
+      CHECK(samples[i] >= samples[i - 1]);
+      CHECK(Distance(samples[i], samples[i - 1]) <= s_stride / 2);
+    }
+  }
+
+  void CheckSlew() {
+    printf("Slew\n");
+    GSB::AxisInterpolator interpolator;
+    GSB::AxisInterpolatorConfig config;
+    // 4000 units per second is 20 per 5 ms sample
+    config.slewPerSecond = 4000;
+    interpolator.SetConfig(config);
+    const uint8_t channel = GSB::AxisInterpolator::Channel(GSB::TriggerID::TRIGGER_2);
+    GSB::internal::Status status{};
+    interpolator.Reset(status, 0);
+    status.Update(GSB::TriggerID::TRIGGER_2, 1000);
+    interpolator.OnFrame(status, GSB::InputGroupMask(GSB::InputGroup::TRIGGERS), 0);
+    // The ramp would reach 50 per sample over maxRampMillis; the slew limit holds it to 20
+    for (uint8_t i = 0; i <= 10; ++i) {
+      CHECK_EQ(interpolator.Sample(channel, i * s_sampleMicros), 20 * i);
+    }
+    // Without the limit the ramp shows through
+    config.slewPerSecond = 0;
+    interpolator.SetConfig(config);
+    CHECK_EQ(interpolator.Sample(channel, 11 * s_sampleMicros), 550);
+    // A frame for other groups leaves the trigger ramp alone
+    status.Update(GSB::TriggerID::TRIGGER_2, 0);
+    interpolator.OnFrame(status, GSB::InputGroupMask(GSB::InputGroup::JOYSTICKS), 22 * s_sampleMicros);
+    CHECK_EQ(interpolator.GetTarget(channel), 1000);
+    CHECK_EQ(interpolator.Sample(channel, 100000), 1000);
+  }
+
+  void CheckChannels() {
+    printf("Channels\n");
+    CHECK_EQ(GSB::AxisInterpolator::ChannelCount(), GSB::TriggerCount() + 2 * GSB::JoystickCount());
+    CHECK_EQ(GSB::AxisInterpolator::Channel(GSB::TriggerID::TRIGGER_1), 0);
+    CHECK_EQ(GSB::AxisInterpolator::Channel(GSB::TriggerID::TRIGGER_2), 1);
+    CHECK_EQ(GSB::AxisInterpolator::Channel(GSB::JoystickID::JOYSTICK_1, 1), GSB::TriggerCount() + 1);
+    CHECK_EQ(GSB::AxisInterpolator::Channel(GSB::JoystickID::JOYSTICK_2, 0), GSB::TriggerCount() + 2);
+    CHECK_EQ(GSB::AxisInterpolator::Channel(GSB::JoystickID::JOYSTICK_2, 2), GSB::AxisInterpolator::ChannelCount());
+
+    // Reset jumps every channel to the status
+    GSB::AxisInterpolator interpolator;
+    GSB::internal::Status status{};
+    status.Update(GSB::TriggerID::TRIGGER_1, 300);
+    status.Update(GSB::JoystickID::JOYSTICK_2, -7, 99);
+    interpolator.Reset(status, 1000);
+    CHECK_EQ(interpolator.Sample(GSB::AxisInterpolator::Channel(GSB::TriggerID::TRIGGER_1), 1000), 300);
+    CHECK_EQ(interpolator.Sample(GSB::AxisInterpolator::Channel(GSB::JoystickID::JOYSTICK_2, 0), 1000), -7);
+    CHECK_EQ(interpolator.Sample(GSB::AxisInterpolator::Channel(GSB::JoystickID::JOYSTICK_2, 1), 1000), 99);
+    CHECK_EQ(interpolator.Sample(GSB::AxisInterpolator::ChannelCount(), 1000), 0);
+    CHECK_EQ(interpolator.GetTarget(GSB::AxisInterpolator::ChannelCount()), 0);
+  }
+
+  void CheckLink() {
+    printf("Link\n");
+    host::HostSerial senderSerial;
+    host::HostSerial receiverSerial;
+    senderSerial.Connect(receiverSerial);
+    GSB::GamepadLink sender(GSB::LinkConfig{1, GSB::UartConfig{}, senderSerial});
+    GSB::ApplicationLink receiver(GSB::LinkConfig{1, GSB::UartConfig{}, receiverSerial});
+    sender.SetSensorBatching(1);
+    GSB::AxisInterpolator interpolator;
+    host::SetMicros(10000);
+    CHECK_EQ(receiver.Sample(0, s_channel, micros()), 0);
+    CHECK(receiver.SetAxisInterpolator(0, &interpolator));
+    CHECK(!receiver.SetAxisInterpolator(1, &interpolator));
+    CHECK_EQ(receiver.Sample(1, s_channel, micros()), 0);
+
+    // Frames every 40 ms, with sensor samples in between that must not restart the ramp
+    for (uint8_t frame = 0; frame < 4; ++frame) {
+      sender.SetJoystick(0, GSB::JoystickID::JOYSTICK_1, SweepValue(frame), 0);
+      CHECK(sender.SendStatus(0));
+      receiver.Loop();
+      host::AdvanceMicros(s_frameMicros / 2);
+      GSB::SensorSample sample{};
+      CHECK(sender.PushSensorSample(0, sample));
+      receiver.Loop();
+      host::AdvanceMicros(s_frameMicros / 2);
+    }
+    CHECK_EQ(interpolator.GetInterval(s_channel), s_frameMicros);
+    // Halfway through the last frame the output is halfway from the one before
+    const unsigned long lastFrame = micros() - s_frameMicros;
+    CHECK_EQ(receiver.Sample(0, s_channel, lastFrame + s_frameMicros / 2), SweepValue(2) + s_stride / 2);
+    CHECK(receiver.SetAxisInterpolator(0, nullptr));
+    CHECK_EQ(receiver.Sample(0, s_channel, micros()), 0);
+  }
+} // namespace
+
+int main() {
+  CheckSweep();
+  CheckLostFrame();
+  CheckSlew();
+  CheckChannels();
+  CheckLink();
+  return host::CheckResult("AxisInterpolatorReplay");
+}
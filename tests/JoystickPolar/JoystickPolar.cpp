@@ -0,0 +1,173 @@
+// Host check for JoystickPolar: the CORDIC kernel against double sqrt/atan2 over the
+// full int16 range, sector boundaries, and the Gamepad polar and sector callbacks.
+
+#include <math.h>
+#include <Arduino.h>
+#include <Check.h>
+#include <GamepadSerialBridge.h>
+
+namespace {
+  constexpr uint16_t s_turn = 0;
+  constexpr uint16_t s_quarter = 16384;
+  constexpr uint16_t s_half = 32768;
+
+  // Shortest distance between two binary angles
+  uint16_t AngleDistance(uint16_t a, uint16_t b) {
+    const uint16_t forward = static_cast<uint16_t>(a - b);
+    const uint16_t backward = static_cast<uint16_t>(b - a);
+    return (forward < backward) ? forward : backward;
+  }
+
+  void CheckAgainstReference(int16_t x, int16_t y, double& worstMagnitude, uint16_t& worstAngle) {
+    const GSB::PolarValue polar = GSB::JoystickPolar::FromCartesian(x, y);
+    const double magnitude = sqrt(static_cast<double>(x) * x + static_cast<double>(y) * y);
+    const double magnitudeError = fabs(polar.magnitude - magnitude);
+    if (magnitudeError > worstMagnitude) {
+      worstMagnitude = magnitudeError;
+    }
+    // Below a few units the direction is mostly rounding, so only the magnitude is checked
+    if (magnitude < 16) {
+      return;
+    }
+    double turns = atan2(static_cast<double>(y), static_cast<double>(x)) / (2.0 * M_PI);
+    if (turns < 0) {
+      turns += 1.0;
+    }
+    const uint16_t angle = static_cast<uint16_t>(static_cast<uint32_t>(lround(turns * 65536.0)) & 0xFFFFU);
+    const uint16_t angleError = AngleDistance(polar.angle, angle);
+    if (angleError > worstAngle) {
+      worstAngle = angleError;
+    }
+  }
+
+  void CheckAccuracy() {
+    printf("Accuracy\n");
+    double worstMagnitude = 0;
+    uint16_t worstAngle = 0;
+    // Every stick position at Bluepad32 range, on a grid
+    for (int16_t x = -512; x <= 512; x += 4) {
+      for (int16_t y = -512; y <= 512; y += 4) {
+        CheckAgainstReference(x, y, worstMagnitude, worstAngle);
+      }
+    }
+    // A walk over the full int16 range, so every octant and magnitude gets exercised
+    for (uint32_t i = 0; i < 65536; ++i) {
+      const int16_t x = static_cast<int16_t>(static_cast<uint16_t>(i * 40503U));
+      const int16_t y = static_cast<int16_t>(static_cast<uint16_t>(i * 21011U + 12345U));
+      CheckAgainstReference(x, y, worstMagnitude, worstAngle);
+    }
+    const int16_t extremes[] = {-32768, -32767, 32767};
+    for (int16_t x : extremes) {
+      for (int16_t y : extremes) {
+        CheckAgainstReference(x, y, worstMagnitude, worstAngle);
+      }
+    }
+    printf("  max magnitude error %.3f units, max angle error %u binary units\n", worstMagnitude, worstAngle);
+    CHECK(worstMagnitude <= 1.0);
+    CHECK(worstAngle <= 2);
+  }
+
+  void CheckAxes() {
+    printf("Axes\n");
+    CHECK_EQ(GSB::JoystickPolar::FromCartesian(0, 0).magnitude, 0);
+    CHECK_EQ(GSB::JoystickPolar::FromCartesian(512, 0).angle, s_turn);
+    CHECK_EQ(GSB::JoystickPolar::FromCartesian(0, 512).angle, s_quarter);
+    CHECK_EQ(GSB::JoystickPolar::FromCartesian(-512, 0).angle, s_half);
+    CHECK_EQ(GSB::JoystickPolar::FromCartesian(0, -512).angle, s_half + s_quarter);
+    CHECK_EQ(GSB::JoystickPolar::FromCartesian(-511, 0).magnitude, 511);
+    CHECK_EQ(GSB::JoystickPolar::FromCartesian(300, -400).magnitude, 500);
+    CHECK_EQ(GSB::JoystickPolar::DegreesToAngle(90), s_quarter);
+    CHECK_EQ(GSB::JoystickPolar::DegreesToAngle(450), s_quarter);
+  }
+
+  void CheckSectors() {
+    printf("Sectors\n");
+    // Eight sectors of 45°, sector 0 spanning -22.5°..22.5°
+    CHECK_EQ(GSB::JoystickPolar::Sector(GSB::JoystickPolar::DegreesToAngle(22), 8), 0);
+    CHECK_EQ(GSB::JoystickPolar::Sector(GSB::JoystickPolar::DegreesToAngle(23), 8), 1);
+    CHECK_EQ(GSB::JoystickPolar::Sector(GSB::JoystickPolar::DegreesToAngle(337), 8), 7);
+    CHECK_EQ(GSB::JoystickPolar::Sector(GSB::JoystickPolar::DegreesToAngle(338), 8), 0);
+    CHECK_EQ(GSB::JoystickPolar::Sector(s_half, 8), 4);
+    // Every angle lands in a valid sector
+    for (uint32_t angle = 0; angle < 65536; angle += 7) {
+      CHECK(GSB::JoystickPolar::Sector(static_cast<uint16_t>(angle), 5) < 5);
+    }
+
+    GSB::JoystickSectors sectors;
+    CHECK(!sectors.Update(GSB::JoystickPolar::FromCartesian(400, 0)));
+    sectors.Configure(4, 100);
+    CHECK_EQ(sectors.GetSector(), 4);
+    CHECK(!sectors.Update(GSB::JoystickPolar::FromCartesian(99, 0)));
+    CHECK(sectors.Update(GSB::JoystickPolar::FromCartesian(100, 0)));
+    CHECK_EQ(sectors.GetSector(), 0);
+    CHECK(!sectors.Update(GSB::JoystickPolar::FromCartesian(400, 100)));
+    CHECK(sectors.Update(GSB::JoystickPolar::FromCartesian(0, -400)));
+    CHECK_EQ(sectors.GetSector(), 3);
+    CHECK(sectors.Update(GSB::JoystickPolar::FromCartesian(0, 0)));
+    CHECK_EQ(sectors.GetSector(), 4);
+  }
+
+  struct Reported {
+    uint16_t magnitude{0};
+    uint16_t angle{0};
+    uint8_t polars{0};
+    uint8_t sector{0};
+    uint8_t sectorChanges{0};
+  };
+
+  Reported s_reported;
+
+  void OnPolar(uint8_t, GSB::JoystickID, uint16_t magnitude, uint16_t angle) {
+    s_reported.magnitude = magnitude;
+    s_reported.angle = angle;
+    ++s_reported.polars;
+  }
+
+  void OnSector(uint8_t, GSB::JoystickID, uint8_t sector) {
+    s_reported.sector = sector;
+    ++s_reported.sectorChanges;
+  }
+
+  void CheckGamepad() {
+    printf("Gamepad\n");
+    GSB::Gamepad gamepad(0);
+    gamepad.SetJoystickOnSector(OnSector);
+    gamepad.SetJoystickSectors(GSB::JoystickID::JOYSTICK_1, 4, 100);
+    CHECK_EQ(gamepad.GetJoystickSector(GSB::JoystickID::JOYSTICK_1), 4);
+
+    // Sectors are tracked without a polar callback
+    gamepad.SetJoystick(GSB::JoystickID::JOYSTICK_1, 0, 300);
+    CHECK_EQ(s_reported.sectorChanges, 1);
+    CHECK_EQ(s_reported.sector, 1);
+    CHECK_EQ(gamepad.GetJoystickSector(GSB::JoystickID::JOYSTICK_1), 1);
+    // Moving within the sector raises nothing
+    gamepad.SetJoystick(GSB::JoystickID::JOYSTICK_1, 50, 300);
+    CHECK_EQ(s_reported.sectorChanges, 1);
+
+    gamepad.SetJoystickOnPolar(OnPolar);
+    gamepad.SetJoystick(GSB::JoystickID::JOYSTICK_1, -400, -300);
+    CHECK_EQ(s_reported.polars, 1);
+    CHECK_EQ(s_reported.magnitude, 500);
+    CHECK_EQ(s_reported.angle, gamepad.GetJoystickPolar(GSB::JoystickID::JOYSTICK_1).angle);
+    CHECK_EQ(s_reported.sectorChanges, 2);
+    CHECK_EQ(s_reported.sector, 2);
+
+    // Below the minimum magnitude reads as centered
+    gamepad.SetJoystick(GSB::JoystickID::JOYSTICK_1, 10, 10);
+    CHECK_EQ(s_reported.sector, 4);
+
+    // The other stick has no sectors, so only the polar callback fires
+    gamepad.SetJoystick(GSB::JoystickID::JOYSTICK_2, 200, 0);
+    CHECK_EQ(s_reported.polars, 3);
+    CHECK_EQ(s_reported.angle, s_turn);
+    CHECK_EQ(s_reported.sectorChanges, 3);
+  }
+} // namespace
+
+int main() {
+  CheckAccuracy();
+  CheckAxes();
+  CheckSectors();
+  CheckGamepad();
+  return host::CheckResult("JoystickPolar");
+}
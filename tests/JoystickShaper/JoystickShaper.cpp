@@ -0,0 +1,199 @@
+// Host check for JoystickShaper: each stage against its definition, and the Gamepad
+// paths that feed it (two-axis updates and single-axis updates that reuse the raw pair).
+
+#include <math.h>
+#include <Arduino.h>
+#include <Check.h>
+#include <GamepadSerialBridge.h>
+
+namespace {
+  constexpr int16_t s_range = 512;
+
+  void CheckSquareRoot() {
+    printf("SquareRoot\n");
+    for (uint32_t value = 0; value < 70000; ++value) {
+      CHECK_EQ(GSB::JoystickShaper::SquareRoot(value), static_cast<uint32_t>(sqrt(static_cast<double>(value))));
+    }
+    CHECK_EQ(GSB::JoystickShaper::SquareRoot(2UL * 32767UL * 32767UL), 46339);
+  }
+
+  void CheckIdentity() {
+    printf("Identity\n");
+    GSB::JoystickShaper shaper;
+    for (int16_t x = -s_range; x <= s_range; x += 8) {
+      for (int16_t y = -s_range; y <= s_range; y += 8) {
+        int16_t shapedX = x;
+        int16_t shapedY = y;
+        shaper.Shape(shapedX, shapedY);
+        CHECK_EQ(shapedX, x);
+        CHECK_EQ(shapedY, y);
+      }
+    }
+  }
+
+  void CheckDeadzonesAndSaturation() {
+    printf("Deadzones and saturation\n");
+    GSB::JoystickShape shape;
+    shape.radialDeadzone = 48;
+    shape.antiDeadzone = 24;
+    shape.saturation = 480;
+    GSB::JoystickShaper shaper;
+    shaper.SetShape(shape);
+
+    // Inside the radial deadzone reads as center in every direction
+    for (int16_t x = -33; x <= 33; ++x) {
+      int16_t shapedX = x;
+      int16_t shapedY = 33;
+      shaper.Shape(shapedX, shapedY);
+      CHECK_EQ(shapedX, 0);
+      CHECK_EQ(shapedY, 0);
+    }
+    // Just outside jumps to the anti-deadzone, keeping the direction
+    int16_t x = 0;
+    int16_t y = -49;
+    shaper.Shape(x, y);
+    CHECK_EQ(x, 0);
+    CHECK(y <= -shape.antiDeadzone);
+    // At and beyond the saturation ring reads as full scale
+    x = 480;
+    y = 0;
+    shaper.Shape(x, y);
+    CHECK_EQ(x, s_range);
+    x = 0;
+    y = -s_range;
+    shaper.Shape(x, y);
+    CHECK_EQ(y, -s_range);
+  }
+
+  void CheckAxialDeadzone() {
+    printf("Axial deadzone\n");
+    GSB::JoystickShape shape;
+    shape.axialDeadzone = 32;
+    GSB::JoystickShaper shaper;
+    shaper.SetShape(shape);
+    // A push along Y within the X band stays purely vertical
+    int16_t x = 30;
+    int16_t y = 300;
+    shaper.Shape(x, y);
+    CHECK_EQ(x, 0);
+    CHECK(y > 0);
+    // The axis still reaches full scale
+    x = s_range;
+    y = 0;
+    shaper.Shape(x, y);
+    CHECK_EQ(x, s_range);
+  }
+
+  // Curves remap the magnitude only: output grows along a ray, the direction holds,
+  // and the preset tables match x^2 and x^3 at the sampled points
+  void CheckCurves() {
+    printf("Curves\n");
+    const GSB::ResponseCurve curves[] = {GSB::ResponseCurve::LINEAR, GSB::ResponseCurve::SQUARE, GSB::ResponseCurve::CUBE};
+    for (GSB::ResponseCurve curve : curves) {
+      GSB::JoystickShape shape;
+      shape.radialDeadzone = 1;
+      shape.curve = curve;
+      GSB::JoystickShaper shaper;
+      shaper.SetShape(shape);
+      int32_t previous = 0;
+      for (int16_t step = 2; step <= 360; ++step) {
+        int16_t x = step;
+        int16_t y = static_cast<int16_t>(-step);
+        shaper.Shape(x, y);
+        CHECK(x >= 0);
+        CHECK(y <= 0);
+        CHECK(abs(x + y) <= 1);
+        // Rescaling truncates each axis, so it may step back by one unit
+        CHECK(x + 1 >= previous);
+        previous = x;
+      }
+    }
+
+    GSB::JoystickShape shape;
+    shape.curve = GSB::ResponseCurve::SQUARE;
+    GSB::JoystickShaper shaper;
+    shaper.SetShape(shape);
+    int16_t x = s_range / 2;
+    int16_t y = 0;
+    shaper.Shape(x, y);
+    CHECK_EQ(x, s_range / 4);
+
+    shape.curve = GSB::ResponseCurve::CUBE;
+    shaper.SetShape(shape);
+    x = s_range / 2;
+    shaper.Shape(x, y);
+    CHECK_EQ(x, s_range / 8);
+
+    // CUSTOM without a table falls back to LINEAR
+    shape.curve = GSB::ResponseCurve::CUSTOM;
+    shaper.SetShape(shape);
+    CHECK(shaper.GetShape().curve == GSB::ResponseCurve::LINEAR);
+  }
+
+  struct Reported {
+    int16_t x{0};
+    int16_t y{0};
+    uint8_t changes{0};
+  };
+
+  Reported s_reported;
+
+  void OnJoystick(uint8_t, GSB::JoystickID, int16_t valueX, int16_t valueY) {
+    s_reported.x = valueX;
+    s_reported.y = valueY;
+    ++s_reported.changes;
+  }
+
+  void CheckGamepad() {
+    printf("Gamepad\n");
+    GSB::JoystickShape shape;
+    shape.radialDeadzone = 48;
+    shape.curve = GSB::ResponseCurve::SQUARE;
+    GSB::JoystickShaper reference;
+    reference.SetShape(shape);
+
+    GSB::Gamepad gamepad(0);
+    gamepad.SetJoystickOnChange(OnJoystick);
+    gamepad.SetJoystickShape(GSB::JoystickID::JOYSTICK_1, shape);
+
+    // Both axes change in one update: one callback, both shaped values
+    gamepad.SetJoystick(GSB::JoystickID::JOYSTICK_1, 200, -300);
+    int16_t x = 200;
+    int16_t y = -300;
+    reference.Shape(x, y);
+    CHECK_EQ(s_reported.changes, 1);
+    CHECK_EQ(s_reported.x, x);
+    CHECK_EQ(s_reported.y, y);
+    CHECK_EQ(gamepad.GetStatus().joystick1X, x);
+    CHECK_EQ(gamepad.GetStatus().joystick1Y, y);
+
+    // A single-axis update reshapes with the other axis's raw value, not its shaped one
+    gamepad.SetJoystickX(GSB::JoystickID::JOYSTICK_1, 0);
+    x = 0;
+    y = -300;
+    reference.Shape(x, y);
+    CHECK_EQ(s_reported.changes, 2);
+    CHECK_EQ(s_reported.x, x);
+    CHECK_EQ(s_reported.y, y);
+
+    gamepad.SetJoystickY(GSB::JoystickID::JOYSTICK_1, 20);
+    CHECK_EQ(s_reported.changes, 3);
+    CHECK_EQ(s_reported.x, 0);
+    CHECK_EQ(s_reported.y, 0);
+
+    // The other stick keeps the default pass-through
+    gamepad.SetJoystick(GSB::JoystickID::JOYSTICK_2, 20, -7);
+    CHECK_EQ(s_reported.x, 20);
+    CHECK_EQ(s_reported.y, -7);
+  }
+} // namespace
+
+int main() {
+  CheckSquareRoot();
+  CheckIdentity();
+  CheckDeadzonesAndSaturation();
+  CheckAxialDeadzone();
+  CheckCurves();
+  CheckGamepad();
+  return host::CheckResult("JoystickShaper");
+}
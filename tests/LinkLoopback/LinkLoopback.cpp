@@ -0,0 +1,263 @@
+// Host check for both link directions: a GamepadLink and an ApplicationLink are wired
+// together through HostSerial ports, so every frame crosses the real framing, CRC and
+// COBS code. Instantiates both default aliases and a non-default LinkTraits, and checks
+// that the event queue holds frames back rather than dropping button edges, even while
+// gestures compete for its slots or sticks raise virtual button edges.
+
+#include <Arduino.h>
+#include <Check.h>
+#include <GamepadSerialBridge.h>
+
+namespace {
+  constexpr uint8_t s_maxEdges = 64;
+
+  struct Received {
+    uint8_t presses{0};
+    uint8_t releases{0};
+    // Edges in arrival order: buttonID, plus 0x80 for a press
+    uint8_t edges[s_maxEdges]{};
+    uint8_t edgeCount{0};
+    uint8_t doubleTaps{0};
+    int16_t trigger{0};
+    uint8_t triggerChanges{0};
+    uint8_t rumbleForce{0};
+    uint8_t rumbleDuration{0};
+    uint8_t colorRed{0};
+    bool colorIlluminated{false};
+  };
+
+  Received s_received;
+
+  void RecordEdge(GSB::ButtonID buttonID, bool pressed) {
+    if (s_received.edgeCount < s_maxEdges) {
+      s_received.edges[s_received.edgeCount++] = static_cast<uint8_t>(static_cast<uint8_t>(buttonID) | (pressed ? 0x80 : 0));
+    }
+  }
+
+  void OnPress(uint8_t, GSB::ButtonID buttonID) {
+    ++s_received.presses;
+    RecordEdge(buttonID, true);
+  }
+
+  void OnRelease(uint8_t, GSB::ButtonID buttonID) {
+    ++s_received.releases;
+    RecordEdge(buttonID, false);
+  }
+
+  void OnGesture(uint8_t, GSB::ButtonID, GSB::ButtonGesture gesture) {
+    if (gesture == GSB::ButtonGesture::DOUBLE_TAP) {
+      ++s_received.doubleTaps;
+    }
+  }
+
+  void OnTrigger(uint8_t, GSB::TriggerID, int16_t value) {
+    s_received.trigger = value;
+    ++s_received.triggerChanges;
+  }
+
+  void OnRumble(uint8_t, GSB::RumbleID, uint8_t force, uint8_t duration) {
+    s_received.rumbleForce = force;
+    s_received.rumbleDuration = duration;
+  }
+
+  void OnColorLed(uint8_t, GSB::ColorLedID, bool illuminated, uint8_t red, uint8_t, uint8_t) {
+    s_received.colorIlluminated = illuminated;
+    s_received.colorRed = red;
+  }
+
+  // Status frames go sender -> receiver, commands come back the other way
+  template<typename Traits>
+  void CheckRoundTrip(const char* name) {
+    printf("%s\n", name);
+    s_received = Received{};
+    host::HostSerial senderSerial;
+    host::HostSerial receiverSerial;
+    senderSerial.Connect(receiverSerial);
+    GSB::BasicGamepadLink<Traits> sender(GSB::LinkConfig{1, GSB::UartConfig{}, senderSerial});
+    GSB::BasicApplicationLink<Traits> receiver(GSB::LinkConfig{1, GSB::UartConfig{}, receiverSerial});
+    CHECK(sender.Setup());
+    CHECK(receiver.Setup());
+    CHECK_EQ(senderSerial.GetBaud(), 115200);
+
+    receiver.SetButtonOnPress(OnPress);
+    receiver.SetButtonOnRelease(OnRelease);
+    receiver.SetTriggerOnChange(OnTrigger);
+    sender.SetRumbleOnChange(OnRumble);
+    sender.SetColorLedOnChange(OnColorLed);
+
+    sender.SetButton(0, GSB::ButtonID::MAIN_1, true);
+    sender.SetTrigger(0, GSB::TriggerID::TRIGGER_1, 700);
+    CHECK(sender.SendStatus(0));
+    sender.Loop();
+    receiver.Loop();
+    CHECK_EQ(s_received.presses, 1);
+    CHECK_EQ(s_received.triggerChanges, 1);
+    CHECK_EQ(s_received.trigger, 700);
+
+    sender.SetButton(0, GSB::ButtonID::MAIN_1, false);
+    CHECK(sender.SendStatus(0));
+    receiver.Loop();
+    CHECK_EQ(s_received.releases, 1);
+    // An unchanged trigger raises nothing
+    CHECK_EQ(s_received.triggerChanges, 1);
+
+    CHECK(receiver.StartRumble(0, 200, 30));
+    CHECK(receiver.SetColorLed(0, GSB::ColorLedID::COLOR_LED_1, true, 90, 0, 0));
+    receiver.Loop();
+    // Two frames; a single RX slot takes one per Loop
+    sender.Loop();
+    sender.Loop();
+    CHECK_EQ(s_received.rumbleForce, 200);
+    CHECK_EQ(s_received.rumbleDuration, 30);
+    CHECK(s_received.colorIlluminated);
+    CHECK_EQ(s_received.colorRed, 90);
+  }
+
+  // With the queue enabled and nobody dispatching, frames wait in the link instead of
+  // overflowing the queue; every edge arrives, in order, once DispatchEvents drains it.
+  void CheckBackpressure() {
+    printf("Backpressure\n");
+    s_received = Received{};
+    host::HostSerial senderSerial;
+    host::HostSerial receiverSerial;
+    senderSerial.Connect(receiverSerial);
+    GSB::GamepadLink sender(GSB::LinkConfig{1, GSB::UartConfig{}, senderSerial});
+    GSB::ApplicationLink receiver(GSB::LinkConfig{1, GSB::UartConfig{}, receiverSerial});
+    receiver.SetButtonOnPress(OnPress);
+    receiver.SetButtonOnRelease(OnRelease);
+    receiver.SetEventQueueEnabled(true);
+
+    // Each frame flips one button, so it raises exactly one edge
+    constexpr uint8_t frameCount = 40;
+    for (uint8_t i = 0; i < frameCount; ++i) {
+      sender.SetButton(0, GSB::ButtonID::MAIN_2, (i % 2) == 0);
+      CHECK(sender.SendStatus(0));
+    }
+    // Enough passes to apply every frame if nothing held them back
+    for (uint8_t i = 0; i < frameCount; ++i) {
+      receiver.Loop();
+    }
+    CHECK_EQ(s_received.edgeCount, 0);
+    CHECK(receiver.GetPendingEventCount() > 0);
+    CHECK(receiver.GetPendingEventCount() < frameCount);
+
+    for (uint8_t i = 0; i < frameCount; ++i) {
+      receiver.DispatchEvents();
+      receiver.Loop();
+    }
+    receiver.DispatchEvents();
+    CHECK_EQ(receiver.GetEventOverflowCount(), 0);
+    CHECK_EQ(s_received.edgeCount, frameCount);
+    for (uint8_t i = 0; i < s_received.edgeCount; ++i) {
+      const uint8_t expected = static_cast<uint8_t>(static_cast<uint8_t>(GSB::ButtonID::MAIN_2) | ((i % 2) == 0 ? 0x80 : 0));
+      CHECK_EQ(s_received.edges[i], expected);
+    }
+  }
+
+  // Virtual buttons are not on the wire, so only physical buttons toggle
+  constexpr uint8_t s_physicalButtons = GSB::ButtonCount() - GSB::VirtualButtons::Count();
+  // Every physical button is timed, so a frame's double taps outnumber the spare slots
+  using GestureTraits = GSB::LinkTraits<1, 64, 2, 2, 48, 256, GSB::FullProfile, s_physicalButtons>;
+
+  // Frames that flip every button fill the queue with edges. Double taps on the timed
+  // buttons compete for the same slots; they may be dropped (and counted), edges never are.
+  void CheckGestureReserve() {
+    printf("Gesture reserve\n");
+    s_received = Received{};
+    host::HostSerial senderSerial;
+    host::HostSerial receiverSerial;
+    senderSerial.Connect(receiverSerial);
+    GSB::BasicGamepadLink<GestureTraits> sender(GSB::LinkConfig{1, GSB::UartConfig{}, senderSerial});
+    GSB::BasicApplicationLink<GestureTraits> receiver(GSB::LinkConfig{1, GSB::UartConfig{}, receiverSerial});
+    receiver.SetButtonOnPress(OnPress);
+    receiver.SetButtonOnRelease(OnRelease);
+    receiver.SetButtonOnGesture(OnGesture);
+    receiver.SetEventQueueEnabled(true);
+    for (uint8_t i = 0; i < s_physicalButtons; ++i) {
+      CHECK(receiver.SubscribeButtonGesturesForAllGamepads(static_cast<GSB::ButtonID>(i), GSB::ButtonGestureMask(GSB::ButtonGesture::DOUBLE_TAP)));
+    }
+
+    constexpr uint8_t frameCount = 8;
+    for (uint8_t frame = 0; frame < frameCount; ++frame) {
+      for (uint8_t i = 0; i < s_physicalButtons; ++i) {
+        sender.SetButton(0, static_cast<GSB::ButtonID>(i), (frame % 2) == 0);
+      }
+      CHECK(sender.SendStatus(0));
+    }
+    // Leave the spare slots occupied each time, so every frame arrives to exactly its reserve
+    constexpr uint8_t spare = GestureTraits::eventQueueDepth - GSB::internal::EventQueue::MaxEventsPerStatus();
+    for (uint8_t i = 0; i < frameCount * 2; ++i) {
+      receiver.Loop();
+      if (receiver.GetPendingEventCount() > spare) {
+        receiver.DispatchEvents(static_cast<uint8_t>(receiver.GetPendingEventCount() - spare));
+      }
+    }
+    receiver.DispatchEvents();
+    CHECK_EQ(s_received.presses, frameCount / 2 * s_physicalButtons);
+    CHECK_EQ(s_received.releases, frameCount / 2 * s_physicalButtons);
+    // Every second press lands within the double-tap window of a short press
+    CHECK_EQ(s_received.doubleTaps + receiver.GetEventOverflowCount(), frameCount / 4 * s_physicalButtons);
+  }
+
+  // A frame that flips every physical button, moves every value and swings both sticks
+  // between opposite diagonals raises the full worst case, virtual edges included. Arriving
+  // with only its reserve free, it still fits: nothing overflows and edges keep their order.
+  void CheckVirtualBackpressure() {
+    printf("Virtual backpressure\n");
+    s_received = Received{};
+    host::HostSerial senderSerial;
+    host::HostSerial receiverSerial;
+    senderSerial.Connect(receiverSerial);
+    GSB::GamepadLink sender(GSB::LinkConfig{1, GSB::UartConfig{}, senderSerial});
+    GSB::ApplicationLink receiver(GSB::LinkConfig{1, GSB::UartConfig{}, receiverSerial});
+    receiver.SetButtonOnPress(OnPress);
+    receiver.SetButtonOnRelease(OnRelease);
+    receiver.SetEventQueueEnabled(true);
+    GSB::AxisButtons axisButtons;
+    CHECK(axisButtons.BindJoystick(GSB::JoystickID::JOYSTICK_1, GSB::StickDirections::EIGHT_WAY,
+      {GSB::ButtonID::VIRTUAL_1, GSB::ButtonID::VIRTUAL_2, GSB::ButtonID::VIRTUAL_3, GSB::ButtonID::VIRTUAL_4}, 200, 40, 8));
+    CHECK(axisButtons.BindJoystick(GSB::JoystickID::JOYSTICK_2, GSB::StickDirections::EIGHT_WAY,
+      {GSB::ButtonID::VIRTUAL_5, GSB::ButtonID::VIRTUAL_6, GSB::ButtonID::VIRTUAL_7, GSB::ButtonID::VIRTUAL_8}, 200, 40, 8));
+    CHECK(receiver.SetAxisButtons(0, &axisButtons));
+
+    constexpr uint8_t frameCount = 8;
+    for (uint8_t frame = 0; frame < frameCount; ++frame) {
+      const bool even = (frame % 2) == 0;
+      const int16_t value = even ? 400 : -400;
+      for (uint8_t i = 0; i < s_physicalButtons; ++i) {
+        sender.SetButton(0, static_cast<GSB::ButtonID>(i), even);
+      }
+      sender.SetJoystick(0, GSB::JoystickID::JOYSTICK_1, value, value);
+      sender.SetJoystick(0, GSB::JoystickID::JOYSTICK_2, value, value);
+      sender.SetTrigger(0, GSB::TriggerID::TRIGGER_1, even ? 900 : 0);
+      sender.SetTrigger(0, GSB::TriggerID::TRIGGER_2, even ? 900 : 0);
+      sender.SetBattery(0, GSB::BatteryID::BATTERY_1, even ? 200 : 100);
+      sender.SetSensor(0, GSB::SensorID::SENSOR_1, value, value, value);
+      sender.SetSensor(0, GSB::SensorID::SENSOR_2, value, value, value);
+      CHECK(sender.SendStatus(0));
+    }
+    constexpr uint8_t spare = GSB::DefaultLinkTraits::eventQueueDepth - GSB::internal::EventQueue::MaxEventsPerStatus();
+    for (uint8_t i = 0; i < frameCount * 2; ++i) {
+      receiver.Loop();
+      if (receiver.GetPendingEventCount() > spare) {
+        receiver.DispatchEvents(static_cast<uint8_t>(receiver.GetPendingEventCount() - spare));
+      }
+    }
+    receiver.DispatchEvents();
+    CHECK_EQ(receiver.GetEventOverflowCount(), 0);
+    // From center the first frame presses two directions per stick; every later swing
+    // releases two and presses two
+    constexpr uint8_t virtualEdges = 2 * 2 + (frameCount - 1) * 2 * 4;
+    CHECK_EQ(s_received.presses + s_received.releases, frameCount * s_physicalButtons + virtualEdges);
+  }
+} // namespace
+
+int main() {
+  CheckRoundTrip<GSB::DefaultLinkTraits>("Default traits");
+  // One gamepad, single-frame buffers, no event queue and no RX ring
+  CheckRoundTrip<GSB::LinkTraits<1, 64, 1, 1, 0, 0>>("LinkTraits<1, 64, 1, 1, 0, 0>");
+  CheckBackpressure();
+  CheckGestureReserve();
+  CheckVirtualBackpressure();
+  return host::CheckResult("LinkLoopback");
+}
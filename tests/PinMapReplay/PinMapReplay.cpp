@@ -0,0 +1,270 @@
+// Host check for PinMap: a short sequence of status frames replayed through a table into
+// a recording PinWriter, the axis scaling and table validation, and a map attached to an
+// ApplicationLink driving pins through ArduinoPinWriter as frames arrive.
+
+#include <Arduino.h>
+#include <Check.h>
+#include <GamepadSerialBridge.h>
+
+namespace {
+  enum class WriteKind : uint8_t {
+    SETUP,
+    DIGITAL,
+    PWM,
+    SERVO
+  };
+
+  struct PinWrite {
+    WriteKind kind;
+    uint8_t pin;
+    uint16_t value;
+  };
+
+  class RecordingPinWriter : public GSB::PinWriter {
+    public:
+      void SetupPin(uint8_t pin, GSB::PinAction) override {
+        Record(WriteKind::SETUP, pin, 0);
+      }
+
+      void WriteDigital(uint8_t pin, bool high) override {
+        Record(WriteKind::DIGITAL, pin, high ? 1 : 0);
+      }
+
+      void WritePwm(uint8_t pin, uint8_t duty) override {
+        Record(WriteKind::PWM, pin, duty);
+      }
+
+      void WriteServo(uint8_t pin, uint16_t pulseMicros) override {
+        Record(WriteKind::SERVO, pin, pulseMicros);
+      }
+
+      // Checks that exactly the expected writes happened since the last call, in order
+      void Expect(const PinWrite* expected, uint8_t count, int line) {
+        if (m_count != count) {
+          printf("line %d: %u writes, expected %u\n", line, m_count, count);
+        }
+        CHECK_EQ(m_count, count);
+        for (uint8_t i = 0; i < m_count && i < count; ++i) {
+          if (m_writes[i].kind != expected[i].kind || m_writes[i].pin != expected[i].pin || m_writes[i].value != expected[i].value) {
+            printf("line %d: write %u is %u/%u/%u, expected %u/%u/%u\n", line, i,
+              static_cast<unsigned>(m_writes[i].kind), m_writes[i].pin, m_writes[i].value,
+              static_cast<unsigned>(expected[i].kind), expected[i].pin, expected[i].value);
+            ++host::FailureCount();
+          }
+        }
+        m_count = 0;
+      }
+
+    private:
+      void Record(WriteKind kind, uint8_t pin, uint16_t value) {
+        if (m_count < s_capacity) {
+          m_writes[m_count] = PinWrite{kind, pin, value};
+        }
+        ++m_count;
+      }
+
+      static constexpr uint8_t s_capacity = 16;
+      PinWrite m_writes[s_capacity]{};
+      uint8_t m_count{0};
+  };
+
+#define EXPECT_WRITES(writer, ...)                                             \
+  do {                                                                         \
+    const PinWrite expected[] = {__VA_ARGS__};                                 \
+    (writer).Expect(expected, sizeof(expected) / sizeof(expected[0]), __LINE__); \
+  } while (0)
+#define EXPECT_NO_WRITES(writer) (writer).Expect(nullptr, 0, __LINE__)
+
+  const GSB::PinMapping s_pins[] = {
+    GSB::PinMapping::Button(GSB::Xbox::Buttons::A, 22),
+    GSB::PinMapping::Button(GSB::Xbox::Buttons::B, 23, GSB::PinAction::TOGGLE, true),
+    GSB::PinMapping::Pulse(GSB::Xbox::Buttons::X, 24, 250),
+    GSB::PinMapping::Pwm(GSB::Xbox::Triggers::RT, 5),
+    GSB::PinMapping::Servo(GSB::Xbox::Joysticks::LS, 0, 9),
+  };
+  constexpr uint8_t s_pinCount = sizeof(s_pins) / sizeof(s_pins[0]);
+
+  void Apply(GSB::PinMap& pinMap, GSB::internal::Status& status, const GSB::internal::Status& next, unsigned long nowMillis) {
+    pinMap.Update(next, GSB::internal::Status::ChangedGroups(status, next), nowMillis);
+    pinMap.Expire(nowMillis);
+    status = next;
+  }
+
+  void CheckReplay() {
+    printf("Replay\n");
+    RecordingPinWriter writer;
+    GSB::BasicPinMap<8> pinMap;
+    GSB::internal::Status status{};
+    CHECK(pinMap.SetMappings(s_pins, s_pinCount, writer));
+    CHECK_EQ(pinMap.GetCount(), s_pinCount);
+
+    // Every pin is set up, then driven from the idle status; B is active-low, so idle is HIGH
+    pinMap.Begin(status, 0);
+    EXPECT_WRITES(writer,
+      {WriteKind::SETUP, 22, 0}, {WriteKind::DIGITAL, 22, 0},
+      {WriteKind::SETUP, 23, 0}, {WriteKind::DIGITAL, 23, 1},
+      {WriteKind::SETUP, 24, 0}, {WriteKind::DIGITAL, 24, 0},
+      {WriteKind::SETUP, 5, 0}, {WriteKind::PWM, 5, 0},
+      {WriteKind::SETUP, 9, 0}, {WriteKind::SERVO, 9, 1500});
+
+    GSB::internal::Status next = status;
+    next.Update(GSB::Xbox::Buttons::A, true);
+    next.Update(GSB::Xbox::Buttons::B, true);
+    next.Update(GSB::Xbox::Buttons::X, true);
+    Apply(pinMap, status, next, 10);
+    EXPECT_WRITES(writer, {WriteKind::DIGITAL, 22, 1}, {WriteKind::DIGITAL, 23, 0}, {WriteKind::DIGITAL, 24, 1});
+
+    // Releasing B leaves its toggle on; X is still held, and its pulse runs on regardless
+    next.Update(GSB::Xbox::Buttons::A, false);
+    next.Update(GSB::Xbox::Buttons::B, false);
+    Apply(pinMap, status, next, 20);
+    EXPECT_WRITES(writer, {WriteKind::DIGITAL, 22, 0});
+
+    next.Update(GSB::Xbox::Joysticks::LS, -512, 0);
+    next.Update(GSB::Xbox::Triggers::RT, 1023);
+    Apply(pinMap, status, next, 100);
+    EXPECT_WRITES(writer, {WriteKind::PWM, 5, 255}, {WriteKind::SERVO, 9, 1000});
+
+    // Only the Y axis moves, so the X-axis servo is not written
+    next.Update(GSB::Xbox::Joysticks::LS, -512, 40);
+    Apply(pinMap, status, next, 150);
+    EXPECT_NO_WRITES(writer);
+
+    // An unchanged frame only ends pulses that have run their length
+    Apply(pinMap, status, next, 259);
+    EXPECT_NO_WRITES(writer);
+    Apply(pinMap, status, next, 260);
+    EXPECT_WRITES(writer, {WriteKind::DIGITAL, 24, 0});
+
+    // A second press of B toggles it back off; X must be released before it pulses again
+    next.Update(GSB::Xbox::Buttons::B, true);
+    Apply(pinMap, status, next, 300);
+    EXPECT_WRITES(writer, {WriteKind::DIGITAL, 23, 1});
+    next.Update(GSB::Xbox::Buttons::X, false);
+    Apply(pinMap, status, next, 310);
+    EXPECT_NO_WRITES(writer);
+    next.Update(GSB::Xbox::Buttons::X, true);
+    Apply(pinMap, status, next, 320);
+    EXPECT_WRITES(writer, {WriteKind::DIGITAL, 24, 1});
+  }
+
+  void CheckHeldAtBegin() {
+    printf("Held at Begin\n");
+    RecordingPinWriter writer;
+    GSB::BasicPinMap<8> pinMap;
+    GSB::internal::Status status{};
+    status.Update(GSB::Xbox::Buttons::A, true);
+    status.Update(GSB::Xbox::Buttons::B, true);
+    status.Update(GSB::Xbox::Buttons::X, true);
+    CHECK(pinMap.SetMappings(s_pins, 3, writer));
+    // A held button drives SET pins, but is not a press for TOGGLE or MOMENTARY ones
+    pinMap.Begin(status, 0);
+    EXPECT_WRITES(writer,
+      {WriteKind::SETUP, 22, 0}, {WriteKind::DIGITAL, 22, 1},
+      {WriteKind::SETUP, 23, 0}, {WriteKind::DIGITAL, 23, 1},
+      {WriteKind::SETUP, 24, 0}, {WriteKind::DIGITAL, 24, 0});
+  }
+
+  void CheckScale() {
+    printf("Scale\n");
+    const GSB::PinMapping pwm = GSB::PinMapping::Pwm(GSB::TriggerID::TRIGGER_1, 5);
+    CHECK_EQ(GSB::PinMap::Scale(pwm, 0), 0);
+    CHECK_EQ(GSB::PinMap::Scale(pwm, 512), 128);
+    CHECK_EQ(GSB::PinMap::Scale(pwm, 1023), 255);
+    // Out of range values clamp
+    CHECK_EQ(GSB::PinMap::Scale(pwm, -40), 0);
+    CHECK_EQ(GSB::PinMap::Scale(pwm, 2000), 255);
+
+    // A backwards input range inverts
+    const GSB::PinMapping inverted = GSB::PinMapping::Servo(GSB::JoystickID::JOYSTICK_1, 1, 9, 512, -512);
+    CHECK_EQ(GSB::PinMap::Scale(inverted, 512), 1000);
+    CHECK_EQ(GSB::PinMap::Scale(inverted, -512), 2000);
+    CHECK_EQ(GSB::PinMap::Scale(inverted, 0), 1500);
+
+    // So does a backwards output range
+    const GSB::PinMapping falling = GSB::PinMapping::Pwm(GSB::TriggerID::TRIGGER_2, 6, 0, 1023, 255, 0);
+    CHECK_EQ(GSB::PinMap::Scale(falling, 0), 255);
+    CHECK_EQ(GSB::PinMap::Scale(falling, 1023), 0);
+  }
+
+  void CheckValidation() {
+    printf("Validation\n");
+    RecordingPinWriter writer;
+    GSB::BasicPinMap<4> pinMap;
+    // More entries than the map holds
+    CHECK(!pinMap.SetMappings(s_pins, s_pinCount, writer));
+    CHECK_EQ(pinMap.GetCount(), 0);
+
+    const GSB::PinMapping virtualButton[] = {GSB::PinMapping::Button(GSB::ButtonID::VIRTUAL_1, 2)};
+    CHECK(!pinMap.SetMappings(virtualButton, 1, writer));
+    const GSB::PinMapping wideDuty[] = {GSB::PinMapping::Pwm(GSB::TriggerID::TRIGGER_1, 5, 0, 1023, 0, 255), GSB::PinMapping::Analog(GSB::PinAction::PWM, GSB::InputGroup::TRIGGERS, 0, 0, 5, 0, 1023, 0, 256)};
+    CHECK(!pinMap.SetMappings(wideDuty, 2, writer));
+    const GSB::PinMapping emptyRange[] = {GSB::PinMapping::Servo(GSB::TriggerID::TRIGGER_1, 9, 100, 100)};
+    CHECK(!pinMap.SetMappings(emptyRange, 1, writer));
+    const GSB::PinMapping badAxis[] = {GSB::PinMapping::Pwm(GSB::JoystickID::JOYSTICK_1, 2, 5)};
+    CHECK(!pinMap.SetMappings(badAxis, 1, writer));
+    CHECK(pinMap.SetMappings(s_pins, 4, writer));
+    CHECK_EQ(pinMap.GetCount(), 4);
+    EXPECT_NO_WRITES(writer);
+  }
+
+  void CheckLink() {
+    printf("Link\n");
+    host::HostSerial senderSerial;
+    host::HostSerial receiverSerial;
+    senderSerial.Connect(receiverSerial);
+    GSB::GamepadLink sender(GSB::LinkConfig{1, GSB::UartConfig{}, senderSerial});
+    GSB::ApplicationLink receiver(GSB::LinkConfig{1, GSB::UartConfig{}, receiverSerial});
+    GSB::ArduinoPinWriter writer;
+    GSB::BasicPinMap<8> pinMap;
+    CHECK(pinMap.SetMappings(s_pins, s_pinCount, writer));
+    host::SetMicros(1000);
+    CHECK(receiver.SetPinMap(0, &pinMap));
+    CHECK_EQ(host::GetPinValue(22), LOW);
+    CHECK_EQ(host::GetPinValue(23), HIGH);
+    CHECK_EQ(host::GetPinValue(5), 0);
+    // ArduinoPinWriter leaves servo pins alone
+    CHECK_EQ(host::GetPinValue(9), -1);
+
+    sender.SetButton(0, GSB::Xbox::Buttons::A, true);
+    sender.SetButton(0, GSB::Xbox::Buttons::X, true);
+    sender.SetTrigger(0, GSB::Xbox::Triggers::RT, 1023);
+    CHECK(sender.SendStatus(0));
+    receiver.Loop();
+    CHECK_EQ(host::GetPinValue(22), HIGH);
+    CHECK_EQ(host::GetPinValue(24), HIGH);
+    CHECK_EQ(host::GetPinValue(5), 255);
+
+    // The link's loop ends the pulse once it has run, with no frame arriving
+    host::AdvanceMicros(249000);
+    receiver.Loop();
+    CHECK_EQ(host::GetPinValue(24), HIGH);
+    host::AdvanceMicros(1000);
+    receiver.Loop();
+    CHECK_EQ(host::GetPinValue(24), LOW);
+
+    sender.SetButton(0, GSB::Xbox::Buttons::A, false);
+    sender.SetTrigger(0, GSB::Xbox::Triggers::RT, 0);
+    CHECK(sender.SendStatus(0));
+    receiver.Loop();
+    CHECK_EQ(host::GetPinValue(22), LOW);
+    CHECK_EQ(host::GetPinValue(5), 0);
+
+    // Detached, frames no longer reach the pins
+    CHECK(receiver.SetPinMap(0, nullptr));
+    sender.SetButton(0, GSB::Xbox::Buttons::A, true);
+    CHECK(sender.SendStatus(0));
+    receiver.Loop();
+    CHECK_EQ(host::GetPinValue(22), LOW);
+    CHECK(!receiver.SetPinMap(1, &pinMap));
+  }
+} // namespace
+
+int main() {
+  CheckReplay();
+  CheckHeldAtBegin();
+  CheckScale();
+  CheckValidation();
+  CheckLink();
+  return host::CheckResult("PinMapReplay");
+}
@@ -0,0 +1,364 @@
+// Host check for the rule VM: compiled programs run against status frames into a recording
+// PinWriter, compile errors, bytecode validation and run-time faults, and a program uploaded
+// over a loopback link in pieces and run after each applied frame.
+
+#include <Arduino.h>
+#include <Check.h>
+#include <GamepadSerialBridge.h>
+
+namespace {
+  // Last value written to each pin, by kind
+  class RecordingPinWriter : public GSB::PinWriter {
+    public:
+      static constexpr uint8_t s_pins = 32;
+
+      RecordingPinWriter() {
+        for (uint8_t i = 0; i < s_pins; ++i) {
+          setup[i] = -1;
+          digital[i] = -1;
+          pwm[i] = -1;
+          servo[i] = -1;
+        }
+      }
+
+      void SetupPin(uint8_t pin, GSB::PinAction action) override {
+        if (pin < s_pins) {
+          setup[pin] = static_cast<int>(action);
+        }
+      }
+
+      void WriteDigital(uint8_t pin, bool high) override {
+        if (pin < s_pins) {
+          digital[pin] = high ? 1 : 0;
+        }
+        ++writes;
+      }
+
+      void WritePwm(uint8_t pin, uint8_t duty) override {
+        if (pin < s_pins) {
+          pwm[pin] = duty;
+        }
+        ++writes;
+      }
+
+      void WriteServo(uint8_t pin, uint16_t pulseMicros) override {
+        if (pin < s_pins) {
+          servo[pin] = pulseMicros;
+        }
+        ++writes;
+      }
+
+      int setup[s_pins];
+      int digital[s_pins];
+      int pwm[s_pins];
+      int servo[s_pins];
+      uint16_t writes{0};
+  };
+
+  const char s_rules[] =
+    "# Ramp PWM 5 up while TRIGGER_1 is past 600 and MAIN_1 is held, down otherwise\n"
+    "if TRIGGER_1 > 600 and MAIN_1\n"
+    "  r0 = min(r0 + elapsed, 255)\n"
+    "else\n"
+    "  r0 = max(r0 - elapsed * 2, 0)\n"
+    "end\n"
+    "pwm 5 = r0\n"
+    "pin 13 = MAIN_2 or MAIN_3\n"
+    "servo 9 = 1500 + JOYSTICK_1.x\n";
+
+  uint8_t Compile(const char* source, uint8_t* code, uint8_t capacity) {
+    GSB::RuleCompiler compiler;
+    const uint8_t length = compiler.Compile(source, code, capacity);
+    if (compiler.GetError() != GSB::RuleCompileError::NONE) {
+      printf("  compile error %u on line %u\n", static_cast<unsigned>(compiler.GetError()), compiler.GetLine());
+    }
+    return length;
+  }
+
+  void CheckRamp() {
+    printf("Ramp\n");
+    uint8_t code[128];
+    const uint8_t length = Compile(s_rules, code, sizeof(code));
+    CHECK(length > 0);
+    RecordingPinWriter writer;
+    GSB::BasicRuleVm<128> ruleVm(writer);
+    CHECK(ruleVm.Load(code, length));
+    CHECK(ruleVm.IsLoaded());
+    CHECK_EQ(ruleVm.GetLength(), length);
+    CHECK(ruleVm.GetMaxSteps() > 0);
+    // Load sets up every pin the program writes
+    CHECK_EQ(writer.setup[5], static_cast<int>(GSB::PinAction::PWM));
+    CHECK_EQ(writer.setup[13], static_cast<int>(GSB::PinAction::SET));
+    CHECK_EQ(writer.setup[9], static_cast<int>(GSB::PinAction::SERVO));
+    CHECK_EQ(writer.writes, 0);
+
+    GSB::internal::Status status{};
+    status.Update(GSB::TriggerID::TRIGGER_1, 700);
+    status.Update(GSB::ButtonID::MAIN_1, true);
+    status.Update(GSB::JoystickID::JOYSTICK_1, -200, 100);
+    // The first run has no previous one, so nothing has elapsed
+    CHECK(ruleVm.Run(status, 1000));
+    CHECK_EQ(ruleVm.GetRegister(0), 0);
+    CHECK_EQ(writer.pwm[5], 0);
+    CHECK_EQ(writer.digital[13], 0);
+    CHECK_EQ(writer.servo[9], 1300);
+    CHECK(ruleVm.Run(status, 1100));
+    CHECK_EQ(writer.pwm[5], 100);
+    CHECK(ruleVm.Run(status, 1300));
+    CHECK_EQ(ruleVm.GetRegister(0), 255);
+    CHECK_EQ(writer.pwm[5], 255);
+
+    // Either condition failing ramps down at twice the rate, stopping at zero
+    status.Update(GSB::TriggerID::TRIGGER_1, 600);
+    status.Update(GSB::ButtonID::MAIN_3, true);
+    CHECK(ruleVm.Run(status, 1310));
+    CHECK_EQ(writer.pwm[5], 235);
+    CHECK_EQ(writer.digital[13], 1);
+    status.Update(GSB::TriggerID::TRIGGER_1, 601);
+    status.Update(GSB::ButtonID::MAIN_1, false);
+    CHECK(ruleVm.Run(status, 1400));
+    CHECK_EQ(writer.pwm[5], 55);
+    CHECK(ruleVm.Run(status, 1500));
+    CHECK_EQ(ruleVm.GetRegister(0), 0);
+    CHECK_EQ(writer.pwm[5], 0);
+    CHECK_EQ(ruleVm.GetFaultCount(), 0);
+
+    // Reloading clears the registers
+    ruleVm.SetRegister(0, 77);
+    CHECK(ruleVm.Load(code, length));
+    CHECK_EQ(ruleVm.GetRegister(0), 0);
+  }
+
+  void CheckExpressions() {
+    printf("Expressions\n");
+    const char source[] =
+      "r1 = 2 + 3 * 4\n"
+      "r2 = (2 + 3) * 4\n"
+      "r3 = 1000 >> 2 + 1\n"
+      "r4 = -5 - 7\n"
+      "R5 = 30000 + 30000   # saturates\n"
+      "r6 = not main_1 and (TRIGGER_2 >= 10 or SENSOR_1.z < 0)\n"
+      "r7 = min(max(r7 + 1, 3), 4)\n";
+    uint8_t code[128];
+    const uint8_t length = Compile(source, code, sizeof(code));
+    CHECK(length > 0);
+    RecordingPinWriter writer;
+    GSB::BasicRuleVm<128> ruleVm(writer);
+    CHECK(ruleVm.Load(code, length));
+    GSB::internal::Status status{};
+    status.Update(GSB::SensorID::SENSOR_1, 0, 0, -1);
+    CHECK(ruleVm.Run(status, 0));
+    CHECK_EQ(ruleVm.GetRegister(1), 14);
+    CHECK_EQ(ruleVm.GetRegister(2), 20);
+    CHECK_EQ(ruleVm.GetRegister(3), 251);
+    CHECK_EQ(ruleVm.GetRegister(4), -12);
+    CHECK_EQ(ruleVm.GetRegister(5), 32767);
+    CHECK_EQ(ruleVm.GetRegister(6), 1);
+    CHECK_EQ(ruleVm.GetRegister(7), 3);
+    // Registers persist across runs
+    CHECK(ruleVm.Run(status, 0));
+    CHECK_EQ(ruleVm.GetRegister(7), 4);
+    status.Update(GSB::ButtonID::MAIN_1, true);
+    CHECK(ruleVm.Run(status, 0));
+    CHECK_EQ(ruleVm.GetRegister(6), 0);
+    CHECK_EQ(ruleVm.GetRegister(7), 4);
+    CHECK_EQ(writer.writes, 0);
+  }
+
+  void CheckCompileErrors() {
+    printf("Compile errors\n");
+    struct Case {
+      const char* source;
+      GSB::RuleCompileError error;
+      uint16_t line;
+    };
+    const Case cases[] = {
+      {"r0 = 1 +\n", GSB::RuleCompileError::SYNTAX, 1},
+      {"r0 = 1\nr0 = FOO\n", GSB::RuleCompileError::UNKNOWN_NAME, 2},
+      {"r8 = 1\n", GSB::RuleCompileError::UNKNOWN_NAME, 1},
+      {"r0 = MAIN_99\n", GSB::RuleCompileError::UNKNOWN_NAME, 1},
+      {"r0 = 40000\n", GSB::RuleCompileError::NUMBER_RANGE, 1},
+      {"end\n", GSB::RuleCompileError::NESTING, 1},
+      {"if MAIN_1\nelse\nelse\nend\n", GSB::RuleCompileError::NESTING, 3},
+      // An unclosed block is reported at the end of the source
+      {"if MAIN_1\nr0 = 1\n", GSB::RuleCompileError::NESTING, 3},
+      {"if 1\nif 1\nif 1\nif 1\nif 1\nend\nend\nend\nend\nend\n", GSB::RuleCompileError::NESTING, 5},
+    };
+    for (const Case& c : cases) {
+      uint8_t code[64];
+      GSB::RuleCompiler compiler;
+      CHECK_EQ(compiler.Compile(c.source, code, sizeof(code)), 0);
+      if (compiler.GetError() != c.error || compiler.GetLine() != c.line) {
+        printf("  \"%s\": error %u on line %u\n", c.source, static_cast<unsigned>(compiler.GetError()), compiler.GetLine());
+      }
+      CHECK(compiler.GetError() == c.error);
+      CHECK_EQ(compiler.GetLine(), c.line);
+    }
+
+    // A program that does not fit the output buffer
+    uint8_t code[8];
+    GSB::RuleCompiler compiler;
+    CHECK_EQ(compiler.Compile("pwm 5 = TRIGGER_1\npwm 6 = TRIGGER_2\n", code, sizeof(code)), 0);
+    CHECK(compiler.GetError() == GSB::RuleCompileError::PROGRAM_TOO_LONG);
+
+    // Comments and blank lines compile to nothing
+    CHECK_EQ(compiler.Compile("# nothing\n\n   \n", code, sizeof(code)), 0);
+    CHECK(compiler.GetError() == GSB::RuleCompileError::NONE);
+  }
+
+  uint8_t Op(GSB::RuleOp op) {
+    return static_cast<uint8_t>(op);
+  }
+
+  void CheckValidation() {
+    printf("Validation\n");
+    uint8_t steps = 0;
+    const uint8_t straight[] = {Op(GSB::RuleOp::PUSH8), 3, Op(GSB::RuleOp::PUSH16), 0x10, 0x27, Op(GSB::RuleOp::ADD), Op(GSB::RuleOp::STORE), 0};
+    CHECK(GSB::RuleVm::Validate(straight, sizeof(straight), steps));
+    CHECK_EQ(steps, 4);
+    // A jump may land on the end of the program, but not inside an instruction or past the end
+    const uint8_t toEnd[] = {Op(GSB::RuleOp::JMP), 2, Op(GSB::RuleOp::PUSH8), 1};
+    CHECK(GSB::RuleVm::Validate(toEnd, sizeof(toEnd), steps));
+    const uint8_t intoOperand[] = {Op(GSB::RuleOp::JMP), 1, Op(GSB::RuleOp::PUSH8), 1};
+    CHECK(!GSB::RuleVm::Validate(intoOperand, sizeof(intoOperand), steps));
+    const uint8_t pastEnd[] = {Op(GSB::RuleOp::JMP), 3, Op(GSB::RuleOp::PUSH8), 1};
+    CHECK(!GSB::RuleVm::Validate(pastEnd, sizeof(pastEnd), steps));
+    const uint8_t truncated[] = {Op(GSB::RuleOp::PUSH16), 1};
+    CHECK(!GSB::RuleVm::Validate(truncated, sizeof(truncated), steps));
+    const uint8_t badOpcode[] = {Op(GSB::RuleOp::COUNT)};
+    CHECK(!GSB::RuleVm::Validate(badOpcode, sizeof(badOpcode), steps));
+    const uint8_t virtualButton[] = {Op(GSB::RuleOp::BUTTON), static_cast<uint8_t>(GSB::ButtonID::VIRTUAL_1)};
+    CHECK(!GSB::RuleVm::Validate(virtualButton, sizeof(virtualButton), steps));
+    const uint8_t badValue[] = {Op(GSB::RuleOp::VALUE), static_cast<uint8_t>(GSB::InputGroup::SENSORS), 0, 3};
+    CHECK(!GSB::RuleVm::Validate(badValue, sizeof(badValue), steps));
+    const uint8_t badRegister[] = {Op(GSB::RuleOp::LOAD), GSB::RuleVm::s_registerCount};
+    CHECK(!GSB::RuleVm::Validate(badRegister, sizeof(badRegister), steps));
+
+    RecordingPinWriter writer;
+    GSB::BasicRuleVm<8> ruleVm(writer);
+    CHECK(!ruleVm.Load(intoOperand, sizeof(intoOperand)));
+    CHECK(!ruleVm.IsLoaded());
+    const uint8_t tooLong[9]{};
+    CHECK(!ruleVm.Load(tooLong, sizeof(tooLong)));
+    CHECK(!ruleVm.Run(GSB::internal::Status{}, 0));
+  }
+
+  void CheckFaults() {
+    printf("Faults\n");
+    RecordingPinWriter writer;
+    GSB::BasicRuleVm<64> ruleVm(writer);
+    const GSB::internal::Status status{};
+    // Validation does not track stack depth; the run stops at the first bad instruction
+    const uint8_t underflow[] = {Op(GSB::RuleOp::PUSH8), 1, Op(GSB::RuleOp::STORE), 0, Op(GSB::RuleOp::ADD), Op(GSB::RuleOp::PWM), 5};
+    CHECK(ruleVm.Load(underflow, sizeof(underflow)));
+    CHECK(!ruleVm.Run(status, 0));
+    CHECK_EQ(ruleVm.GetFaultCount(), 1);
+    CHECK_EQ(ruleVm.GetRegister(0), 1);
+    CHECK_EQ(writer.pwm[5], -1);
+
+    uint8_t overflow[2 * (GSB::RuleVm::s_stackDepth + 1)];
+    for (uint8_t i = 0; i < sizeof(overflow); i += 2) {
+      overflow[i] = Op(GSB::RuleOp::PUSH8);
+      overflow[i + 1] = i;
+    }
+    CHECK(ruleVm.Load(overflow, sizeof(overflow)));
+    CHECK(!ruleVm.Run(status, 0));
+    CHECK_EQ(ruleVm.GetFaultCount(), 2);
+    // One push fewer fits
+    CHECK(ruleVm.Load(overflow, sizeof(overflow) - 2));
+    CHECK(ruleVm.Run(status, 0));
+    CHECK_EQ(ruleVm.GetFaultCount(), 2);
+  }
+
+  void CheckChunks() {
+    printf("Chunks\n");
+    uint8_t code[128];
+    const uint8_t length = Compile(s_rules, code, sizeof(code));
+    RecordingPinWriter writer;
+    GSB::BasicRuleVm<128> ruleVm(writer);
+    const uint8_t half = length / 2;
+    CHECK(ruleVm.LoadChunk(0, length, code, half));
+    CHECK(!ruleVm.IsLoaded());
+    CHECK(ruleVm.LoadChunk(half, length, &code[half], static_cast<uint8_t>(length - half)));
+    CHECK(ruleVm.IsLoaded());
+    CHECK_EQ(ruleVm.GetLength(), length);
+
+    // A gap drops the partial program
+    CHECK(ruleVm.LoadChunk(0, length, code, 4));
+    CHECK(!ruleVm.IsLoaded());
+    CHECK(!ruleVm.LoadChunk(8, length, &code[8], 4));
+    CHECK(!ruleVm.LoadChunk(4, length, &code[4], static_cast<uint8_t>(length - 4)));
+    CHECK(!ruleVm.IsLoaded());
+    // As does a piece running past the announced total
+    CHECK(ruleVm.LoadChunk(0, 4, code, 2));
+    CHECK(!ruleVm.LoadChunk(2, 4, &code[2], 3));
+    // Total 0 unloads
+    CHECK(ruleVm.Load(code, length));
+    CHECK(ruleVm.LoadChunk(0, 0, nullptr, 0));
+    CHECK(!ruleVm.IsLoaded());
+  }
+
+  void CheckLink() {
+    printf("Link\n");
+    host::HostSerial senderSerial;
+    host::HostSerial receiverSerial;
+    senderSerial.Connect(receiverSerial);
+    GSB::GamepadLink sender(GSB::LinkConfig{1, GSB::UartConfig{}, senderSerial});
+    GSB::ApplicationLink receiver(GSB::LinkConfig{1, GSB::UartConfig{}, receiverSerial});
+    GSB::ArduinoPinWriter writer;
+    GSB::BasicRuleVm<128> ruleVm(writer);
+    CHECK(receiver.SetRuleVm(0, &ruleVm));
+    CHECK(!receiver.SetRuleVm(1, &ruleVm));
+
+    // One output per main button: longer than a single message, so it goes in pieces
+    char source[512] = "";
+    for (uint8_t i = 1; i <= GSB::MainButtons::Count(); ++i) {
+      char line[32];
+      snprintf(line, sizeof(line), "pin %u = MAIN_%u\n", 20 + i, i);
+      strcat(source, line);
+    }
+    strcat(source, "pwm 5 = TRIGGER_1 >> 2\n");
+    uint8_t code[128];
+    const uint8_t length = Compile(source, code, sizeof(code));
+    CHECK(length > GSB::LinkTraits<>::maxPayload);
+    host::SetMicros(1000);
+    CHECK(sender.SendRules(0, code, length));
+    receiver.Loop();
+    CHECK(ruleVm.IsLoaded());
+    CHECK_EQ(ruleVm.GetLength(), length);
+
+    // The program runs after each applied frame
+    sender.SetButton(0, GSB::ButtonID::MAIN_3, true);
+    sender.SetTrigger(0, GSB::TriggerID::TRIGGER_1, 1000);
+    CHECK(sender.SendStatus(0));
+    receiver.Loop();
+    CHECK_EQ(host::GetPinValue(23), HIGH);
+    CHECK_EQ(host::GetPinValue(22), LOW);
+    CHECK_EQ(host::GetPinValue(5), 250);
+    sender.SetButton(0, GSB::ButtonID::MAIN_3, false);
+    CHECK(sender.SendStatus(0));
+    receiver.Loop();
+    CHECK_EQ(host::GetPinValue(23), LOW);
+    CHECK_EQ(ruleVm.GetFaultCount(), 0);
+
+    // An empty upload unloads the program
+    CHECK(sender.SendRules(0, nullptr, 0));
+    receiver.Loop();
+    CHECK(!ruleVm.IsLoaded());
+    sender.SetButton(0, GSB::ButtonID::MAIN_3, true);
+    CHECK(sender.SendStatus(0));
+    receiver.Loop();
+    CHECK_EQ(host::GetPinValue(23), LOW);
+  }
+} // namespace
+
+int main() {
+  CheckRamp();
+  CheckExpressions();
+  CheckCompileErrors();
+  CheckValidation();
+  CheckFaults();
+  CheckChunks();
+  CheckLink();
+  return host::CheckResult("RuleVm");
+}
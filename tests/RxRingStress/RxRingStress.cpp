@@ -0,0 +1,79 @@
+// Host stress test for internal::RxRing: a std::thread producer stands in for the UART
+// receive ISR while the main thread consumes, as Loop does. Both sides walk the same
+// xorshift sequence, so any lost, duplicated or reordered byte is caught, and ring sizes
+// from 2 to 256 wrap their indices many times over. Run with `make -C tests RxRingStress`.
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include "internal/RxRing.h"
+
+namespace {
+  constexpr unsigned long s_byteCount = 200000;
+
+  // Sleeping rather than yielding makes the other side run even on a single-core host
+  void Wait() {
+    std::this_thread::sleep_for(std::chrono::microseconds(1));
+  }
+
+  uint8_t NextByte(uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return static_cast<uint8_t>(state);
+  }
+
+  template<uint16_t Capacity>
+  bool Run() {
+    static GSB::internal::RxRing<Capacity> ring;
+    unsigned long rejected = 0;
+
+    // Producer: retries a byte until the ring takes it, counting every rejected push
+    std::thread producer([&rejected]() {
+      uint32_t state = 0x12345678;
+      for (unsigned long i = 0; i < s_byteCount; ++i) {
+        const uint8_t byte = NextByte(state);
+        while (!ring.Push(byte)) {
+          ++rejected;
+          Wait();
+        }
+      }
+    });
+
+    uint32_t state = 0x12345678;
+    unsigned long received = 0;
+    bool ordered = true;
+    while (received < s_byteCount) {
+      uint8_t byte = 0;
+      if (!ring.Pop(byte)) {
+        Wait();
+        continue;
+      }
+      if (ordered && byte != NextByte(state)) {
+        std::printf("RxRing<%u>: byte %lu out of sequence\n", Capacity, received);
+        ordered = false;
+      }
+      ++received;
+    }
+    producer.join();
+
+    uint8_t extra = 0;
+    const bool drained = !ring.Pop(extra) && ring.Available() == 0;
+    // The overflow counter is 16 bits and wraps
+    const bool counted = ring.GetOverflowCount() == static_cast<uint16_t>(rejected);
+    if (!drained) {
+      std::printf("RxRing<%u>: bytes left over after the last one\n", Capacity);
+    }
+    if (!counted) {
+      std::printf("RxRing<%u>: overflow count %u, expected %lu\n", Capacity, ring.GetOverflowCount(), rejected);
+    }
+    std::printf("RxRing<%u>: %lu bytes, %lu full pushes\n", Capacity, received, rejected);
+    return ordered && drained && counted;
+  }
+} // namespace
+
+int main() {
+  const bool passed = Run<2>() && Run<16>() && Run<64>() && Run<256>();
+  std::printf(passed ? "PASS\n" : "FAIL\n");
+  return passed ? 0 : 1;
+}
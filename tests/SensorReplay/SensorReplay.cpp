@@ -0,0 +1,192 @@
+// Host check for the sensor path into ImuFusion. A recorded gyro/accelerometer trace is
+// sent frame by frame from a GamepadLink to an ApplicationLink with a fusion stage attached;
+// every frame moves all three axes of both sensors at once. The link's orientation must
+// match a second ImuFusion fed the same samples directly. The same trace then goes out as
+// batched samples, whose callbacks wait in the event queue until dispatched.
+
+#include <Arduino.h>
+#include <Check.h>
+#include <GamepadSerialBridge.h>
+
+namespace {
+  // Gyro rates swing on all three axes while the pad tilts; accelerometer near 1 g (8192)
+  const int16_t s_trace[][6] = {
+    {40, -25, 12, 120, -80, 8150},
+    {900, -640, 310, 300, -220, 8100},
+    {1800, -1300, 650, 620, -410, 8010},
+    {2400, -1750, 900, 960, -640, 7900},
+    {2100, -1500, 1200, 1250, -830, 7750},
+    {1500, -900, 1500, 1500, -1020, 7620},
+    {700, -300, 1100, 1660, -1150, 7530},
+    {-200, 350, 600, 1600, -1100, 7560},
+    {-900, 1000, 100, 1400, -960, 7680},
+    {-1600, 1500, -450, 1120, -760, 7830},
+    {-2200, 1900, -900, 800, -520, 7970},
+    {-1700, 1400, -1300, 510, -330, 8060},
+    {-1000, 800, -900, 260, -170, 8130},
+    {-400, 300, -420, 90, -60, 8170},
+    {-60, 45, -80, 20, -15, 8190},
+    {15, -10, 20, 5, -5, 8192},
+  };
+  constexpr uint8_t s_frameCount = sizeof(s_trace) / sizeof(s_trace[0]);
+  constexpr unsigned long s_frameMicros = 10000;
+
+  struct Received {
+    int16_t sensors[2][3]{};
+    uint8_t sensorChanges{0};
+    int16_t roll{0};
+    int16_t pitch{0};
+    int16_t yaw{0};
+    uint8_t orientationChanges{0};
+  };
+
+  Received s_received;
+
+  void OnSensor(uint8_t, GSB::SensorID sensorID, int16_t valueX, int16_t valueY, int16_t valueZ) {
+    int16_t* values = s_received.sensors[static_cast<uint8_t>(sensorID)];
+    values[0] = valueX;
+    values[1] = valueY;
+    values[2] = valueZ;
+    ++s_received.sensorChanges;
+  }
+
+  void OnOrientation(uint8_t, int16_t roll, int16_t pitch, int16_t yaw) {
+    s_received.roll = roll;
+    s_received.pitch = pitch;
+    s_received.yaw = yaw;
+    ++s_received.orientationChanges;
+  }
+
+  void CheckReplay() {
+    printf("Replay\n");
+    host::HostSerial senderSerial;
+    host::HostSerial receiverSerial;
+    senderSerial.Connect(receiverSerial);
+    GSB::GamepadLink sender(GSB::LinkConfig{1, GSB::UartConfig{}, senderSerial});
+    GSB::ApplicationLink receiver(GSB::LinkConfig{1, GSB::UartConfig{}, receiverSerial});
+    receiver.SetSensorOnChange(OnSensor);
+    receiver.SetOrientationOnChange(OnOrientation);
+    GSB::ImuFusion fusion;
+    CHECK(receiver.SetImuFusion(0, &fusion));
+
+    GSB::ImuFusion reference;
+    // Orientation callbacks carry the angles as of the last reported change
+    Received reported;
+    host::SetMicros(1000);
+    for (uint8_t frame = 0; frame < s_frameCount; ++frame) {
+      const int16_t* sample = s_trace[frame];
+      sender.SetSensor(0, GSB::SensorID::SENSOR_1, sample[0], sample[1], sample[2]);
+      sender.SetSensor(0, GSB::SensorID::SENSOR_2, sample[3], sample[4], sample[5]);
+      CHECK(sender.SendStatus(0));
+      receiver.Loop();
+
+      // Every axis of both sensors arrives, not only the first that changed
+      for (uint8_t axis = 0; axis < 3; ++axis) {
+        CHECK_EQ(s_received.sensors[0][axis], sample[axis]);
+        CHECK_EQ(s_received.sensors[1][axis], sample[3 + axis]);
+      }
+
+      const int16_t gyro[3] = {sample[0], sample[1], sample[2]};
+      const int16_t accel[3] = {sample[3], sample[4], sample[5]};
+      if (reference.Update(gyro, accel, micros())) {
+        reported.roll = reference.GetRoll();
+        reported.pitch = reference.GetPitch();
+        reported.yaw = reference.GetYaw();
+        ++reported.orientationChanges;
+      }
+      CHECK_EQ(fusion.GetRoll(), reference.GetRoll());
+      CHECK_EQ(fusion.GetPitch(), reference.GetPitch());
+      CHECK_EQ(fusion.GetYaw(), reference.GetYaw());
+      host::AdvanceMicros(s_frameMicros);
+    }
+    printf("  roll %ld, pitch %ld, yaw %ld centidegrees after %u orientation changes\n",
+      static_cast<long>(GSB::ImuFusion::ToCentidegrees(fusion.GetRoll())),
+      static_cast<long>(GSB::ImuFusion::ToCentidegrees(fusion.GetPitch())),
+      static_cast<long>(GSB::ImuFusion::ToCentidegrees(fusion.GetYaw())),
+      s_received.orientationChanges);
+    CHECK_EQ(s_received.sensorChanges, 2 * s_frameCount);
+    CHECK(reported.orientationChanges > 0);
+    CHECK_EQ(s_received.orientationChanges, reported.orientationChanges);
+    CHECK_EQ(s_received.roll, reported.roll);
+    CHECK_EQ(s_received.pitch, reported.pitch);
+    CHECK_EQ(s_received.yaw, reported.yaw);
+    // The trace turns about every axis
+    CHECK(reference.GetRoll() != 0);
+    CHECK(reference.GetPitch() != 0);
+    CHECK(reference.GetYaw() != 0);
+  }
+  struct Batched {
+    GSB::SensorSample samples[s_frameCount];
+    unsigned long micros[s_frameCount];
+    uint8_t count{0};
+  };
+
+  Batched s_batched;
+
+  void OnBatch(uint8_t, const GSB::SensorSample& sample, unsigned long sampleMicros) {
+    if (s_batched.count < s_frameCount) {
+      s_batched.samples[s_batched.count] = sample;
+      s_batched.micros[s_batched.count] = sampleMicros;
+      ++s_batched.count;
+    }
+  }
+
+  void CheckBatches() {
+    printf("Batches\n");
+    host::HostSerial senderSerial;
+    host::HostSerial receiverSerial;
+    senderSerial.Connect(receiverSerial);
+    GSB::GamepadLink sender(GSB::LinkConfig{1, GSB::UartConfig{}, senderSerial});
+    GSB::ApplicationLink receiver(GSB::LinkConfig{1, GSB::UartConfig{}, receiverSerial});
+    receiver.SetSensorOnBatch(OnBatch);
+    receiver.SetEventQueueEnabled(true);
+    GSB::ImuFusion fusion;
+    CHECK(receiver.SetImuFusion(0, &fusion));
+    constexpr uint8_t samplesPerBatch = 4;
+    sender.SetSensorBatching(samplesPerBatch);
+    CHECK_EQ(sender.GetSensorBatchSize(), samplesPerBatch);
+
+    GSB::ImuFusion reference;
+    unsigned long sentMicros[s_frameCount];
+    host::SetMicros(5000);
+    for (uint8_t frame = 0; frame < s_frameCount; ++frame) {
+      const int16_t* values = s_trace[frame];
+      GSB::SensorSample sample;
+      for (uint8_t axis = 0; axis < 3; ++axis) {
+        sample.values[0][axis] = values[axis];
+        sample.values[1][axis] = values[3 + axis];
+      }
+      sentMicros[frame] = micros();
+      CHECK(sender.PushSensorSample(0, sample));
+      const int16_t gyro[3] = {values[0], values[1], values[2]};
+      const int16_t accel[3] = {values[3], values[4], values[5]};
+      reference.Update(gyro, accel, sentMicros[frame]);
+      // A batch goes out once full; Loop applies it but its callbacks wait for dispatch.
+      // Dispatching every pass keeps frames from being held back, which would shift the
+      // receiver's sample times by the hold.
+      const uint8_t delivered = s_batched.count;
+      receiver.Loop();
+      CHECK_EQ(s_batched.count, delivered);
+      receiver.DispatchEvents();
+      host::AdvanceMicros(s_frameMicros / samplesPerBatch);
+    }
+    CHECK_EQ(fusion.GetRoll(), reference.GetRoll());
+    CHECK_EQ(fusion.GetPitch(), reference.GetPitch());
+    CHECK_EQ(fusion.GetYaw(), reference.GetYaw());
+    CHECK_EQ(receiver.GetEventOverflowCount(), 0);
+    CHECK_EQ(s_batched.count, s_frameCount);
+    for (uint8_t frame = 0; frame < s_batched.count; ++frame) {
+      CHECK_EQ(s_batched.micros[frame], sentMicros[frame]);
+      for (uint8_t axis = 0; axis < 3; ++axis) {
+        CHECK_EQ(s_batched.samples[frame].values[0][axis], s_trace[frame][axis]);
+        CHECK_EQ(s_batched.samples[frame].values[1][axis], s_trace[frame][3 + axis]);
+      }
+    }
+  }
+} // namespace
+
+int main() {
+  CheckReplay();
+  CheckBatches();
+  return host::CheckResult("SensorReplay");
+}
@@ -0,0 +1,204 @@
+#include <Arduino.h>
+#include <stdio.h>
+
+namespace {
+  unsigned long s_micros = 0;
+  int s_pins[256];
+  bool s_pinsReady = false;
+
+  int* Pins() {
+    if (!s_pinsReady) {
+      for (int& pin : s_pins) {
+        pin = -1;
+      }
+      s_pinsReady = true;
+    }
+    return s_pins;
+  }
+
+  size_t PrintNumber(Print& out, unsigned long value, int base, bool negative) {
+    char digits[sizeof(unsigned long) * 8 + 2];
+    size_t length = 0;
+    do {
+      const unsigned long digit = value % static_cast<unsigned long>(base);
+      digits[length++] = static_cast<char>(digit < 10 ? '0' + digit : 'A' + digit - 10);
+      value /= static_cast<unsigned long>(base);
+    } while (value != 0);
+    size_t count = negative ? out.write(static_cast<uint8_t>('-')) : 0;
+    while (length > 0) {
+      count += out.write(static_cast<uint8_t>(digits[--length]));
+    }
+    return count;
+  }
+
+  size_t PrintSigned(Print& out, long value, int base) {
+    if (value < 0 && base == DEC) {
+      return PrintNumber(out, 0UL - static_cast<unsigned long>(value), base, true);
+    }
+    return PrintNumber(out, static_cast<unsigned long>(value), base, false);
+  }
+} // namespace
+
+unsigned long millis() {
+  return s_micros / 1000UL;
+}
+
+unsigned long micros() {
+  return s_micros;
+}
+
+void pinMode(uint8_t, uint8_t) {}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+  Pins()[pin] = value;
+}
+
+void analogWrite(uint8_t pin, int value) {
+  Pins()[pin] = value;
+}
+
+size_t Print::write(const uint8_t* bytes, size_t count) {
+  size_t written = 0;
+  for (size_t i = 0; i < count; ++i) {
+    written += write(bytes[i]);
+  }
+  return written;
+}
+
+size_t Print::write(const char* text) {
+  return write(reinterpret_cast<const uint8_t*>(text), strlen(text));
+}
+
+size_t Print::print(const __FlashStringHelper* text) {
+  return write(reinterpret_cast<const char*>(text));
+}
+
+size_t Print::print(const char* text) {
+  return write(text);
+}
+
+size_t Print::print(char value) {
+  return write(static_cast<uint8_t>(value));
+}
+
+size_t Print::print(unsigned char value, int base) {
+  return PrintNumber(*this, value, base, false);
+}
+
+size_t Print::print(int value, int base) {
+  return PrintSigned(*this, value, base);
+}
+
+size_t Print::print(unsigned int value, int base) {
+  return PrintNumber(*this, value, base, false);
+}
+
+size_t Print::print(long value, int base) {
+  return PrintSigned(*this, value, base);
+}
+
+size_t Print::print(unsigned long value, int base) {
+  return PrintNumber(*this, value, base, false);
+}
+
+size_t Print::print(double value, int digits) {
+  char text[64];
+  snprintf(text, sizeof(text), "%.*f", digits, value);
+  return write(text);
+}
+
+size_t Print::println() {
+  return write("\r\n");
+}
+
+namespace host {
+  void SetMicros(unsigned long now) {
+    s_micros = now;
+  }
+
+  void AdvanceMicros(unsigned long elapsed) {
+    s_micros += elapsed;
+  }
+
+  int GetPinValue(uint8_t pin) {
+    return Pins()[pin];
+  }
+
+  void HostSerial::Connect(HostSerial& peer) {
+    m_peer = &peer;
+    peer.m_peer = this;
+  }
+
+  void HostSerial::SetWriteRoom(int writeRoom) {
+    m_writeRoom = writeRoom;
+  }
+
+  void HostSerial::begin(unsigned long baud, uint8_t) {
+    m_baud = baud;
+  }
+
+  int HostSerial::available() {
+    return static_cast<int>(m_rxCount);
+  }
+
+  int HostSerial::read() {
+    if (m_rxCount == 0) {
+      return -1;
+    }
+    const uint8_t byte = m_rx[m_rxHead];
+    m_rxHead = (m_rxHead + 1) % s_capacity;
+    --m_rxCount;
+    return byte;
+  }
+
+  int HostSerial::peek() {
+    return m_rxCount == 0 ? -1 : m_rx[m_rxHead];
+  }
+
+  int HostSerial::availableForWrite() {
+    return m_writeRoom;
+  }
+
+  size_t HostSerial::write(uint8_t byte) {
+    ++m_bytesWritten;
+    if (m_peer) {
+      m_peer->Receive(byte);
+    }
+    return 1;
+  }
+
+  unsigned long HostSerial::GetBaud() const {
+    return m_baud;
+  }
+
+  size_t HostSerial::GetBytesWritten() const {
+    return m_bytesWritten;
+  }
+
+  void HostSerial::Receive(uint8_t byte) {
+    // A real UART would drop bytes here; the checks size their traffic to fit
+    if (m_rxCount == s_capacity) {
+      return;
+    }
+    m_rx[(m_rxHead + m_rxCount) % s_capacity] = byte;
+    ++m_rxCount;
+  }
+
+  size_t CapturePrint::write(uint8_t byte) {
+    if (m_length + 1 >= sizeof(m_text)) {
+      return 0;
+    }
+    m_text[m_length++] = static_cast<char>(byte);
+    m_text[m_length] = '\0';
+    return 1;
+  }
+
+  const char* CapturePrint::GetText() const {
+    return m_text;
+  }
+
+  void CapturePrint::Clear() {
+    m_length = 0;
+    m_text[0] = '\0';
+  }
+} // namespace host
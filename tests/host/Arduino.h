@@ -0,0 +1,148 @@
+#pragma once
+
+// Host stand-in for the parts of the Arduino core the library uses, so the library and
+// its checks build with a desktop compiler. Time only moves when a check moves it, pin
+// writes are recorded, and HostSerial ports can be wired to each other.
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+class __FlashStringHelper;
+#define F(text) (reinterpret_cast<const __FlashStringHelper*>(text))
+
+#define LOW 0
+#define HIGH 1
+#define INPUT 0
+#define OUTPUT 1
+#define DEC 10
+#define HEX 16
+
+#define SERIAL_5N1 0x00
+#define SERIAL_6N1 0x02
+#define SERIAL_7N1 0x04
+#define SERIAL_8N1 0x06
+#define SERIAL_5N2 0x08
+#define SERIAL_6N2 0x0A
+#define SERIAL_7N2 0x0C
+#define SERIAL_8N2 0x0E
+#define SERIAL_5E1 0x20
+#define SERIAL_6E1 0x22
+#define SERIAL_7E1 0x24
+#define SERIAL_8E1 0x26
+#define SERIAL_5E2 0x28
+#define SERIAL_6E2 0x2A
+#define SERIAL_7E2 0x2C
+#define SERIAL_8E2 0x2E
+#define SERIAL_5O1 0x30
+#define SERIAL_6O1 0x32
+#define SERIAL_7O1 0x34
+#define SERIAL_8O1 0x36
+#define SERIAL_5O2 0x38
+#define SERIAL_6O2 0x3A
+#define SERIAL_7O2 0x3C
+#define SERIAL_8O2 0x3E
+
+unsigned long millis();
+unsigned long micros();
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+void analogWrite(uint8_t pin, int value);
+
+class Print {
+  public:
+    virtual ~Print() = default;
+    virtual size_t write(uint8_t byte) = 0;
+    virtual size_t write(const uint8_t* bytes, size_t count);
+    size_t write(const char* text);
+
+    size_t print(const __FlashStringHelper* text);
+    size_t print(const char* text);
+    size_t print(char value);
+    size_t print(unsigned char value, int base = DEC);
+    size_t print(int value, int base = DEC);
+    size_t print(unsigned int value, int base = DEC);
+    size_t print(long value, int base = DEC);
+    size_t print(unsigned long value, int base = DEC);
+    size_t print(double value, int digits = 2);
+
+    size_t println();
+    template<typename T>
+    size_t println(const T& value) {
+      const size_t count = print(value);
+      return count + println();
+    }
+    template<typename T>
+    size_t println(const T& value, int format) {
+      const size_t count = print(value, format);
+      return count + println();
+    }
+};
+
+class Stream : public Print {
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+};
+
+class HardwareSerial : public Stream {
+  public:
+    virtual void begin(unsigned long baud, uint8_t config = SERIAL_8N1) = 0;
+    virtual int availableForWrite() = 0;
+    using Print::write;
+};
+
+namespace host {
+  // Sets or advances the value micros() (and millis()) return
+  void SetMicros(unsigned long now);
+  void AdvanceMicros(unsigned long elapsed);
+
+  // Last value written to a pin by digitalWrite/analogWrite, -1 before the first write
+  int GetPinValue(uint8_t pin);
+
+  // A UART whose writes arrive at the connected peer's receive side. writeRoom limits
+  // what availableForWrite reports, to exercise the links' TX pacing.
+  class HostSerial : public HardwareSerial {
+    public:
+      void Connect(HostSerial& peer);
+      void SetWriteRoom(int writeRoom);
+
+      void begin(unsigned long baud, uint8_t config = SERIAL_8N1) override;
+      int available() override;
+      int read() override;
+      int peek() override;
+      int availableForWrite() override;
+      size_t write(uint8_t byte) override;
+      using Print::write;
+
+      unsigned long GetBaud() const;
+      size_t GetBytesWritten() const;
+
+    private:
+      static constexpr size_t s_capacity = 4096;
+
+      void Receive(uint8_t byte);
+
+      HostSerial* m_peer{nullptr};
+      int m_writeRoom{64};
+      unsigned long m_baud{0};
+      size_t m_bytesWritten{0};
+      uint8_t m_rx[s_capacity]{};
+      size_t m_rxHead{0};
+      size_t m_rxCount{0};
+  };
+
+  // Print that keeps what was printed, for checks on log output
+  class CapturePrint : public Print {
+    public:
+      size_t write(uint8_t byte) override;
+      using Print::write;
+
+      const char* GetText() const;
+      void Clear();
+
+    private:
+      char m_text[4096]{};
+      size_t m_length{0};
+  };
+} // namespace host
@@ -0,0 +1,36 @@
+#pragma once
+
+// Minimal assertions for the host checks: a failed CHECK prints where and what, and
+// CheckResult turns the tally into the process exit code.
+#include <stdio.h>
+
+namespace host {
+  inline unsigned& FailureCount() {
+    static unsigned failures = 0;
+    return failures;
+  }
+
+  inline int CheckResult(const char* name) {
+    printf("%s: %s\n", name, FailureCount() == 0 ? "PASS" : "FAIL");
+    return FailureCount() == 0 ? 0 : 1;
+  }
+} // namespace host
+
+#define CHECK(condition)                                                       \
+  do {                                                                         \
+    if (!(condition)) {                                                        \
+      printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition);     \
+      ++host::FailureCount();                                                  \
+    }                                                                          \
+  } while (0)
+
+#define CHECK_EQ(actual, expected)                                             \
+  do {                                                                         \
+    const long long checkActual = static_cast<long long>(actual);              \
+    const long long checkExpected = static_cast<long long>(expected);          \
+    if (checkActual != checkExpected) {                                        \
+      printf("%s:%d: CHECK_EQ(%s, %s) failed: %lld != %lld\n", __FILE__,       \
+             __LINE__, #actual, #expected, checkActual, checkExpected);        \
+      ++host::FailureCount();                                                  \
+    }                                                                          \
+  } while (0)